@@ -9,16 +9,18 @@
 #include <sstream>
 
 // HistoryBuffer实现
-HistoryBuffer::HistoryBuffer() {
-    stateHistory.clear();
+HistoryBuffer::HistoryBuffer()
+    : states(static_cast<size_t>(HISTORY_SIZE) * FeatureSchema::FEATURE_COUNT, 0.0f),
+      stateSizes(HISTORY_SIZE, 0), stateHead(0), stateCount(0) {
     actionHistory.clear();
 }
 
-void HistoryBuffer::addState(const std::vector<float>& state) {
-    stateHistory.push_back(state);
-    if (stateHistory.size() > HISTORY_SIZE) {
-        stateHistory.pop_front();
-    }
+void HistoryBuffer::addState(const float* state, int count) {
+    count = std::min(count, FeatureSchema::FEATURE_COUNT);
+    std::copy(state, state + count, states.begin() + static_cast<size_t>(stateHead) * FeatureSchema::FEATURE_COUNT);
+    stateSizes[stateHead] = count;
+    stateHead = (stateHead + 1) % HISTORY_SIZE;
+    stateCount = std::min(stateCount + 1, HISTORY_SIZE);
 }
 
 void HistoryBuffer::addAction(const std::vector<float>& action) {
@@ -28,8 +30,25 @@ void HistoryBuffer::addAction(const std::vector<float>& action) {
     }
 }
 
+const float* HistoryBuffer::latestState() const {
+    const int row = (stateHead + HISTORY_SIZE - 1) % HISTORY_SIZE;
+    return states.data() + static_cast<size_t>(row) * FeatureSchema::FEATURE_COUNT;
+}
+
+int HistoryBuffer::latestStateSize() const {
+    return stateCount > 0 ? stateSizes[(stateHead + HISTORY_SIZE - 1) % HISTORY_SIZE] : 0;
+}
+
 std::vector<std::vector<float>> HistoryBuffer::getStateSequence() const {
-    return std::vector<std::vector<float>>(stateHistory.begin(), stateHistory.end());
+    // 从最旧的一帧开始按时间顺序展开
+    std::vector<std::vector<float>> sequence;
+    sequence.reserve(stateCount);
+    for (int i = 0; i < stateCount; ++i) {
+        const int row = (stateHead - stateCount + i + HISTORY_SIZE) % HISTORY_SIZE;
+        const float* begin = states.data() + static_cast<size_t>(row) * FeatureSchema::FEATURE_COUNT;
+        sequence.emplace_back(begin, begin + stateSizes[row]);
+    }
+    return sequence;
 }
 
 std::vector<std::vector<float>> HistoryBuffer::getActionSequence() const {
@@ -37,11 +56,12 @@ std::vector<std::vector<float>> HistoryBuffer::getActionSequence() const {
 }
 
 bool HistoryBuffer::isFull() const {
-    return stateHistory.size() >= HISTORY_SIZE;
+    return stateCount >= HISTORY_SIZE;
 }
 
 void HistoryBuffer::clear() {
-    stateHistory.clear();
+    stateHead = 0;
+    stateCount = 0;
     actionHistory.clear();
 }
 
@@ -52,19 +72,19 @@ AIController::AIController() : aiEnabled(false), modelLoaded(false),  rng(std::r
 AIController::~AIController() {
 }
 
-AIController::Action AIController::decideAction(Player& player, Map& map, RayCasting& rayCaster) {
+AIController::Action AIController::decideAction(const Player& player, const Map& map, const RayObservation& observation) {
     if (!aiEnabled) {
         // 如果AI未启用，返回默认动作
         return AIController::Action{0, 0};
     }
 
     try {
-        // 直接提取特征
-        std::vector<float> features = extractFeatures(player, map, rayCaster);
+        // 直接提取特征（写入复用的特征缓冲区）
+        int featureCount = FeatureExtractor::extract(player, map, observation, features);
         
         // 使用模型预测动作
         if (modelLoaded) {
-            return predictAction(features);
+            return predictAction(features, featureCount);
         } else {
             // 无模型时使用随机策略
             std::cerr << "AI decision error: Model not loaded" << std::endl;
@@ -77,29 +97,26 @@ AIController::Action AIController::decideAction(Player& player, Map& map, RayCas
 }
 
 // 包含原始数据返回的动作预测函数（用于调试）
-AIController::ActionResult AIController::decideActionWithDetails(Player& player, Map& map, RayCasting& rayCaster) {
+AIController::ActionResult AIController::decideActionWithDetails(const Player& player, const Map& map, const RayObservation& observation) {
     if (!aiEnabled) {
         // 如果AI未启用，返回默认动作
         return AIController::ActionResult{{0, 0}, {0.0f, 0.0f}};
     }
 
     try {
-        // 提取当前帧特征
-        std::vector<float> features = extractFeatures(player, map, rayCaster);
+        // 提取当前帧特征（写入复用的特征缓冲区）
+        int featureCount = FeatureExtractor::extract(player, map, observation, features);
         
         // 更新历史缓冲区
-        historyBuffer->addState(features);
-        
-        // 获取状态序列
-        auto stateSequence = historyBuffer->getStateSequence();
+        historyBuffer->addState(features, featureCount);
         
         // 根据配置选择预测方式
         if (historyBuffer->isFull() && modelLoaded) {
             // 使用序列学习模式
-            return predictSequenceAction(stateSequence);
+            return predictSequenceAction();
         } else {
             // 使用传统单帧预测
-            return predictActionWithDetails(features);
+            return predictActionWithDetails(features, featureCount);
         }
     } catch (const std::exception& e) {
         std::cerr << "AI decision error: " << e.what() << std::endl;
@@ -108,96 +125,12 @@ AIController::ActionResult AIController::decideActionWithDetails(Player& player,
     }
 }
 
-std::vector<float> AIController::extractFeatures(const Player& player, Map& map, RayCasting& rayCaster) {
-    std::vector<float> features;
-    
-    // 获取玩家位置
-    sf::Vector2f position = player.getPosition();
-    sf::Vector2f velocity = player.getVelocity();
-    float energy = player.getCurrentEnergy();
-    bool isGrounded = player.isOnGround();
-    
-    // 获取目标位置
-    sf::Vector2f target = map.getTargetPosition();
-    
-    // 计算到目标的距离和角度
-    sf::Vector2f diff = target - position;
-    float distanceToTarget = std::sqrt(diff.x * diff.x + diff.y * diff.y);
-    float angleToTarget = std::atan2(diff.y, diff.x);
-    
-    // 获取射线检测结果
-    sf::Vector2f playerCenter = position + sf::Vector2f(7.5f, 7.5f); // 玩家中心点
-    auto rayResults = rayCaster.castRays(playerCenter, map.getLevelData());
-    
-    // 位置特征 (2维)
-    features.push_back(position.x);
-    features.push_back(position.y);
-    
-    // 速度特征 (2维)
-    features.push_back(velocity.x);
-    features.push_back(velocity.y);
-    
-    // 能量特征 (1维)
-    features.push_back(energy);
-
-    // 地面接触状态 (1维)
-    features.push_back(isGrounded ? 1.0f : 0.0f);
-    
-    // 目标相关特征 (4维)
-    features.push_back(distanceToTarget);
-    features.push_back(angleToTarget);
-    features.push_back(target.x);
-    features.push_back(target.y);
-    
-    // 射线检测结果特征 (120维 = 60距离 + 60命中状态)
-    for (const auto& ray : rayResults) {
-        features.push_back(ray.distance);
-    }
-    
-    for (const auto& ray : rayResults) {
-        features.push_back(ray.hit ? 1.0f : 0.0f);
-    }
-
-    // 共130维的数据
-    
-    // 特征标准化
-    const float maxRayDistance = 150.0f;
-    const float maxDistance = 1350.0f;
-    const float maxVelocity = 240.832f;
-    const float maxEnergy = 150.0f;
-    const float maxAngle = 3.142f;
-    
-    for (size_t i = 0; i < features.size(); ++i) {
-        if (i < 2) { // 位置 (0-1)
-            features[i] = features[i] / maxDistance;
-        } else if (i >= 2 && i < 4) { // 速度 (2-3)
-            features[i] = features[i] / maxVelocity;
-        } else if (i == 4) { // 能量 (4)
-            features[i] = features[i] / maxEnergy;
-        } else if (i == 5) { // 地面状态 (5) - 已经是0/1，无需标准化
-            // 保持不变
-        } else if (i == 6) { // 目标距离 (6)
-            features[i] = std::min(features[i] / maxDistance * 1.4143f, 1.0f);
-        } else if (i == 7) { // 目标角度 (7)
-            features[i] = features[i] / maxAngle; // 归一化到[-1, 1]
-        } else if (i >= 8 && i < 10) { // 目标坐标 (8-9)
-            features[i] = features[i] / maxDistance;
-        } else if (i >= 10 && i < 70) { // 射线距离 (10-69)
-            features[i] = std::min(features[i] / maxRayDistance, 1.0f);
-        } else if (i >= 70) { // 射线命中 (70-129)
-            // 已经是0/1，无需标准化
-        }
-    }
-    
-    return features;
-}
-
 // 序列特征提取 - 扩展特征维度以包含时序信息
 std::vector<float> AIController::extractSequenceFeatures(const std::vector<std::vector<float>>& stateSequence) {
     std::vector<float> sequenceFeatures;
     
     if (stateSequence.empty()) {
-        return std::vector<float>(132 * HISTORY_SIZE, 0.0f);
+        return std::vector<float>(FeatureSchema::SEQUENCE_FRAME_FEATURES * HISTORY_SIZE, 0.0f);
     }
     
     // 为每帧添加扩展特征
@@ -211,29 +144,29 @@ std::vector<float> AIController::extractSequenceFeatures(const std::vector<std::
             extendedFrame.push_back(0.0f);  // dy/dt placeholder
         }
         
-        // 确保每帧有132个特征
-        while (extendedFrame.size() < 132) {
+        // 确保每帧有SEQUENCE_FRAME_FEATURES（132）个特征
+        while (extendedFrame.size() < FeatureSchema::SEQUENCE_FRAME_FEATURES) {
             extendedFrame.push_back(0.0f);
         }
         
-        sequenceFeatures.insert(sequenceFeatures.end(), extendedFrame.begin(), extendedFrame.begin() + 132);
+        sequenceFeatures.insert(sequenceFeatures.end(), extendedFrame.begin(), extendedFrame.begin() + FeatureSchema::SEQUENCE_FRAME_FEATURES);
     }
     
     // 填充到150帧
-    while (sequenceFeatures.size() < 132 * HISTORY_SIZE) {
+    while (sequenceFeatures.size() < FeatureSchema::SEQUENCE_FRAME_FEATURES * HISTORY_SIZE) {
         sequenceFeatures.push_back(0.0f);
     }
     
     return sequenceFeatures;
 }
 
-AIController::Action AIController::predictAction(const std::vector<float>& features) {
-    if (modelWeights.empty() || modelBias.empty()) {
+AIController::Action AIController::predictAction(const float* features, int count) {
+    if (!modelLoaded || !network.isLoaded()) {
         return getRandomAction();
     }
     
     try {
-        ActionResult result = predictActionWithDetails(features);
+        ActionResult result = predictActionWithDetails(features, count);
         return result.action;
     } catch (const std::exception& e) {
         std::cerr << "Model prediction error: " << e.what() << std::endl;
@@ -241,8 +174,8 @@ AIController::Action AIController::predictAction(const std::vector<float>& featu
     }
 }
 
-AIController::ActionResult AIController::predictActionWithDetails(const std::vector<float>& features) {
-    if (modelWeights.empty() || modelBias.empty()) {
+AIController::ActionResult AIController::predictActionWithDetails(const float* features, int count) {
+    if (!modelLoaded || !network.isLoaded()) {
         Action randomAction = getRandomAction();
         return ActionResult{randomAction, {0.0f, 0.0f}};
     }
@@ -250,107 +183,27 @@ AIController::ActionResult AIController::predictActionWithDetails(const std::vec
     try {
         // 深度神经网络前向传播 - 与SLTrainer一致的网络结构
         // 网络结构: 130输入 -> 256 -> 128 -> 64 -> 32 -> 16 -> 2输出
-        
-        const int inputDim = 130;
-        const int hiddenDim1 = 256;
-        const int hiddenDim2 = 128;
-        const int hiddenDim3 = 64;
-        const int hiddenDim4 = 32;
-        const int hiddenDim5 = 16;
-        const int outputDim = 2;
+        const int inputDim = PolicyNetwork::INPUT_DIM;
         
         // 验证输入维度
-        if (features.size() != inputDim) {
-            std::cerr << "Input feature dimension mismatch: " << features.size() << " vs " << inputDim << std::endl;
+        if (count != inputDim) {
+            std::cerr << "Input feature dimension mismatch: " << count << " vs " << inputDim << std::endl;
             Action randomAction = getRandomAction();
             return ActionResult{randomAction, {0.0f, 0.0f}};
         }
         
         // 验证模型参数完整性（6层网络）
-        if (modelWeights.size() < 6 || modelBias.size() < 6) {
+        if (!network.isLoaded()) {
             std::cerr << "Model parameters incomplete" << std::endl;
             Action randomAction = getRandomAction();
             return ActionResult{randomAction, {0.0f, 0.0f}};
         }
         
-        // 第一层：130 -> 256 (ReLU)
-        std::vector<float> hidden1(hiddenDim1);
-        for (int i = 0; i < hiddenDim1; ++i) {
-            hidden1[i] = modelBias[0][i];
-            for (int j = 0; j < inputDim; ++j) {
-                hidden1[i] += features[j] * modelWeights[0][j * hiddenDim1 + i];
-            }
-            hidden1[i] = std::max(0.0f, hidden1[i]); // ReLU激活
-        }
-        
-        // 第二层：256 -> 128 (ReLU)
-        std::vector<float> hidden2(hiddenDim2);
-        for (int i = 0; i < hiddenDim2; ++i) {
-            hidden2[i] = modelBias[1][i];
-            for (int j = 0; j < hiddenDim1; ++j) {
-                hidden2[i] += hidden1[j] * modelWeights[1][j * hiddenDim2 + i];
-            }
-            hidden2[i] = std::max(0.0f, hidden2[i]); // ReLU激活
-        }
+        // 面板格式的权重 + SIMD GEMV（或量化模型），激活缓冲区复用，不分配内存
+        float output[PolicyNetwork::OUTPUT_DIM];
+        runNetwork(features, output);
         
-        // 第三层：128 -> 64 (ReLU)
-        std::vector<float> hidden3(hiddenDim3);
-        for (int i = 0; i < hiddenDim3; ++i) {
-            hidden3[i] = modelBias[2][i];
-            for (int j = 0; j < hiddenDim2; ++j) {
-                hidden3[i] += hidden2[j] * modelWeights[2][j * hiddenDim3 + i];
-            }
-            hidden3[i] = std::max(0.0f, hidden3[i]); // ReLU激活
-        }
-        
-        // 第四层：64 -> 32 (ReLU)
-        std::vector<float> hidden4(hiddenDim4);
-        for (int i = 0; i < hiddenDim4; ++i) {
-            hidden4[i] = modelBias[3][i];
-            for (int j = 0; j < hiddenDim3; ++j) {
-                hidden4[i] += hidden3[j] * modelWeights[3][j * hiddenDim4 + i];
-            }
-            hidden4[i] = std::max(0.0f, hidden4[i]); // ReLU激活
-        }
-        
-        // 第五层：32 -> 16 (ReLU)
-        std::vector<float> hidden5(hiddenDim5);
-        for (int i = 0; i < hiddenDim5; ++i) {
-            hidden5[i] = modelBias[4][i];
-            for (int j = 0; j < hiddenDim4; ++j) {
-                hidden5[i] += hidden4[j] * modelWeights[4][j * hiddenDim5 + i];
-            }
-            hidden5[i] = std::max(0.0f, hidden5[i]); // ReLU激活
-        }
-        
-        // 第六层：16 -> 2 (线性输出)
-        std::vector<float> output(outputDim);
-        for (int i = 0; i < outputDim; ++i) {
-            output[i] = modelBias[5][i];
-            for (int j = 0; j < hiddenDim5; ++j) {
-                output[i] += hidden5[j] * modelWeights[5][j * outputDim + i];
-            }
-        }
-        
-        // 创建包含原始数据和离散化动作的结果
-        AIController::Action action;
-        AIController::OriginalActionData originalData;
-        originalData.moveX = output[0];
-        originalData.useEnergy = output[1];
-        
-        // 离散化 moveX 值，根据符号转换为 -1, 0 或 1
-        if (output[0] > 0.33f) {
-            action.moveX = 1;
-        } else if (output[0] < -0.33f) {
-            action.moveX = -1;
-        } else {
-            action.moveX = 0;
-        }
-        
-        // 离散化 useEnergy 值，大于 0 则使用能量，否则不使用
-        action.useEnergy = (output[1] > 0.5f) ? 1 : 0;
-        
-        return ActionResult{action, originalData};
+        return toActionResult(output);
         
     } catch (const std::exception& e) {
         std::cerr << "Model prediction error: " << e.what() << std::endl;
@@ -359,6 +212,87 @@ AIController::ActionResult AIController::predictActionWithDetails(const std::vec
     }
 }
 
+void AIController::runNetwork(const float* features, float* output) {
+    if (!quantizedActive) {
+        network.forward(features, output);
+        return;
+    }
+    if (quantizedPrecision == QuantizedModel::Precision::Int8) {
+        int8Network.forward(features, output);
+    } else {
+        halfNetwork.forward(features, output);
+    }
+    if (++framesSinceCheck < AGREEMENT_CHECK_INTERVAL) {
+        return;
+    }
+
+    // 抽查：同一帧再跑一次fp32，比较离散化后的动作
+    framesSinceCheck = 0;
+    float reference[PolicyNetwork::OUTPUT_DIM];
+    network.forward(features, reference);
+    const bool same = PolicyNetwork::discreteMoveX(output[0]) == PolicyNetwork::discreteMoveX(reference[0]) &&
+                      PolicyNetwork::discreteUseEnergy(output[1]) == PolicyNetwork::discreteUseEnergy(reference[1]);
+    agreementChecks++;
+    windowChecks++;
+    agreementMatches += same ? 1 : 0;
+    windowMatches += same ? 1 : 0;
+    if (windowChecks < AGREEMENT_WINDOW) {
+        return;
+    }
+    const float windowRate = static_cast<float>(windowMatches) / windowChecks;
+    windowChecks = 0;
+    windowMatches = 0;
+    if (windowRate < minAgreement) {
+        quantizedActive = false;
+        std::cout << "[QUANT] Decision agreement " << windowRate * 100.0f << "% over the last " << AGREEMENT_WINDOW
+                  << " checks is below " << minAgreement * 100.0f << "%, falling back to fp32" << std::endl;
+        std::copy(reference, reference + PolicyNetwork::OUTPUT_DIM, output);
+    }
+}
+
+AIController::ActionResult AIController::toActionResult(const float* output) {
+    // 创建包含原始数据和离散化动作的结果
+    AIController::Action action;
+    AIController::OriginalActionData originalData;
+    originalData.moveX = output[0];
+    originalData.useEnergy = output[1];
+
+    // 离散化 moveX 值，根据符号转换为 -1, 0 或 1；useEnergy 大于阈值时使用能量
+    action.moveX = PolicyNetwork::discreteMoveX(output[0]);
+    action.useEnergy = PolicyNetwork::discreteUseEnergy(output[1]);
+
+    return ActionResult{action, originalData};
+}
+
+bool AIController::decideActions(const float* observations, int count, size_t stride, ActionResult* out, int threads) {
+    if (stride < static_cast<size_t>(FeatureSchema::FEATURE_COUNT)) {
+        std::cerr << "Batch observation stride " << stride << " is smaller than "
+                  << FeatureSchema::FEATURE_COUNT << " features" << std::endl;
+        return false;
+    }
+    if (!aiEnabled) {
+        std::fill(out, out + std::max(count, 0), ActionResult{{0, 0}, {0.0f, 0.0f}});
+        return true;
+    }
+    if (!modelLoaded || !network.isLoaded()) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = ActionResult{getRandomAction(), {0.0f, 0.0f}};
+        }
+        return true;
+    }
+
+    // 与predictActionWithDetails相同的网络和离散化，N行一起前向
+    const size_t outputSize = static_cast<size_t>(std::max(count, 0)) * PolicyNetwork::OUTPUT_DIM;
+    if (batchOutputs.size() < outputSize) {
+        batchOutputs.resize(outputSize);
+    }
+    network.forwardBatch(observations, count, stride, batchOutputs.data(), threads);
+    for (int i = 0; i < count; ++i) {
+        out[i] = toActionResult(batchOutputs.data() + static_cast<size_t>(i) * PolicyNetwork::OUTPUT_DIM);
+    }
+    return true;
+}
+
 AIController::Action AIController::getRandomAction() {
     std::uniform_int_distribution<int> moveDist(-1, 1);
     std::uniform_int_distribution<int> energyDist(0, 1);
@@ -367,27 +301,34 @@ AIController::Action AIController::getRandomAction() {
 }
 
 // 基于序列预测动作
-AIController::ActionResult AIController::predictSequenceAction(const std::vector<std::vector<float>>& stateSequence) {
-    if (modelWeights.empty() || modelBias.empty()) {
+AIController::ActionResult AIController::predictSequenceAction() {
+    if (!modelLoaded || !network.isLoaded()) {
         Action randomAction = getRandomAction();
         return ActionResult{randomAction, {0.0f, 0.0f}};
     }
     
     try {
+        const float* currentFeatures = historyBuffer->latestState();
+        const int currentCount = historyBuffer->latestStateSize();
+        
         // 检查历史缓冲区是否已满
         if (!historyBuffer->isFull()) {
             // 使用传统方法作为后备
-            auto currentFeatures = stateSequence.empty() ? 
-                std::vector<float>(130, 0.0f) : stateSequence.back();
-            return predictActionWithDetails(currentFeatures);
+            return predictActionWithDetails(currentFeatures, currentCount);
+        }
+        
+        // 验证序列模型参数：推理引擎只加载PolicyNetwork::LAYERS层前馈网络，没有序列网络权重时不展开历史序列
+        constexpr int SEQUENCE_MODEL_LAYERS = 12;  // 序列网络需要更多参数
+        if (!network.isLoaded() || PolicyNetwork::LAYERS < SEQUENCE_MODEL_LAYERS) {
+            return predictActionWithDetails(currentFeatures, currentCount);
         }
         
         // 提取序列特征
-        std::vector<float> sequenceFeatures = extractSequenceFeatures(stateSequence);
+        std::vector<float> sequenceFeatures = extractSequenceFeatures(historyBuffer->getStateSequence());
         
         // 序列网络前向传播
         // 网络结构: [150×132, LSTM256, LSTM128, 64, 32, 16, 2]
-        const int inputDim = 132 * 150;
+        const int inputDim = FeatureSchema::SEQUENCE_FRAME_FEATURES * HISTORY_SIZE;
         const int lstm1Dim = 256;
         const int lstm2Dim = 128;
         const int hiddenDim3 = 64;
@@ -395,14 +336,9 @@ AIController::ActionResult AIController::predictSequenceAction(const std::vector
         const int hiddenDim5 = 16;
         const int outputDim = 2;
         
-        // 验证序列模型参数
-        if (modelWeights.size() < 12) {  // 序列网络需要更多参数
-            return predictActionWithDetails(stateSequence.back());
-        }
-        
         // 简化的序列处理 - 使用现有权重结构
         // 在实际应用中需要专门的LSTM权重加载
-        return predictActionWithDetails(stateSequence.back());
+        return predictActionWithDetails(currentFeatures, currentCount);
         
     } catch (const std::exception& e) {
         std::cerr << "Sequence prediction error: " << e.what() << std::endl;
@@ -416,59 +352,86 @@ bool AIController::isAIEnabled() const {
 }
 
 
+bool AIController::loadQuantizedModel(const std::string& filename, float minimumAgreement) {
+    quantizedActive = false;
+    if (!modelLoaded) {
+        std::cerr << "[QUANT] Load the fp32 model before the quantized model: " << filename << std::endl;
+        return false;
+    }
+    QuantizedModel model;
+    if (!model.load(filename)) {
+        return false;
+    }
+    const char* precisionName = QuantizedModel::precisionName(model.getPrecision());
+    if (model.getAgreement() < minimumAgreement) {
+        std::cout << "[QUANT] " << precisionName << " model agrees with fp32 on " << model.getAgreement() * 100.0f
+                  << "% of calibration decisions, below " << minimumAgreement * 100.0f << "%, staying on fp32" << std::endl;
+        return false;
+    }
+
+    if (model.getPrecision() == QuantizedModel::Precision::Int8) {
+        if (!Int8PolicyNetwork::isAccelerated()) {
+            std::cout << "[QUANT] int8 inference needs an AVX2 build, staying on fp32" << std::endl;
+            return false;
+        }
+        if (!int8Network.load(model)) {
+            return false;
+        }
+    } else {
+        std::vector<std::vector<float>> weights, biases;
+        if (!model.toFloat(weights, biases) || !halfNetwork.load(weights, biases)) {
+            return false;
+        }
+    }
+
+    quantizedPrecision = model.getPrecision();
+    minAgreement = minimumAgreement;
+    framesSinceCheck = 0;
+    agreementChecks = 0;
+    agreementMatches = 0;
+    windowChecks = 0;
+    windowMatches = 0;
+    quantizedActive = true;
+    std::cout << "[QUANT] Using " << precisionName << " model " << filename << " ("
+              << (quantizedPrecision == QuantizedModel::Precision::Int8 ? Int8PolicyNetwork::instructionSet()
+                                                                         : PolicyNetwork::instructionSet())
+              << ", calibration agreement " << model.getAgreement() * 100.0f << "%, fallback below "
+              << minimumAgreement * 100.0f << "%)" << std::endl;
+    return true;
+}
+
+const char* AIController::getInferencePrecision() const {
+    return quantizedActive ? QuantizedModel::precisionName(quantizedPrecision) : "fp32";
+}
+
+float AIController::getAgreementRate() const {
+    return agreementChecks > 0 ? static_cast<float>(agreementMatches) / agreementChecks : 1.0f;
+}
+
 void AIController::loadModel(const std::string& filename) {
+    // 量化模型属于之前的fp32模型，重新加载后需要重新调用loadQuantizedModel
+    quantizedActive = false;
     try {
-        std::ifstream file(filename, std::ios::binary);
-        if (!file.is_open()) {
-            std::cerr << "Cannot open model file: " << filename << std::endl;
-            modelLoaded = false;
-            return;
-        }
-        
-        modelWeights.clear();
-        modelBias.clear();
-        
         // 加载二进制格式的模型权重和偏置
         // 网络结构: 130输入 -> 256 -> 128 -> 64 -> 32 -> 16 -> 2输出
-        const int layerSizes[6] = {130*256, 256*128, 128*64, 64*32, 32*16, 16*2};
-        const int biasSizes[6] = {256, 128, 64, 32, 16, 2};
-        
-        modelWeights.resize(6);
-        modelBias.resize(6);
-        
-        // 加载权重
-        for (int layer = 0; layer < 6; ++layer) {
-            size_t size;
-            file.read(reinterpret_cast<char*>(&size), sizeof(size));
-            
-            if (size != layerSizes[layer]) {
-                std::cerr << "Model weight dimension mismatch: " << size << " vs " << layerSizes[layer] << std::endl;
-                modelLoaded = false;
-                return;
-            }
-            
-            modelWeights[layer].resize(size);
-            file.read(reinterpret_cast<char*>(modelWeights[layer].data()), size * sizeof(float));
+        // 文件中的fp32权重只是临时数据，重排为推理引擎的面板格式后随局部变量释放
+        std::vector<std::vector<float>> weights;
+        std::vector<std::vector<float>> biases;
+        if (!PolicyNetwork::readModel(filename, weights, biases)) {
+            modelLoaded = false;
+            return;
         }
         
-        // 加载偏置
-        for (int layer = 0; layer < 6; ++layer) {
-            size_t size;
-            file.read(reinterpret_cast<char*>(&size), sizeof(size));
-            
-            if (size != biasSizes[layer]) {
-                std::cerr << "Model bias dimension mismatch: " << size << " vs " << biasSizes[layer] << std::endl;
-                modelLoaded = false;
-                return;
-            }
-            
-            modelBias[layer].resize(size);
-            file.read(reinterpret_cast<char*>(modelBias[layer].data()), size * sizeof(float));
+        if (!network.load(weights, biases)) {
+            std::cerr << "Failed to prepare model for inference: " << filename << std::endl;
+            modelLoaded = false;
+            return;
         }
         
         modelLoaded = true;
         std::cout << "Successfully loaded model: " << filename << std::endl;
-        std::cout << "Network structure: 130 -> 256 -> 128 -> 64 -> 32 -> 16 -> 2" << std::endl;
+        std::cout << "Network structure: 130 -> 256 -> 128 -> 64 -> 32 -> 16 -> 2 ("
+                  << PolicyNetwork::instructionSet() << ")" << std::endl;
         
     } catch (const std::exception& e) {
         std::cerr << "Error loading model: " << e.what() << std::endl;
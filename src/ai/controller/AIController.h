@@ -3,6 +3,10 @@
 #include "../../entity/Player.h"
 #include "../../core/Map.h"
 #include "../pathfinding/RayCasting.h"
+#include "FeatureExtractor.h"
+#include "PolicyNetwork.h"
+#include "QuantizedModel.h"
+#include "Int8PolicyNetwork.h"
 #include <vector>
 #include <memory>
 #include <random> 
@@ -20,22 +24,27 @@ struct SequenceTrainingData {
     int sequenceLength = 150;                       // 序列长度
 };
 
-// 历史状态缓冲区
+// 历史状态缓冲区（环形缓冲区，容量在构造时一次分配，addState不分配内存）
 class HistoryBuffer {
 public:
     static constexpr int HISTORY_SIZE = 150;
     
     HistoryBuffer();
     
-    void addState(const std::vector<float>& state);
+    void addState(const float* state, int count);
     void addAction(const std::vector<float>& action);
+    const float* latestState() const;
+    int latestStateSize() const;
     std::vector<std::vector<float>> getStateSequence() const;
     std::vector<std::vector<float>> getActionSequence() const;
     bool isFull() const;
     void clear();
     
 private:
-    std::deque<std::vector<float>> stateHistory;
+    std::vector<float> states;      // HISTORY_SIZE行，每行FeatureSchema::FEATURE_COUNT个float
+    std::vector<int> stateSizes;    // 每行的有效特征数
+    int stateHead;                  // 下一帧写入的行
+    int stateCount;
     std::deque<std::vector<float>> actionHistory;
 };
 
@@ -61,15 +70,33 @@ public:
         OriginalActionData originalData;
     };
     
-    // 根据当前游戏状态决定AI动作
-    Action decideAction(Player& player, Map& map, RayCasting& rayCaster);
+    // 根据当前游戏状态和本帧射线观测决定AI动作
+    Action decideAction(const Player& player, const Map& map, const RayObservation& observation);
     
-    // 根据当前游戏状态决定AI动作（包含原始数据）
-    ActionResult decideActionWithDetails(Player& player, Map& map, RayCasting& rayCaster);
+    // 根据当前游戏状态和本帧射线观测决定AI动作（包含原始数据）
+    ActionResult decideActionWithDetails(const Player& player, const Map& map, const RayObservation& observation);
+    
+    // 批量决策：observations第i行（FeatureExtractor::extract写出的标准化特征）位于observations + i*stride，
+    // 结果写入out[i]；每层一次GEMM，大批量按threads分线程。只做单帧fp32预测，不读写历史缓冲区。
+    // 步长小于FeatureSchema::FEATURE_COUNT时返回false；AI未启用时输出不动作，未加载模型时输出随机动作
+    bool decideActions(const float* observations, int count, size_t stride, ActionResult* out, int threads = 1);
     
     // 加载训练好的模型
     void loadModel(const std::string& filename);
     
+    // 量化模型的默认最低决策一致率
+    static constexpr float DEFAULT_MIN_AGREEMENT = 0.97f;
+    
+    // 加载quantize_model生成的量化模型（须先用loadModel加载对应的fp32模型，作为回退路径和抽查基准）
+    // 文件记录的一致率低于minimumAgreement、或INT8没有SIMD实现时不启用，继续使用fp32
+    bool loadQuantizedModel(const std::string& filename, float minimumAgreement = DEFAULT_MIN_AGREEMENT);
+    
+    // 当前单帧推理使用的精度（"fp32"、"int8"或"fp16"）
+    const char* getInferencePrecision() const;
+    
+    // 运行时抽查得到的量化与fp32决策一致率（尚未抽查时为1）
+    float getAgreementRate() const;
+    
     // 设置是否使用AI控制（true=AI控制，false=人工控制）
     void setAIEnabled(bool enabled);
     
@@ -77,17 +104,21 @@ public:
     bool isAIEnabled() const;
 
 private:
-    // 将游戏状态转换为模型输入特征
-    std::vector<float> extractFeatures(const Player& player, Map& map, RayCasting& rayCaster);
-    
     // 模型单帧预测
-    Action predictAction(const std::vector<float>& features);
+    Action predictAction(const float* features, int count);
     
     // 模型单帧预测（包含原始数据）
-    ActionResult predictActionWithDetails(const std::vector<float>& features);
+    ActionResult predictActionWithDetails(const float* features, int count);
 
-    // 模型序列信息预测
-    ActionResult predictSequenceAction(const std::vector<std::vector<float>>& stateSequence);
+    // 模型序列信息预测（读取历史缓冲区）
+    ActionResult predictSequenceAction();
+    
+    // 单帧前向：启用量化模型时走低精度路径，每隔AGREEMENT_CHECK_INTERVAL帧用fp32抽查一次，
+    // 一个窗口内的一致率低于阈值时退回fp32
+    void runNetwork(const float* features, float* output);
+    
+    // 把网络输出离散化为动作
+    static ActionResult toActionResult(const float* output);
     
     // 简单的随机策略（无模型时备用）
     Action getRandomAction();
@@ -96,9 +127,22 @@ private:
     std::vector<float> extractSequenceFeatures(const std::vector<std::vector<float>>& stateSequence);
 
     private:
-    // 模型权重和偏置（4层网络）
-    std::vector<std::vector<float>> modelWeights;
-    std::vector<std::vector<float>> modelBias;
+    // 推理引擎（加载时把模型文件的权重重排为面板格式，唯一保存的一份权重）
+    PolicyNetwork network;
+    
+    // 量化推理（fp32的network保留，作为回退路径和抽查基准）
+    QuantizedModel::Precision quantizedPrecision = QuantizedModel::Precision::Int8;
+    bool quantizedActive = false;
+    Int8PolicyNetwork int8Network;
+    PolicyNetwork halfNetwork;
+    float minAgreement = DEFAULT_MIN_AGREEMENT;
+    int framesSinceCheck = 0;
+    int agreementChecks = 0;    // 累计抽查次数
+    int agreementMatches = 0;   // 累计决策一致次数
+    int windowChecks = 0;       // 当前窗口的抽查次数
+    int windowMatches = 0;
+    static constexpr int AGREEMENT_CHECK_INTERVAL = 16;   // 每16帧抽查一次
+    static constexpr int AGREEMENT_WINDOW = 64;           // 每64次抽查判断一次是否回退
     
     // 控制状态
     bool aiEnabled;
@@ -107,6 +151,12 @@ private:
     // 历史状态缓冲区
     std::unique_ptr<HistoryBuffer> historyBuffer;
 
+    // 本帧标准化特征（由FeatureExtractor写入，每帧复用）
+    float features[FeatureSchema::FEATURE_COUNT];
+
+    // 批量决策的网络输出（每行OUTPUT_DIM个，只在批量变大时增长）
+    std::vector<float> batchOutputs;
+
     static constexpr int HISTORY_SIZE = 150;
     
     // 随机数生成器
@@ -1,4 +1,5 @@
 #include "DataCollector.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
@@ -38,7 +39,10 @@ void DataCollector::startEpisode() {
     }
     
     currentEpisode = new EpisodeData();
-    currentEpisode->episodeId = nextEpisodeId++;
+    {
+        std::lock_guard<std::mutex> lock(episodesMutex);
+        currentEpisode->episodeId = nextEpisodeId++;
+    }
     currentEpisode->startTime = std::chrono::steady_clock::now();
     currentEpisode->success = false;
     currentEpisode->steps = 0;
@@ -50,34 +54,13 @@ void DataCollector::startEpisode() {
 
 
 // 获取当前帧数据
-DataCollector::TrainingData DataCollector::getCurrentFrameData(Player& player, 
-                                                           Map& map, 
-                                                           RayCasting& rayCaster) {
+DataCollector::TrainingData DataCollector::getCurrentFrameData(const Player& player, 
+                                                           const Map& map, 
+                                                           const RayObservation& observation) {
     DataCollector::TrainingData frame;
     
     // 收集玩家和环境的当前状态
-    DataCollector::AIState state;
-
-    state.position = player.getPosition();
-    state.velocity = player.getVelocity();
-    state.energy = player.getCurrentEnergy() / player.getMaxEnergy();
-    state.target = map.getTargetPosition();
-    
-    // 获取射线检测结果 - 检测周围障碍物 - 共60条射线的信息
-    sf::Vector2f playerCenter = player.getPosition() + sf::Vector2f(player.getWidth() / 2, player.getHeight() / 2);
-    auto rayHits = rayCaster.castRays(playerCenter, map.getLevelData());
-    state.rayDistances.clear();
-    state.rayHits.clear();
-    for (const auto& hit : rayHits) {
-        state.rayDistances.push_back(hit.distance);
-        state.rayHits.push_back(hit.hit ? 1.0f : 0.0f);
-    }
-    
-    // 计算到目标的距离和角度 - 用于导航
-    sf::Vector2f diff = state.target - state.position;
-    state.distanceToTarget = std::sqrt(diff.x * diff.x + diff.y * diff.y);
-    state.angleToTarget = std::atan2(diff.y, diff.x);
-    state.isGrounded = player.isOnGround();
+    DataCollector::AIState state = captureState(player, map, observation);
     
     // 获取玩家真实的键盘输入作为训练标签 - 监督学习
     DataCollector::Action action;
@@ -105,6 +88,17 @@ DataCollector::TrainingData DataCollector::getCurrentFrameData(Player& player,
     return frame;
 }
 
+// 采集玩家和环境的当前状态
+DataCollector::AIState DataCollector::captureState(const Player& player, const Map& map, const RayObservation& observation) {
+    DataCollector::AIState state;
+
+    // 与AI决策使用同一个特征提取器，射线数量由射线布局决定，默认60条（本帧观测，与AI决策共用）
+    const int featureCount = FeatureExtractor::extractRaw(player, map, observation, state.features.data());
+    state.rayCount = (featureCount - FeatureSchema::BASE_FEATURES) / 2;
+    
+    return state;
+}
+
 // 记录当前帧数据
 void DataCollector::recordCurrentFrame(const DataCollector::TrainingData& frame) {
     if (!recordingEnabled || !currentEpisode) {
@@ -142,23 +136,49 @@ void DataCollector::endEpisode(bool success, float gameDuration, float averageFP
         currentEpisode->frames.back().terminal = true;
     }
     
-    episodes.push_back(*currentEpisode);
-    
     std::cout << "[DEBUG] Episode " << currentEpisode->episodeId << " ended" << std::endl;
     std::cout << "[DEBUG] Success: " << (success ? "true" : "false") 
             << ", Steps: " << currentEpisode->steps; 
     
-    // 限制存储的episode数量 - 防止内存溢出
-    if (episodes.size() > static_cast<size_t>(episodeLimit)) {
-        std::cout << "[DEBUG] Episode limit reached, removing oldest episode" << std::endl;
-        episodes.erase(episodes.begin());
+    size_t storedEpisodes;
+    {
+        std::lock_guard<std::mutex> lock(episodesMutex);
+        storeEpisode(std::move(*currentEpisode));
+        storedEpisodes = episodes.size();
     }
     
     // 清理当前episode - 准备下一局游戏
     delete currentEpisode;
     currentEpisode = nullptr;
     
-    std::cout << "[DEBUG] Total episodes stored: " << episodes.size() << std::endl;
+    std::cout << "[DEBUG] Total episodes stored: " << storedEpisodes << std::endl;
+}
+
+// 提交一局完整的游戏数据（线程安全）
+void DataCollector::submitEpisode(EpisodeData episode) {
+    if (!recordingEnabled) {
+        return;
+    }
+    
+    // 标记最后一帧为终止状态
+    if (!episode.frames.empty()) {
+        episode.frames.back().terminal = true;
+    }
+    
+    std::lock_guard<std::mutex> lock(episodesMutex);
+    episode.episodeId = nextEpisodeId++;
+    storeEpisode(std::move(episode));
+}
+
+// 追加一局数据并执行数量限制（调用方须持有episodesMutex）
+void DataCollector::storeEpisode(EpisodeData&& episode) {
+    episodes.push_back(std::move(episode));
+    
+    // 限制存储的episode数量 - 防止内存溢出
+    if (episodeLimit > 0 && episodes.size() > static_cast<size_t>(episodeLimit)) {
+        std::cout << "[DEBUG] Episode limit reached, removing oldest episode" << std::endl;
+        episodes.erase(episodes.begin());
+    }
 }
 
 // 保存所有局数据到文件
@@ -198,6 +218,7 @@ void DataCollector::saveEpisodeData(const std::string& filename) {
     std::cout << "[DEBUG] Starting from episode ID: " << startEpisodeId << std::endl;
     
     // 只保存新增的游戏局 - 提高保存效率
+    std::lock_guard<std::mutex> lock(episodesMutex);
     int newEpisodes = 0;
     for (const auto& episode : episodes) {
         if (episode.episodeId >= startEpisodeId) {
@@ -219,15 +240,15 @@ void DataCollector::saveEpisodeData(const std::string& filename) {
                 file << "F:";
                 
                 // 状态特征
-                const auto& s = frame.state;
-                file << s.position.x << "," << s.position.y << ","
-                    << s.velocity.x << "," << s.velocity.y << ","
-                    << s.energy << "," << s.distanceToTarget << ","
-                    << s.angleToTarget << ",";
+                const float* s = frame.state.features.data();
+                file << s[FeatureSchema::POS_X] << "," << s[FeatureSchema::POS_Y] << ","
+                    << s[FeatureSchema::VEL_X] << "," << s[FeatureSchema::VEL_Y] << ","
+                    << s[FeatureSchema::ENERGY] << "," << s[FeatureSchema::DIST_TARGET] << ","
+                    << s[FeatureSchema::ANGLE_TARGET] << ",";
                 
                 // 射线距离（取前8个）
-                for (size_t i = 0; i < 8 && i < s.rayDistances.size(); ++i) {
-                    file << s.rayDistances[i] << (i < 7 ? "," : "");
+                for (int i = 0; i < 8 && i < frame.state.rayCount; ++i) {
+                    file << s[FeatureSchema::RAY_BEGIN + i] << (i < 7 ? "," : "");
                 }
                 
                 file << ";";
@@ -299,6 +320,7 @@ void DataCollector::loadEpisodeData(const std::string& filename) {
     int loadedEpisodes = 0;
     int skippedEpisodes = 0;
     
+    std::lock_guard<std::mutex> lock(episodesMutex);
     int maxExistingId = 0;
     if (!episodes.empty()) {
         maxExistingId = episodes.back().episodeId;
@@ -379,6 +401,25 @@ void DataCollector::exportTrainingDataset(const std::string& filename) {
     std::filesystem::path filePath(newFilename);
     bool fileExists = std::filesystem::exists(filePath);
     
+    // 表头由特征布局生成：列顺序即模型输入顺序，射线列名由射线布局决定
+    const int rayCount = std::min(rayLayout.rayCount(), FeatureSchema::MAX_RAYS);
+    const std::string header = FeatureSchema::datasetHeader(rayCount, [this](int i) { return rayLayout.rayLabel(i); });
+    
+    // 追加到已有文件时布局必须一致，否则同一文件中的列含义不同
+    if (fileExists) {
+        std::ifstream existing(filePath);
+        std::string existingHeader;
+        std::getline(existing, existingHeader);
+        if (!existingHeader.empty() && existingHeader.back() == '\r') {
+            existingHeader.pop_back();
+        }
+        if (!existingHeader.empty() && existingHeader != header) {
+            std::cerr << "[ERROR] Dataset " << newFilename << " was recorded with a different feature or ray layout, "
+                      << "current ray layout: " << rayLayout.describe() << std::endl;
+            return;
+        }
+    }
+    
     // 打开文件，存在则追加，不存在则创建
     std::ofstream file(filePath, fileExists ? std::ios::app : std::ios::out);
     if (!file.is_open()) {
@@ -390,40 +431,31 @@ void DataCollector::exportTrainingDataset(const std::string& filename) {
     
     // 只有创建新文件时才写入表头
     if (!fileExists) {
-        file << "pos_x,pos_y,vel_x,vel_y,energy,target_x,target_y,dist_target,angle_target,is_grounded";
-        
-        for (int i = 0; i < 60; ++i) {
-            file << ",ray_dist_" << i;
-        }
-        
-        for (int i = 0; i < 60; ++i) {
-            file << ",ray_hit_" << i;
-        }
-        file << ",action_x,use_energy" << std::endl;
+        file << header << std::endl;
     }
     
+    std::lock_guard<std::mutex> lock(episodesMutex);
     for (const auto& episode : episodes) {
         for (const auto& frame : episode.frames) {
-            const auto& s = frame.state;
+            const float* s = frame.state.features.data();
+            const int frameRays = frame.state.rayCount;
+            const int hitBegin = FeatureSchema::rayHitBegin(frameRays);
             
-            file << s.position.x << "," << s.position.y << ","
-                << s.velocity.x << "," << s.velocity.y << ","
-                << s.energy << ","
-                << s.target.x << "," << s.target.y << ","
-                << s.distanceToTarget << "," << s.angleToTarget << ","
-                << (s.isGrounded ? 1 : 0);
+            for (int i = 0; i < FeatureSchema::BASE_FEATURES; ++i) {
+                file << (i > 0 ? "," : "") << s[i];
+            }
             
-            for (int i = 0; i < 60; ++i) {
-                if (i < s.rayDistances.size()) {
-                    file << "," << s.rayDistances[i];
+            for (int i = 0; i < rayCount; ++i) {
+                if (i < frameRays) {
+                    file << "," << s[FeatureSchema::RAY_BEGIN + i];
                 } else {
                     file << ",0.0";
                 }
             }
             
-            for (int i = 0; i < 60; ++i) {
-                if (i < s.rayHits.size()) {
-                    file << "," << s.rayHits[i];
+            for (int i = 0; i < rayCount; ++i) {
+                if (i < frameRays) {
+                    file << "," << s[hitBegin + i];
                 } else {
                     file << ",0.0";
                 }
@@ -439,11 +471,13 @@ void DataCollector::exportTrainingDataset(const std::string& filename) {
 
 // 获取总局数
 int DataCollector::getTotalEpisodes() const {
+    std::lock_guard<std::mutex> lock(episodesMutex);
     return episodes.size();
 }
 
 // 获取成功局数
 int DataCollector::getSuccessfulEpisodes() const {
+    std::lock_guard<std::mutex> lock(episodesMutex);
     int count = 0;
     for (const auto& episode : episodes) {
         if (episode.success) count++;
@@ -453,6 +487,7 @@ int DataCollector::getSuccessfulEpisodes() const {
 
 // 获取平均步数
 float DataCollector::getAverageSteps() const {
+    std::lock_guard<std::mutex> lock(episodesMutex);
     if (episodes.empty()) return 0.0f;
     
     int totalSteps = 0;
@@ -465,8 +500,13 @@ float DataCollector::getAverageSteps() const {
 
 // 获取成功率
 float DataCollector::getSuccessRate() const {
+    std::lock_guard<std::mutex> lock(episodesMutex);
     if (episodes.empty()) return 0.0f;
-    return static_cast<float>(getSuccessfulEpisodes()) / episodes.size();
+    int count = 0;
+    for (const auto& episode : episodes) {
+        if (episode.success) count++;
+    }
+    return static_cast<float>(count) / episodes.size();
 }
 
 
@@ -479,6 +519,7 @@ void DataCollector::clearAllData() {
     }
     
 
+    std::lock_guard<std::mutex> lock(episodesMutex);
     episodes.clear();
     
 
@@ -498,6 +539,11 @@ bool DataCollector::isRecordingEnabled() const {
     return recordingEnabled;
 }
 
+// 设置采集时使用的射线布局
+void DataCollector::setRayLayout(const RayLayout& layout) {
+    rayLayout = layout;
+}
+
 // 设置最大存储局数限制
 void DataCollector::setEpisodeLimit(int limit) {
     episodeLimit = limit;
@@ -508,6 +554,7 @@ void DataCollector::setEpisodeLimit(int limit) {
 std::vector<DataCollector::TrainingData> DataCollector::getTrainingData() const {
     std::vector<DataCollector::TrainingData> trainingData;
     
+    std::lock_guard<std::mutex> lock(episodesMutex);
     for (const auto& episode : episodes) {
         for (const auto& frame : episode.frames) {
             trainingData.push_back(frame);
@@ -1,27 +1,25 @@
 #pragma once
 
 #include "AIController.h"
+#include "FeatureExtractor.h"
 #include "../pathfinding/RayCasting.h"
+#include "../pathfinding/RayObserver.h"
+#include <array>
 #include <vector>
 #include <string>
 #include <chrono>
 #include <fstream>
+#include <mutex>
 
 
 // 数据收集器类 - 用于收集和管理AI训练数据
 class DataCollector {
 public:
 
+    // 一帧的原始特征（未标准化，布局见FeatureSchema），定长存储，采集时不分配内存
     struct AIState {
-        sf::Vector2f position;
-        sf::Vector2f velocity;
-        sf::Vector2f target;
-        std::vector<float> rayDistances;
-        std::vector<int> rayHits;
-        float energy;
-        float distanceToTarget;
-        float angleToTarget;
-        bool isGrounded;
+        std::array<float, FeatureSchema::FEATURE_COUNT> features{};
+        int rayCount = 0;
     };
 
     struct Action {
@@ -66,10 +64,13 @@ public:
     // 开始新的一局游戏记录
     void startEpisode();
     
-    // 获取当前帧数据
-    DataCollector::TrainingData getCurrentFrameData(Player& player, 
-                                                   Map& map, 
-                                                   RayCasting& rayCaster);
+    // 获取当前帧数据（射线数据取自本帧的射线观测）
+    DataCollector::TrainingData getCurrentFrameData(const Player& player, 
+                                                   const Map& map, 
+                                                   const RayObservation& observation);
+    
+    // 采集玩家和环境的当前状态（不读取键盘，可在工作线程中调用）
+    static AIState captureState(const Player& player, const Map& map, const RayObservation& observation);
     
     // 记录当前帧数据
     void recordCurrentFrame(const DataCollector::TrainingData& frame);
@@ -77,6 +78,9 @@ public:
     // 结束当前局游戏记录
     void endEpisode(bool success, float gameDuration = 0.0f, float averageFPS = 0.0f);
     
+    // 提交一局完整的游戏数据（线程安全，供并行回合运行器使用）
+    void submitEpisode(EpisodeData episode);
+    
     // 保存所有局数据到文件
     void saveEpisodeData(const std::string& filename);
     
@@ -107,6 +111,9 @@ public:
     // 检查是否启用记录
     bool isRecordingEnabled() const;
     
+    // 设置采集时使用的射线布局（决定导出表头中的射线列）
+    void setRayLayout(const RayLayout& layout);
+    
     // 设置最大存储局数限制
     void setEpisodeLimit(int limit);
     
@@ -122,7 +129,13 @@ private:
     bool recordingEnabled;
     int episodeLimit;
     int nextEpisodeId;
+    RayLayout rayLayout;
+    
+    // 保护episodes和nextEpisodeId，多个工作线程可同时提交
+    mutable std::mutex episodesMutex;
     
+    // 追加一局数据并执行数量限制（调用方须持有episodesMutex）
+    void storeEpisode(EpisodeData&& episode);
 
     void saveEpisodeToFile(const EpisodeData& episode, const std::string& filename);
     
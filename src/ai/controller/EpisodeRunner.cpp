@@ -0,0 +1,157 @@
+#include "EpisodeRunner.h"
+#include "../../world/LevelBank.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void RandomPolicy::beginEpisode(int episode) {
+    rng.seed(baseSeed + static_cast<uint32_t>(episode));
+    moveDist.reset();
+    energyDist.reset();
+}
+
+HeadlessSim::Action RandomPolicy::act(const HeadlessSim&, const RayObservation&) {
+    return HeadlessSim::Action{static_cast<float>(moveDist(rng)), energyDist(rng) == 1};
+}
+
+HeadlessSim::Action ScriptedPolicy::act(const HeadlessSim& sim, const RayObservation&) {
+    const Player& player = sim.getPlayer();
+    sf::Vector2f center = player.getPosition() + sf::Vector2f(player.getWidth() / 2, player.getHeight() / 2);
+    sf::Vector2f diff = sim.getMap().getTargetPosition() + sf::Vector2f(TILE / 2.0f, TILE / 2.0f) - center;
+
+    HeadlessSim::Action action;
+    if (std::abs(diff.x) > TILE / 2.0f) {
+        action.moveX = diff.x > 0.0f ? 1.0f : -1.0f;
+    }
+
+    // 终点在上方，或想水平移动却几乎没有水平速度（被墙挡住）时飞行
+    bool targetAbove = diff.y < -TILE / 2.0f;
+    bool blocked = action.moveX != 0.0f && std::abs(player.getVelocity().x) < 1.0f;
+    action.useEnergy = (targetAbove || blocked) && player.getCurrentEnergy() > 0;
+    return action;
+}
+
+ModelPolicy::ModelPolicy(const std::string& modelPath) {
+    controller.loadModel(modelPath);
+    controller.setAIEnabled(true);
+}
+
+HeadlessSim::Action ModelPolicy::act(const HeadlessSim& sim, const RayObservation& observation) {
+    AIController::Action decision = controller.decideAction(sim.getPlayer(), sim.getMap(), observation);
+    return HeadlessSim::Action{static_cast<float>(decision.moveX), decision.useEnergy != 0};
+}
+
+EpisodeRunner::EpisodeRunner(PolicyFactory factory, const Config& config)
+    : policyFactory(std::move(factory)), config(config) {
+}
+
+int EpisodeRunner::getThreadCount() const {
+    int threads = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, threads);
+}
+
+EpisodeRunner::Summary EpisodeRunner::run(int episodes, DataCollector* sink) {
+    const int threadCount = std::max(1, std::min(getThreadCount(), episodes));
+    const bool record = config.recordFrames && sink != nullptr;
+
+    // 重排缓冲：提前完成的回合按下标暂存，从nextToSubmit开始连续完成的一段立即按回合顺序汇总和提交，
+    // 提交顺序与调度顺序无关，缓冲中只保留尚未轮到的回合
+    Summary summary;
+    std::map<int, DataCollector::EpisodeData> pending;
+    int nextToSubmit = 0;
+    std::mutex submitMutex;
+    auto complete = [&](int episode, DataCollector::EpisodeData&& data) {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        pending.emplace(episode, std::move(data));
+        for (auto it = pending.begin(); it != pending.end() && it->first == nextToSubmit;
+             it = pending.erase(it), ++nextToSubmit) {
+            DataCollector::EpisodeData& ready = it->second;
+            summary.episodes++;
+            summary.successes += ready.success ? 1 : 0;
+            summary.steps += ready.steps;
+            summary.simSeconds += ready.gameDuration;
+            if (record) {
+                sink->submitEpisode(std::move(ready));
+            }
+        }
+    };
+    std::atomic<int> next{0};
+
+    // 每个工作线程独立持有模拟器、射线检测器和策略，从共享计数器领取回合下标
+    auto worker = [&](int workerIndex) {
+        HeadlessSim sim(config.fixedDt);
+        RayCasting rayCaster;
+        RayObserver observer(config.rayLayout);
+        RayObservation observation;
+        std::unique_ptr<EpisodePolicy> policy = policyFactory(workerIndex);
+        const bool observe = record || policy->needsObservation();
+
+        for (int episode = next++; episode < episodes; episode = next++) {
+            if (config.levelBank) {
+                sim.setLevelBank(config.levelBank, static_cast<size_t>(episode));
+            }
+            sim.reset();
+            observer.reset();
+            policy->beginEpisode(episode);
+
+            DataCollector::EpisodeData data;
+            data.startTime = std::chrono::steady_clock::now();
+            if (record) {
+                data.frames.reserve(static_cast<size_t>(config.maxSteps));
+            }
+
+            HeadlessSim::StepResult result;
+            while (sim.getEpisodeSteps() < config.maxSteps) {
+                // 每步只投射一次，策略和数据采集读取同一份观测
+                if (observe) {
+                    observer.observe(rayCaster, sim.getPlayer(), sim.getMap(), observation);
+                }
+                HeadlessSim::Action action = policy->act(sim, observation);
+                if (record) {
+                    // 先记录动作执行前的状态，与交互模式的采集顺序一致
+                    DataCollector::TrainingData frame;
+                    frame.state = DataCollector::captureState(sim.getPlayer(), sim.getMap(), observation);
+                    frame.action.moveX = static_cast<int>(action.moveX);
+                    frame.action.useEnergy = action.useEnergy ? 1 : 0;
+                    frame.terminal = false;
+                    data.frames.push_back(std::move(frame));
+                }
+                result = sim.step(action);
+                if (result.done()) {
+                    break;
+                }
+            }
+
+            data.endTime = std::chrono::steady_clock::now();
+            data.success = result.reachedTarget;
+            data.steps = sim.getEpisodeSteps();
+            data.gameDuration = data.steps * sim.getFixedDt();
+            data.averageFPS = 1.0f / sim.getFixedDt();
+            complete(episode, std::move(data));
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    summary.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[RUNNER] " << summary.episodes << " episodes on " << threadCount << " threads, "
+              << summary.successes << " successes, " << summary.steps << " steps in "
+              << summary.wallSeconds << "s (" << (summary.wallSeconds > 0.0 ? summary.steps / summary.wallSeconds : 0.0)
+              << " steps/s)" << std::endl;
+    return summary;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "AIController.h"
+#include "DataCollector.h"
+#include "../../core/HeadlessSim.h"
+#include "../pathfinding/RayCasting.h"
+#include "../pathfinding/RayObserver.h"
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+
+class LevelBank;
+
+/**
+ * @brief 回合策略接口
+ * @details 每个工作线程持有自己的策略实例，act()只会在该线程中调用，实现无需加锁
+ */
+class EpisodePolicy {
+public:
+    virtual ~EpisodePolicy() = default;
+
+    /**
+     * @brief 新回合开始前调用，可在此清空历史状态
+     * @param episode 回合下标；带随机性的策略按下标重新设置种子，使回合结果与由哪个线程运行无关
+     */
+    virtual void beginEpisode(int episode) { (void)episode; }
+
+    /**
+     * @brief 策略是否读取射线观测
+     * @details 返回false且不记录数据时，运行器跳过每步的射线投射，传入的观测为空
+     */
+    virtual bool needsObservation() const { return false; }
+
+    /**
+     * @brief 根据当前模拟状态给出本步动作
+     * @param sim 当前工作线程的模拟器
+     * @param observation 本步从玩家中心投射的射线观测（与数据采集共用）
+     * @return 本步动作
+     */
+    virtual HeadlessSim::Action act(const HeadlessSim& sim, const RayObservation& observation) = 0;
+};
+
+/** @brief 随机策略：每步独立随机选择水平方向和是否飞行，第i个回合使用种子 seed + i */
+class RandomPolicy : public EpisodePolicy {
+public:
+    explicit RandomPolicy(uint32_t seed) : baseSeed(seed), rng(seed) {}
+    void beginEpisode(int episode) override;
+    HeadlessSim::Action act(const HeadlessSim& sim, const RayObservation& observation) override;
+
+private:
+    uint32_t baseSeed;
+    std::mt19937 rng;
+    std::uniform_int_distribution<int> moveDist{-1, 1};
+    std::uniform_int_distribution<int> energyDist{0, 1};
+};
+
+/**
+ * @brief 脚本策略：朝终点水平移动，终点在上方或水平方向被挡住时飞行
+ * @details 不需要模型即可产生大量有方向性的示范数据
+ */
+class ScriptedPolicy : public EpisodePolicy {
+public:
+    HeadlessSim::Action act(const HeadlessSim& sim, const RayObservation& observation) override;
+};
+
+/** @brief 模型策略：使用AIController加载的模型决策 */
+class ModelPolicy : public EpisodePolicy {
+public:
+    /**
+     * @brief 构造函数
+     * @param modelPath 模型文件路径，每个工作线程各自加载一份
+     */
+    explicit ModelPolicy(const std::string& modelPath);
+    bool needsObservation() const override { return true; }
+    HeadlessSim::Action act(const HeadlessSim& sim, const RayObservation& observation) override;
+
+private:
+    AIController controller;
+};
+
+/**
+ * @brief 多线程回合运行器
+ * @details 把互不相关的无窗口回合分配到多个工作线程，用于并行采集训练数据和评估模型
+ * 每个工作线程独立持有HeadlessSim（地图、玩家、安全检查）、RayCasting和策略实例，
+ * 线程之间共享一个原子回合计数器和一个重排缓冲：回合完成后按下标放入缓冲，
+ * 从下一个待提交回合开始连续完成的一段在互斥锁下立即按回合顺序提交到DataCollector，
+ * 数据边运行边写入接收器，缓冲只暂存提前完成的回合
+ * 第i个回合的策略在beginEpisode(i)中按下标设置种子；使用关卡库时第i个回合固定使用第i个关卡，
+ * 此时每个回合的动作和结果、导出数据的回合顺序和编号都与线程数和调度顺序无关
+ * （不使用关卡库时关卡随机生成，不可复现）
+ */
+class EpisodeRunner {
+public:
+    /** @brief 为指定工作线程创建策略实例 */
+    using PolicyFactory = std::function<std::unique_ptr<EpisodePolicy>(int worker)>;
+
+    struct Config {
+        int threads = 0;                        ///< 工作线程数，0表示使用硬件线程数
+        int maxSteps = 60 * 60;                 ///< 单回合步数上限（默认1分钟模拟时间）
+        float fixedDt = 1.0f / 60.0f;           ///< 模拟步长（秒），连续碰撞检测下可用1/15秒等粗步长
+        bool recordFrames = true;               ///< 是否记录每步的状态和动作
+        const LevelBank* levelBank = nullptr;   ///< 关卡库，nullptr表示随机生成关卡
+        RayLayout rayLayout;                    ///< 射线布局（默认每帧60条均匀射线）
+    };
+
+    /** @brief 运行统计 */
+    struct Summary {
+        int episodes = 0;          ///< 完成的回合数
+        int successes = 0;         ///< 到达终点的回合数
+        long long steps = 0;       ///< 总模拟步数
+        double wallSeconds = 0.0;  ///< 实际耗时（秒）
+        double simSeconds = 0.0;   ///< 模拟时间（秒）
+    };
+
+    EpisodeRunner(PolicyFactory factory, const Config& config);
+
+    /**
+     * @brief 并行运行指定数量的回合
+     * @param episodes 回合数
+     * @param sink 数据接收器，为nullptr时只统计结果（用于评估）
+     * @return 运行统计
+     */
+    Summary run(int episodes, DataCollector* sink);
+
+    /** @brief 实际使用的工作线程数 */
+    int getThreadCount() const;
+
+private:
+    PolicyFactory policyFactory;
+    Config config;
+};
@@ -0,0 +1,55 @@
+#include "FeatureExtractor.h"
+#include "../../core/Map.h"
+#include "../../entity/Player.h"
+#include <algorithm>
+#include <cmath>
+
+int FeatureExtractor::extractRaw(const Player& player, const Map& map, const RayObservation& observation, float* out) {
+    const sf::Vector2f position = player.getPosition();
+    const sf::Vector2f velocity = player.getVelocity();
+    const sf::Vector2f target = map.getTargetPosition();
+    const sf::Vector2f diff = target - position;
+
+    out[FeatureSchema::POS_X] = position.x;
+    out[FeatureSchema::POS_Y] = position.y;
+    out[FeatureSchema::VEL_X] = velocity.x;
+    out[FeatureSchema::VEL_Y] = velocity.y;
+    out[FeatureSchema::ENERGY] = player.getCurrentEnergy() / player.getMaxEnergy();
+    out[FeatureSchema::GROUNDED] = player.isOnGround() ? 1.0f : 0.0f;
+    out[FeatureSchema::DIST_TARGET] = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+    out[FeatureSchema::ANGLE_TARGET] = std::atan2(diff.y, diff.x);
+    out[FeatureSchema::TARGET_X] = target.x;
+    out[FeatureSchema::TARGET_Y] = target.y;
+
+    // 射线距离和命中标志分两段写出，超过MAX_RAYS的射线被截掉
+    const int rayCount = std::min(static_cast<int>(observation.rays.size()), FeatureSchema::MAX_RAYS);
+    const RayHitInfo* rays = observation.rays.data();
+    float* distances = out + FeatureSchema::RAY_BEGIN;
+    float* hits = distances + rayCount;
+    for (int i = 0; i < rayCount; ++i) {
+        distances[i] = rays[i].distance;
+        hits[i] = rays[i].hit ? 1.0f : 0.0f;
+    }
+    return FeatureSchema::featureCount(rayCount);
+}
+
+int FeatureExtractor::extract(const Player& player, const Map& map, const RayObservation& observation, float* out) {
+    // 与训练程序加载数据集时的标准化完全相同
+    const int count = extractRaw(player, map, observation, out);
+    FeatureSchema::normalize(out, (count - FeatureSchema::BASE_FEATURES) / 2);
+    return count;
+}
+
+bool FeatureExtractor::extractBatch(const Source* sources, int count, float* out, size_t stride, int* counts) {
+    if (stride < static_cast<size_t>(FeatureSchema::FEATURE_COUNT)) {
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        const Source& source = sources[i];
+        const int written = extract(*source.player, *source.map, *source.observation, out + i * stride);
+        if (counts) {
+            counts[i] = written;
+        }
+    }
+    return true;
+}
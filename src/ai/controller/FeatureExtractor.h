@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../pathfinding/RayCasting.h"
+#include "../pathfinding/RayObserver.h"
+#include "FeatureSchema.h"
+#include <cstddef>
+
+class Player;
+class Map;
+
+static_assert(RayLayout::MAX_RAYS == FeatureSchema::MAX_RAYS, "ray layout limit must match the feature schema");
+
+/**
+ * @brief 每帧观测特征提取（AI决策与数据采集共用）
+ * @details 特征直接写进调用方提供的float缓冲区（至少FeatureSchema::FEATURE_COUNT个），不分配内存；
+ * 布局和标准化常数见FeatureSchema
+ */
+class FeatureExtractor {
+public:
+    /** @brief 批量提取时一个智能体的输入 */
+    struct Source {
+        const Player* player;
+        const Map* map;
+        const RayObservation* observation;
+    };
+
+    /**
+     * @brief 提取标准化特征（模型输入）
+     * @param player 玩家
+     * @param map 地图（终点位置）
+     * @param observation 本帧射线观测
+     * @param out 输出缓冲区，至少FeatureSchema::FEATURE_COUNT个float
+     * @return 写入的特征数，即FeatureSchema::featureCount(射线数)
+     */
+    static int extract(const Player& player, const Map& map, const RayObservation& observation, float* out);
+
+    /**
+     * @brief 提取原始特征（未标准化，数据集按原始值导出）
+     * @details 布局与extract()相同，能量同样是当前能量与最大能量之比
+     */
+    static int extractRaw(const Player& player, const Map& map, const RayObservation& observation, float* out);
+
+    /**
+     * @brief 批量提取标准化特征
+     * @param sources 每个智能体的输入，长度count
+     * @param count 智能体数量
+     * @param out 输出矩阵，第i行写在out + i*stride处
+     * @param stride 相邻行的间隔（以float计），不小于FeatureSchema::FEATURE_COUNT
+     * @param counts 可选输出：每行写入的特征数，长度count
+     * @return 步长不足时返回false，不写输出
+     */
+    static bool extractBatch(const Source* sources, int count, float* out, size_t stride, int* counts = nullptr);
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string>
+
+/**
+ * @file FeatureSchema.h
+ * @brief 特征布局的唯一定义（编译期常量，不依赖SFML）
+ * @details 特征提取、数据集导出、训练程序和推理都从这里取下标、列名和标准化常数：
+ * - 数据集按模型输入顺序导出原始特征，表头由列名生成，训练程序加载时逐字比对表头
+ * - 标准化为逐元素乘以SCALE再以LIMIT为上限，默认布局下是整行130个float的一次乘法和取小
+ * 调整字段顺序而不同步下标、或特征总数与模型输入不符时在编译期报错
+ */
+namespace FeatureSchema {
+
+/** @brief 一个特征字段 */
+struct Field {
+    const char* name;   ///< 数据集列名（射线字段为列名前缀）
+    float scale;        ///< 标准化乘数
+    float limit;        ///< 标准化后的上限（不截断时为无穷大）
+};
+
+constexpr float NO_LIMIT = std::numeric_limits<float>::infinity();
+
+// 标准化常数（与训练时一致）
+constexpr float MAX_DISTANCE = 1350.0f;     ///< 关卡边长（像素）
+constexpr float MAX_VELOCITY = 240.832f;
+constexpr float MAX_ANGLE = 3.142f;
+constexpr float MAX_RAY_DISTANCE = 150.0f;
+constexpr float DIAGONAL = 1.4143f;         ///< 到终点的距离按对角线长度归一化
+
+/** @brief 基础特征，按模型输入顺序 */
+constexpr Field BASE_FIELDS[] = {
+    {"pos_x", 1.0f / MAX_DISTANCE, NO_LIMIT},
+    {"pos_y", 1.0f / MAX_DISTANCE, NO_LIMIT},
+    {"vel_x", 1.0f / MAX_VELOCITY, NO_LIMIT},
+    {"vel_y", 1.0f / MAX_VELOCITY, NO_LIMIT},
+    {"energy", 1.0f, NO_LIMIT},                          // 已是当前能量与最大能量之比
+    {"is_grounded", 1.0f, NO_LIMIT},
+    {"dist_target", DIAGONAL / MAX_DISTANCE, 1.0f},
+    {"angle_target", 1.0f / MAX_ANGLE, NO_LIMIT},        // 归一化到[-1, 1]
+    {"target_x", 1.0f / MAX_DISTANCE, NO_LIMIT},
+    {"target_y", 1.0f / MAX_DISTANCE, NO_LIMIT},
+};
+
+// 基础特征下标
+constexpr int POS_X = 0;
+constexpr int POS_Y = 1;
+constexpr int VEL_X = 2;
+constexpr int VEL_Y = 3;
+constexpr int ENERGY = 4;
+constexpr int GROUNDED = 5;
+constexpr int DIST_TARGET = 6;
+constexpr int ANGLE_TARGET = 7;
+constexpr int TARGET_X = 8;
+constexpr int TARGET_Y = 9;
+
+constexpr int BASE_FEATURES = static_cast<int>(sizeof(BASE_FIELDS) / sizeof(BASE_FIELDS[0]));
+
+/** @brief 射线字段：先rayCount个距离，后rayCount个命中标志（0/1） */
+constexpr Field RAY_DISTANCE = {"ray_dist_", 1.0f / MAX_RAY_DISTANCE, 1.0f};
+constexpr Field RAY_HIT = {"ray_hit_", 1.0f, NO_LIMIT};
+
+/** @brief 最多射线数（默认布局每象限15条） */
+constexpr int MAX_RAYS = 60;
+constexpr int RAY_BEGIN = BASE_FEATURES;
+
+/** @brief 一行特征的容量，也是模型输入维度 */
+constexpr int FEATURE_COUNT = BASE_FEATURES + 2 * MAX_RAYS;
+
+/** @brief 数据集中特征之后的动作列 */
+constexpr const char* ACTION_NAMES[] = {"action_x", "use_energy"};
+constexpr int ACTION_X = FEATURE_COUNT;
+constexpr int USE_ENERGY = FEATURE_COUNT + 1;
+constexpr int DATASET_COLUMNS = FEATURE_COUNT + 2;
+
+/** @brief 序列模型每帧在特征之后追加的时序特征数（位置变化率占位） */
+constexpr int SEQUENCE_EXTRA_FEATURES = 2;
+constexpr int SEQUENCE_FRAME_FEATURES = FEATURE_COUNT + SEQUENCE_EXTRA_FEATURES;
+
+/** @brief 给定射线数时一行的特征数 */
+constexpr int featureCount(int rayCount) {
+    return BASE_FEATURES + 2 * (rayCount < MAX_RAYS ? rayCount : MAX_RAYS);
+}
+
+/** @brief 第一个射线命中标志的下标 */
+constexpr int rayHitBegin(int rayCount) {
+    return RAY_BEGIN + (rayCount < MAX_RAYS ? rayCount : MAX_RAYS);
+}
+
+namespace detail {
+
+constexpr bool sameName(const char* a, const char* b) {
+    return *a == *b && (*a == '\0' || sameName(a + 1, b + 1));
+}
+
+template <bool Scale>
+constexpr std::array<float, FEATURE_COUNT> makeTable() {
+    std::array<float, FEATURE_COUNT> table{};
+    for (int i = 0; i < BASE_FEATURES; ++i) {
+        table[i] = Scale ? BASE_FIELDS[i].scale : BASE_FIELDS[i].limit;
+    }
+    for (int i = 0; i < MAX_RAYS; ++i) {
+        table[RAY_BEGIN + i] = Scale ? RAY_DISTANCE.scale : RAY_DISTANCE.limit;
+        table[RAY_BEGIN + MAX_RAYS + i] = Scale ? RAY_HIT.scale : RAY_HIT.limit;
+    }
+    return table;
+}
+
+}  // namespace detail
+
+/** @brief 默认布局整行的标准化乘数和上限 */
+constexpr std::array<float, FEATURE_COUNT> SCALE = detail::makeTable<true>();
+constexpr std::array<float, FEATURE_COUNT> LIMIT = detail::makeTable<false>();
+
+// 字段顺序与下标必须一致
+static_assert(detail::sameName(BASE_FIELDS[POS_X].name, "pos_x"), "POS_X does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[POS_Y].name, "pos_y"), "POS_Y does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[VEL_X].name, "vel_x"), "VEL_X does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[VEL_Y].name, "vel_y"), "VEL_Y does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[ENERGY].name, "energy"), "ENERGY does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[GROUNDED].name, "is_grounded"), "GROUNDED does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[DIST_TARGET].name, "dist_target"), "DIST_TARGET does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[ANGLE_TARGET].name, "angle_target"), "ANGLE_TARGET does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[TARGET_X].name, "target_x"), "TARGET_X does not match BASE_FIELDS");
+static_assert(detail::sameName(BASE_FIELDS[TARGET_Y].name, "target_y"), "TARGET_Y does not match BASE_FIELDS");
+static_assert(RAY_BEGIN == TARGET_Y + 1, "ray features must follow the base features");
+
+// 已部署的模型第一层为130输入
+static_assert(FEATURE_COUNT == 130, "feature layout no longer matches the 130-input policy network");
+
+/**
+ * @brief 原地标准化一行原始特征
+ * @param features 一行特征（按本文件布局）
+ * @param rayCount 射线数；默认布局（MAX_RAYS条）整行查表，其余布局射线段单独处理
+ */
+inline void normalize(float* features, int rayCount = MAX_RAYS) {
+    if (rayCount >= MAX_RAYS) {
+        // 固定长度的逐元素乘法和取小，编译器展开为向量指令
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            features[i] = std::min(features[i] * SCALE[i], LIMIT[i]);
+        }
+        return;
+    }
+    for (int i = 0; i < BASE_FEATURES; ++i) {
+        features[i] = std::min(features[i] * SCALE[i], LIMIT[i]);
+    }
+    float* distances = features + RAY_BEGIN;
+    for (int i = 0; i < rayCount; ++i) {
+        distances[i] = std::min(distances[i] * RAY_DISTANCE.scale, RAY_DISTANCE.limit);
+    }
+}
+
+/**
+ * @brief 生成数据集表头：基础特征列、射线距离列、射线命中列、动作列
+ * @param rayCount 射线数
+ * @param rayLabel 第i条射线的列名后缀
+ */
+template <typename Label>
+std::string datasetHeader(int rayCount, Label rayLabel) {
+    std::string header;
+    for (const Field& field : BASE_FIELDS) {
+        header += header.empty() ? "" : ",";
+        header += field.name;
+    }
+    for (int i = 0; i < rayCount; ++i) {
+        header += std::string(",") + RAY_DISTANCE.name + rayLabel(i);
+    }
+    for (int i = 0; i < rayCount; ++i) {
+        header += std::string(",") + RAY_HIT.name + rayLabel(i);
+    }
+    for (const char* name : ACTION_NAMES) {
+        header += std::string(",") + name;
+    }
+    return header;
+}
+
+/** @brief 默认布局的数据集表头（训练程序据此校验数据集） */
+inline std::string datasetHeader() {
+    return datasetHeader(MAX_RAYS, [](int i) { return std::to_string(i); });
+}
+
+}  // namespace FeatureSchema
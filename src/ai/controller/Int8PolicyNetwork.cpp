@@ -0,0 +1,247 @@
+// src/ai/controller/Int8PolicyNetwork.cpp
+// 策略网络INT8推理：8输出x4输入的权重块 + pmaddubsw/vpdpbusd整数点积，逐通道还原与重新量化
+#include "Int8PolicyNetwork.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define INT8_NETWORK_AVX2 1
+#if defined(__AVXVNNI__) || (defined(__AVX512VNNI__) && defined(__AVX512VL__))
+#define INT8_NETWORK_VNNI 1
+#endif
+#endif
+
+static_assert((PolicyNetwork::OUTPUT_DIM + 7) / 8 == 1, "output layer must fit in one panel");
+
+namespace {
+
+constexpr int LANES = 8;
+constexpr int QUAD = 4;
+constexpr int MAX_GROUP = 8;  // 一次同时累加的面板数
+
+#if defined(INT8_NETWORK_AVX2)
+// acc += 每个输出对4个输入的点积；x为广播的4个7位激活，w为有符号权重块
+inline __m256i dot4(__m256i acc, __m256i x, __m256i w) {
+#if defined(INT8_NETWORK_VNNI) && defined(__AVXVNNI__)
+    return _mm256_dpbusd_avx_epi32(acc, x, w);
+#elif defined(INT8_NETWORK_VNNI)
+    return _mm256_dpbusd_epi32(acc, x, w);
+#else
+    // 激活不超过127，相邻两项之和不超过2*127*127，pmaddubsw不会饱和
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_maddubs_epi16(x, w), _mm256_set1_epi16(1)));
+#endif
+}
+
+// P个面板的整数点积；面板k的第g组权重位于 weights + k*quads + g
+template <int P>
+inline void dotGroup(const void* weights, int quads, const uint8_t* input, int32_t* acc) {
+    const __m256i* w = static_cast<const __m256i*>(weights);
+    __m256i sum[P];
+    for (int k = 0; k < P; ++k) {
+        sum[k] = _mm256_setzero_si256();
+    }
+    for (int g = 0; g < quads; ++g) {
+        int32_t packed;
+        std::memcpy(&packed, input + g * QUAD, sizeof(packed));
+        const __m256i x = _mm256_set1_epi32(packed);
+        for (int k = 0; k < P; ++k) {
+            sum[k] = dot4(sum[k], x, _mm256_load_si256(w + static_cast<size_t>(k) * quads + g));
+        }
+    }
+    for (int k = 0; k < P; ++k) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(acc + k * LANES), sum[k]);
+    }
+}
+#else
+// 每个权重块按32个字节位置各自累加（块内第i个字节乘以第i%4个输入），最后每4个合为一个输出，内层循环可被自动向量化
+template <int P>
+inline void dotGroup(const void* weights, int quads, const uint8_t* input, int32_t* acc) {
+    const int8_t* w = static_cast<const int8_t*>(weights);
+    constexpr int BLOCK = LANES * QUAD;
+    int32_t partial[P][BLOCK] = {};
+    for (int g = 0; g < quads; ++g) {
+        int32_t x[BLOCK];
+        for (int i = 0; i < BLOCK; ++i) {
+            x[i] = input[g * QUAD + i % QUAD];
+        }
+        for (int k = 0; k < P; ++k) {
+            const int8_t* block = w + (static_cast<size_t>(k) * quads + g) * BLOCK;
+            for (int i = 0; i < BLOCK; ++i) {
+                partial[k][i] += x[i] * block[i];
+            }
+        }
+    }
+    for (int k = 0; k < P; ++k) {
+        for (int o = 0; o < LANES; ++o) {
+            acc[k * LANES + o] = partial[k][o * QUAD] + partial[k][o * QUAD + 1] +
+                                 partial[k][o * QUAD + 2] + partial[k][o * QUAD + 3];
+        }
+    }
+}
+#endif
+
+// 把一个面板的int32累加还原为fp32；hidden时ReLU后重新量化为7位写入next
+inline void finishPanel(const int32_t* acc, const float* scale, const float* offset,
+                        const float* inverseScale, const float* zero, uint8_t* next, float* output, bool hidden) {
+#if defined(INT8_NETWORK_AVX2)
+    const __m256 y = _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_load_si256(reinterpret_cast<const __m256i*>(acc))),
+                                     _mm256_load_ps(scale), _mm256_load_ps(offset));
+    if (!hidden) {
+        _mm256_store_ps(output, y);
+        return;
+    }
+    const __m256 q = _mm256_fmadd_ps(_mm256_max_ps(y, _mm256_setzero_ps()), _mm256_load_ps(inverseScale),
+                                     _mm256_load_ps(zero));
+    __m256i qi = _mm256_cvtps_epi32(q);
+    qi = _mm256_min_epi32(_mm256_max_epi32(qi, _mm256_setzero_si256()),
+                          _mm256_set1_epi32(QuantizedModel::ACTIVATION_MAX));
+    const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(qi), _mm256_extracti128_si256(qi, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(next), _mm_packus_epi16(words, words));
+#else
+    for (int o = 0; o < LANES; ++o) {
+        const float y = static_cast<float>(acc[o]) * scale[o] + offset[o];
+        if (!hidden) {
+            output[o] = y;
+            continue;
+        }
+        const long q = std::lrint(std::max(y, 0.0f) * inverseScale[o] + zero[o]);
+        next[o] = static_cast<uint8_t>(std::clamp<long>(q, 0, QuantizedModel::ACTIVATION_MAX));
+    }
+#endif
+}
+
+}  // namespace
+
+bool Int8PolicyNetwork::load(const QuantizedModel& model) {
+    if (!model.isLoaded() || model.getPrecision() != QuantizedModel::Precision::Int8) {
+        return false;
+    }
+
+    for (int l = 0; l < LAYERS; ++l) {
+        const QuantizedModel::Layer& source = model.getLayer(l);
+        Layer& layer = layers[l];
+        layer.in = source.in;
+        layer.out = source.out;
+        layer.quads = (layer.in + QUAD - 1) / QUAD;
+        layer.panels = (layer.out + LANES - 1) / LANES;
+        layer.weights.assign(static_cast<size_t>(layer.panels) * layer.quads, Block{});
+        layer.scale.assign(layer.panels, Lane8{});
+        layer.offset.assign(layer.panels, Lane8{});
+        layer.nextInverseScale.assign(layer.panels, Lane8{});
+        layer.nextZero.assign(layer.panels, Lane8{});
+
+        for (int o = 0; o < layer.out; ++o) {
+            const int panel = o / LANES;
+            const int lane = o % LANES;
+            // 块内字节 lane*4 + t 为输出o对输入4g+t的权重；零点修正为整数，先精确求和
+            int32_t zeroCorrection = 0;
+            for (int j = 0; j < layer.in; ++j) {
+                const int8_t q = source.weights[static_cast<size_t>(j) * layer.out + o];
+                layer.weights[static_cast<size_t>(panel) * layer.quads + j / QUAD].v[lane * QUAD + j % QUAD] = q;
+                zeroCorrection += static_cast<int32_t>(source.inputZero[j]) * q;
+            }
+            layer.scale[panel].v[lane] = source.weightScale[o];
+            layer.offset[panel].v[lane] = source.bias[o] - source.weightScale[o] * static_cast<float>(zeroCorrection);
+            if (l + 1 < LAYERS) {
+                const QuantizedModel::Layer& next = model.getLayer(l + 1);
+                layer.nextInverseScale[panel].v[lane] = 1.0f / next.inputScale[o];
+                layer.nextZero[panel].v[lane] = next.inputZero[o];
+            }
+        }
+        // 激活按32字节块分配，补齐部分保持为0（对应的权重也为0）
+        activations[l].assign((layer.quads * QUAD + sizeof(Block) - 1) / sizeof(Block), Block{});
+    }
+
+    const QuantizedModel::Layer& first = model.getLayer(0);
+    inputInverseScale.resize(first.in);
+    inputZero.resize(first.in);
+    for (int j = 0; j < first.in; ++j) {
+        inputInverseScale[j] = 1.0f / first.inputScale[j];
+        inputZero[j] = first.inputZero[j];
+    }
+    loaded = true;
+    return true;
+}
+
+void Int8PolicyNetwork::layerForward(const Layer& layer, const uint8_t* input, uint8_t* next, float* output,
+                                     bool hidden) {
+    alignas(32) int32_t acc[MAX_GROUP * LANES];
+    int p = 0;
+    while (p < layer.panels) {
+        // 按8/4/2/1个面板分组
+        const int remaining = layer.panels - p;
+        const int group = remaining >= MAX_GROUP ? MAX_GROUP : remaining >= 4 ? 4 : remaining >= 2 ? 2 : 1;
+        const Block* weights = layer.weights.data() + static_cast<size_t>(p) * layer.quads;
+        switch (group) {
+        case 8: dotGroup<8>(weights, layer.quads, input, acc); break;
+        case 4: dotGroup<4>(weights, layer.quads, input, acc); break;
+        case 2: dotGroup<2>(weights, layer.quads, input, acc); break;
+        default: dotGroup<1>(weights, layer.quads, input, acc); break;
+        }
+        for (int k = 0; k < group; ++k) {
+            const int panel = p + k;
+            finishPanel(acc + k * LANES, layer.scale[panel].v, layer.offset[panel].v,
+                        layer.nextInverseScale[panel].v, layer.nextZero[panel].v,
+                        next ? next + panel * LANES : nullptr, output ? output + panel * LANES : nullptr, hidden);
+        }
+        p += group;
+    }
+}
+
+void Int8PolicyNetwork::forward(const float* input, float* output) {
+    if (!loaded) {
+        std::fill(output, output + PolicyNetwork::OUTPUT_DIM, 0.0f);
+        return;
+    }
+
+    // 第0层输入按通道量化：q = round(x / scale) + zero，截断到[0, ACTIVATION_MAX]
+    uint8_t* x = reinterpret_cast<uint8_t*>(activations[0].data());
+    const int inputDim = layers[0].in;
+    int j = 0;
+#if defined(INT8_NETWORK_AVX2)
+    for (; j + LANES <= inputDim; j += LANES) {
+        const __m256 q = _mm256_fmadd_ps(_mm256_loadu_ps(input + j), _mm256_loadu_ps(inputInverseScale.data() + j),
+                                         _mm256_loadu_ps(inputZero.data() + j));
+        __m256i qi = _mm256_cvtps_epi32(q);
+        qi = _mm256_min_epi32(_mm256_max_epi32(qi, _mm256_setzero_si256()),
+                              _mm256_set1_epi32(QuantizedModel::ACTIVATION_MAX));
+        const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(qi), _mm256_extracti128_si256(qi, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(x + j), _mm_packus_epi16(words, words));
+    }
+#endif
+    for (; j < inputDim; ++j) {
+        const long q = std::lrint(input[j] * inputInverseScale[j] + inputZero[j]);
+        x[j] = static_cast<uint8_t>(std::clamp<long>(q, 0, QuantizedModel::ACTIVATION_MAX));
+    }
+
+    for (int l = 0; l < LAYERS; ++l) {
+        // 隐藏层重新量化为下一层的输入，输出层写fp32
+        const bool hidden = l + 1 < LAYERS;
+        uint8_t* next = hidden ? reinterpret_cast<uint8_t*>(activations[l + 1].data()) : nullptr;
+        layerForward(layers[l], reinterpret_cast<const uint8_t*>(activations[l].data()), next,
+                     hidden ? nullptr : result.v, hidden);
+    }
+    for (int i = 0; i < PolicyNetwork::OUTPUT_DIM; ++i) {
+        output[i] = result.v[i];
+    }
+}
+
+const char* Int8PolicyNetwork::instructionSet() {
+#if defined(INT8_NETWORK_VNNI)
+    return "AVX-VNNI";
+#elif defined(INT8_NETWORK_AVX2)
+    return "AVX2";
+#else
+    return "Generic";
+#endif
+}
+
+bool Int8PolicyNetwork::isAccelerated() {
+#if defined(INT8_NETWORK_AVX2)
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,79 @@
+// src/ai/controller/Int8PolicyNetwork.h
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "QuantizedModel.h"
+
+/**
+ * @file Int8PolicyNetwork.h
+ * @brief 策略网络的INT8推理引擎（不依赖SFML）
+ * @details 网络结构与PolicyNetwork相同，参数来自QuantizedModel的INT8模型
+ * - 权重重排为8个输出x4个输入的32字节块：块内为输出o的4个连续输入权重，
+ *   每次广播4个7位激活，一条pmaddubsw + pmaddwd（支持AVX-VNNI时为一条vpdpbusd）完成32次乘加
+ * - 累加为精确的int32；每个输出通道一次融合乘加还原为fp32（包含偏置和零点修正），
+ *   隐藏层在ReLU后按下一层的通道缩放和零点重新量化为7位，输出层保持fp32
+ * - 各层的量化激活在加载时分配并在每次调用之间复用，前向不分配内存
+ * 整数部分在各指令集下逐位相同，不同指令集之间只有还原fp32时融合乘加的舍入差异
+ */
+class Int8PolicyNetwork {
+public:
+    /**
+     * @brief 从INT8量化模型加载并重排权重
+     * @return 模型未加载或精度不是INT8时返回false
+     */
+    bool load(const QuantizedModel& model);
+
+    /** @brief 是否已加载权重 */
+    bool isLoaded() const { return loaded; }
+
+    /**
+     * @brief 单个输入的前向传播
+     * @param input 标准化特征，长度PolicyNetwork::INPUT_DIM
+     * @param output 输出，长度PolicyNetwork::OUTPUT_DIM；未加载时输出全0
+     * @note 使用成员激活缓冲区，同一实例不能在多个线程中同时调用
+     */
+    void forward(const float* input, float* output);
+
+    /** @brief 编译时选用的指令集（"AVX-VNNI"、"AVX2"或"Generic"） */
+    static const char* instructionSet();
+
+    /** @brief 是否使用了SIMD整数点积（通用实现比fp32引擎慢，只用于验证） */
+    static bool isAccelerated();
+
+private:
+    static constexpr int LAYERS = PolicyNetwork::LAYERS;
+
+    /** @brief 8个输出 x 4个输入的int8权重块，32字节对齐 */
+    struct alignas(32) Block {
+        int8_t v[32];
+    };
+
+    /** @brief 8个float，32字节对齐 */
+    struct alignas(32) Lane8 {
+        float v[8];
+    };
+
+    /** @brief 一层的重排参数 */
+    struct Layer {
+        int in = 0;
+        int out = 0;
+        int quads = 0;                  // (in + 3) / 4
+        int panels = 0;                 // (out + 7) / 8
+        std::vector<Block> weights;     // panels * quads 个，面板p的第g组在 p*quads + g
+        std::vector<Lane8> scale;       // 每个输出：fp32 = acc * scale + offset
+        std::vector<Lane8> offset;      // 偏置减去零点修正
+        std::vector<Lane8> nextInverseScale;  // 隐藏层：下一层输入缩放的倒数
+        std::vector<Lane8> nextZero;          // 隐藏层：下一层输入零点
+    };
+
+    /** @brief 一层的整数点积和还原，hidden为true时重新量化写入next，否则写fp32到output */
+    static void layerForward(const Layer& layer, const uint8_t* input, uint8_t* next, float* output, bool hidden);
+
+    Layer layers[LAYERS];
+    std::vector<float> inputInverseScale;    // 第0层输入每个通道缩放的倒数
+    std::vector<float> inputZero;            // 第0层输入每个通道的零点
+    std::vector<Block> activations[LAYERS];  // 每层的7位输入，按4个一组补齐
+    Lane8 result;                            // 输出层的fp32结果（按面板补齐）
+    bool loaded = false;
+};
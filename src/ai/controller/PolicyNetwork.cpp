@@ -0,0 +1,348 @@
+// src/ai/controller/PolicyNetwork.cpp
+// 策略网络推理：面板重排的权重 + AVX2/FMA GEMV，偏置和ReLU融合在累加中
+#include "PolicyNetwork.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define POLICY_NETWORK_AVX2 1
+#endif
+
+namespace {
+
+constexpr int LANES = 8;
+constexpr int MAX_GROUP = 8;  // 一次同时累加的面板数，8个累加器足以掩盖FMA的延迟
+constexpr int ROW_TILE = 4;    // 批量微块的行数，4行x2面板共8个累加器
+constexpr int PANEL_TILE = 2;  // 批量微块的面板数
+constexpr int BLOCK_ROWS = 32;  // 一块同时穿过所有层的行数，两块激活（各32KB）留在L2中
+constexpr int MIN_ROWS_PER_THREAD = 64;  // 每个线程至少分到的行数，避免线程启动开销超过计算本身
+
+// 最宽一层补齐到8的倍数后的宽度，批量激活的行跨度
+constexpr int maxPaddedWidth() {
+    int width = 0;
+    for (int l = 1; l <= PolicyNetwork::LAYERS; ++l) {
+        width = std::max(width, (PolicyNetwork::DIMS[l] + LANES - 1) / LANES * LANES);
+    }
+    return width;
+}
+constexpr int SCRATCH_WIDTH = maxPaddedWidth();
+
+#if defined(POLICY_NETWORK_AVX2)
+// P个面板（P*8个输出）共用每个输入的广播值；面板k的第j行位于 weights + (k*in + j)*8
+template <int P>
+inline void gemvGroup(const float* weights, int in, const float* input, const float* bias, float* output, bool relu) {
+    __m256 acc[P];
+    for (int k = 0; k < P; ++k) {
+        acc[k] = _mm256_load_ps(bias + k * LANES);
+    }
+    for (int j = 0; j < in; ++j) {
+        const __m256 x = _mm256_broadcast_ss(input + j);
+        const float* row = weights + static_cast<size_t>(j) * LANES;
+        for (int k = 0; k < P; ++k) {
+            acc[k] = _mm256_fmadd_ps(_mm256_load_ps(row + static_cast<size_t>(k) * in * LANES), x, acc[k]);
+        }
+    }
+    const __m256 zero = _mm256_setzero_ps();
+    for (int k = 0; k < P; ++k) {
+        _mm256_store_ps(output + k * LANES, relu ? _mm256_max_ps(acc[k], zero) : acc[k]);
+    }
+}
+
+// R行 x P个面板的微块：每个输入位置读一次P个面板的权重，供R行的广播值复用
+template <int R, int P>
+inline void gemmTile(const float* weights, int in, const float* input, size_t inputStride,
+                     const float* bias, float* output, size_t outputStride, bool relu) {
+    __m256 acc[R][P];
+    for (int k = 0; k < P; ++k) {
+        const __m256 b = _mm256_load_ps(bias + k * LANES);
+        for (int r = 0; r < R; ++r) {
+            acc[r][k] = b;
+        }
+    }
+    for (int j = 0; j < in; ++j) {
+        __m256 w[P];
+        for (int k = 0; k < P; ++k) {
+            w[k] = _mm256_load_ps(weights + (static_cast<size_t>(k) * in + j) * LANES);
+        }
+        for (int r = 0; r < R; ++r) {
+            const __m256 x = _mm256_broadcast_ss(input + r * inputStride + j);
+            for (int k = 0; k < P; ++k) {
+                acc[r][k] = _mm256_fmadd_ps(w[k], x, acc[r][k]);
+            }
+        }
+    }
+    const __m256 zero = _mm256_setzero_ps();
+    for (int r = 0; r < R; ++r) {
+        for (int k = 0; k < P; ++k) {
+            _mm256_store_ps(output + r * outputStride + k * LANES, relu ? _mm256_max_ps(acc[r][k], zero) : acc[r][k]);
+        }
+    }
+}
+#else
+template <int P>
+inline void gemvGroup(const float* weights, int in, const float* input, const float* bias, float* output, bool relu) {
+    float acc[P][LANES];
+    for (int k = 0; k < P; ++k) {
+        for (int l = 0; l < LANES; ++l) {
+            acc[k][l] = bias[k * LANES + l];
+        }
+    }
+    for (int j = 0; j < in; ++j) {
+        const float x = input[j];
+        const float* row = weights + static_cast<size_t>(j) * LANES;
+        for (int k = 0; k < P; ++k) {
+            const float* w = row + static_cast<size_t>(k) * in * LANES;
+            for (int l = 0; l < LANES; ++l) {
+                acc[k][l] += w[l] * x;
+            }
+        }
+    }
+    for (int k = 0; k < P; ++k) {
+        for (int l = 0; l < LANES; ++l) {
+            output[k * LANES + l] = relu ? std::max(acc[k][l], 0.0f) : acc[k][l];
+        }
+    }
+}
+
+template <int R, int P>
+inline void gemmTile(const float* weights, int in, const float* input, size_t inputStride,
+                     const float* bias, float* output, size_t outputStride, bool relu) {
+    float acc[R][P][LANES];
+    for (int r = 0; r < R; ++r) {
+        for (int k = 0; k < P; ++k) {
+            for (int l = 0; l < LANES; ++l) {
+                acc[r][k][l] = bias[k * LANES + l];
+            }
+        }
+    }
+    for (int j = 0; j < in; ++j) {
+        for (int r = 0; r < R; ++r) {
+            const float x = input[r * inputStride + j];
+            for (int k = 0; k < P; ++k) {
+                const float* w = weights + (static_cast<size_t>(k) * in + j) * LANES;
+                for (int l = 0; l < LANES; ++l) {
+                    acc[r][k][l] += w[l] * x;
+                }
+            }
+        }
+    }
+    for (int r = 0; r < R; ++r) {
+        for (int k = 0; k < P; ++k) {
+            for (int l = 0; l < LANES; ++l) {
+                output[r * outputStride + k * LANES + l] = relu ? std::max(acc[r][k][l], 0.0f) : acc[r][k][l];
+            }
+        }
+    }
+}
+#endif
+
+// P个面板扫过rows行（ROW_TILE的整数倍），每次ROW_TILE行
+template <int P>
+inline void gemmPanels(const float* weights, int in, const float* input, size_t inputStride, int rows,
+                       const float* bias, float* output, size_t outputStride, bool relu) {
+    for (int r = 0; r < rows; r += ROW_TILE) {
+        gemmTile<ROW_TILE, P>(weights, in, input + r * inputStride, inputStride, bias,
+                              output + r * outputStride, outputStride, relu);
+    }
+}
+
+}  // namespace
+
+bool PolicyNetwork::readModel(const std::string& filename, std::vector<std::vector<float>>& weights,
+                              std::vector<std::vector<float>>& biases) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Cannot open model file: " << filename << std::endl;
+        return false;
+    }
+
+    // 先读全部权重，再读全部偏置，每段以size_t长度开头
+    weights.assign(LAYERS, {});
+    biases.assign(LAYERS, {});
+    for (int part = 0; part < 2; ++part) {
+        for (int l = 0; l < LAYERS; ++l) {
+            const size_t expected = part == 0 ? static_cast<size_t>(DIMS[l]) * DIMS[l + 1] : static_cast<size_t>(DIMS[l + 1]);
+            size_t size = 0;
+            file.read(reinterpret_cast<char*>(&size), sizeof(size));
+            if (!file || size != expected) {
+                std::cerr << "Model " << (part == 0 ? "weight" : "bias") << " dimension mismatch: "
+                          << size << " vs " << expected << std::endl;
+                return false;
+            }
+            std::vector<float>& values = part == 0 ? weights[l] : biases[l];
+            values.resize(size);
+            file.read(reinterpret_cast<char*>(values.data()), size * sizeof(float));
+        }
+    }
+    if (!file) {
+        std::cerr << "Model file is truncated: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool PolicyNetwork::load(const std::vector<std::vector<float>>& weights,
+                         const std::vector<std::vector<float>>& biases) {
+    if (weights.size() < LAYERS || biases.size() < LAYERS) {
+        return false;
+    }
+    for (int l = 0; l < LAYERS; ++l) {
+        if (weights[l].size() != static_cast<size_t>(DIMS[l]) * DIMS[l + 1] ||
+            biases[l].size() != static_cast<size_t>(DIMS[l + 1])) {
+            return false;
+        }
+    }
+
+    for (int l = 0; l < LAYERS; ++l) {
+        Layer& layer = layers[l];
+        layer.in = DIMS[l];
+        layer.out = DIMS[l + 1];
+        layer.panels = (layer.out + LANES - 1) / LANES;
+        layer.weights.assign(static_cast<size_t>(layer.panels) * layer.in, Lane8{});
+        layer.bias.assign(layer.panels, Lane8{});
+
+        // [输入][输出] -> 面板p的第j行为输出p*8..p*8+7对输入j的权重，补齐的通道为0
+        const std::vector<float>& w = weights[l];
+        for (int i = 0; i < layer.out; ++i) {
+            const int panel = i / LANES;
+            const int lane = i % LANES;
+            for (int j = 0; j < layer.in; ++j) {
+                layer.weights[static_cast<size_t>(panel) * layer.in + j].v[lane] = w[static_cast<size_t>(j) * layer.out + i];
+            }
+            layer.bias[panel].v[lane] = biases[l][i];
+        }
+        activations[l].assign(layer.panels, Lane8{});
+    }
+    loaded = true;
+    return true;
+}
+
+void PolicyNetwork::gemv(const Layer& layer, const float* input, Lane8* output, bool relu) {
+    const float* weights = layer.weights[0].v;
+    const float* bias = layer.bias[0].v;
+    const size_t panelStride = static_cast<size_t>(layer.in) * LANES;
+
+    int p = 0;
+    for (; p + MAX_GROUP <= layer.panels; p += MAX_GROUP) {
+        gemvGroup<MAX_GROUP>(weights + p * panelStride, layer.in, input, bias + p * LANES, output[p].v, relu);
+    }
+    // 剩余面板按4/2/1分组
+    if (p + 4 <= layer.panels) {
+        gemvGroup<4>(weights + p * panelStride, layer.in, input, bias + p * LANES, output[p].v, relu);
+        p += 4;
+    }
+    if (p + 2 <= layer.panels) {
+        gemvGroup<2>(weights + p * panelStride, layer.in, input, bias + p * LANES, output[p].v, relu);
+        p += 2;
+    }
+    if (p < layer.panels) {
+        gemvGroup<1>(weights + p * panelStride, layer.in, input, bias + p * LANES, output[p].v, relu);
+    }
+}
+
+void PolicyNetwork::forward(const float* input, float* output) {
+    if (!loaded) {
+        std::fill(output, output + OUTPUT_DIM, 0.0f);
+        return;
+    }
+    const float* x = input;
+    for (int l = 0; l < LAYERS; ++l) {
+        // 隐藏层ReLU，输出层线性
+        gemv(layers[l], x, activations[l].data(), l + 1 < LAYERS);
+        x = activations[l][0].v;
+    }
+    for (int i = 0; i < OUTPUT_DIM; ++i) {
+        output[i] = x[i];
+    }
+}
+
+void PolicyNetwork::gemm(const Layer& layer, const float* input, size_t inputStride, int rows,
+                         float* output, size_t outputStride, bool relu) {
+    const float* weights = layer.weights[0].v;
+    const float* bias = layer.bias[0].v;
+    const size_t panelStride = static_cast<size_t>(layer.in) * LANES;
+
+    const int tiled = rows / ROW_TILE * ROW_TILE;
+    int p = 0;
+    for (; p + PANEL_TILE <= layer.panels; p += PANEL_TILE) {
+        gemmPanels<PANEL_TILE>(weights + p * panelStride, layer.in, input, inputStride, tiled,
+                               bias + p * LANES, output + p * LANES, outputStride, relu);
+    }
+    if (p < layer.panels) {
+        gemmPanels<1>(weights + p * panelStride, layer.in, input, inputStride, tiled,
+                      bias + p * LANES, output + p * LANES, outputStride, relu);
+    }
+    // 不足一个微块的剩余行逐行GEMV（最多8个面板同时累加，比单行微块更能掩盖延迟）
+    for (int r = tiled; r < rows; ++r) {
+        gemv(layer, input + r * inputStride, reinterpret_cast<Lane8*>(output + r * outputStride), relu);
+    }
+}
+
+void PolicyNetwork::forwardRange(const float* inputs, int begin, int end, size_t inputStride, float* outputs,
+                                 Lane8* scratch) const {
+    float* buffers[2] = {scratch[0].v, scratch[BLOCK_ROWS * SCRATCH_WIDTH / LANES].v};
+    for (int row = begin; row < end; row += BLOCK_ROWS) {
+        const int rows = std::min(BLOCK_ROWS, end - row);
+        // 一块行依次穿过所有层，层间在两块激活之间交替
+        const float* x = inputs + static_cast<size_t>(row) * inputStride;
+        size_t xStride = inputStride;
+        for (int l = 0; l < LAYERS; ++l) {
+            float* y = buffers[l % 2];
+            gemm(layers[l], x, xStride, rows, y, SCRATCH_WIDTH, l + 1 < LAYERS);
+            x = y;
+            xStride = SCRATCH_WIDTH;
+        }
+        for (int r = 0; r < rows; ++r) {
+            for (int i = 0; i < OUTPUT_DIM; ++i) {
+                outputs[static_cast<size_t>(row + r) * OUTPUT_DIM + i] = x[r * SCRATCH_WIDTH + i];
+            }
+        }
+    }
+}
+
+bool PolicyNetwork::forwardBatch(const float* inputs, int count, size_t inputStride, float* outputs, int threads) {
+    if (inputStride < static_cast<size_t>(INPUT_DIM)) {
+        return false;
+    }
+    if (count <= 0) return true;
+    if (!loaded) {
+        std::fill(outputs, outputs + static_cast<size_t>(count) * OUTPUT_DIM, 0.0f);
+        return true;
+    }
+
+    threads = std::max(1, std::min(threads, (count + MIN_ROWS_PER_THREAD - 1) / MIN_ROWS_PER_THREAD));
+    const size_t scratchPerThread = static_cast<size_t>(2) * BLOCK_ROWS * SCRATCH_WIDTH / LANES;
+    if (batchScratch.size() < scratchPerThread * threads) {
+        batchScratch.resize(scratchPerThread * threads);
+    }
+    if (threads == 1) {
+        forwardRange(inputs, 0, count, inputStride, outputs, batchScratch.data());
+        return true;
+    }
+
+    // 行按连续区间分给各线程，每个线程使用自己的激活缓冲区、写互不重叠的输出行
+    std::vector<std::thread> pool;
+    const int chunk = (count + threads - 1) / threads;
+    for (int begin = 0, t = 0; begin < count; begin += chunk, ++t) {
+        const int end = std::min(count, begin + chunk);
+        Lane8* scratch = batchScratch.data() + scratchPerThread * t;
+        pool.emplace_back([this, inputs, begin, end, inputStride, outputs, scratch]() {
+            forwardRange(inputs, begin, end, inputStride, outputs, scratch);
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return true;
+}
+
+const char* PolicyNetwork::instructionSet() {
+#if defined(POLICY_NETWORK_AVX2)
+    return "AVX2+FMA";
+#else
+    return "Generic";
+#endif
+}
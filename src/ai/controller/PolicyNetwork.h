@@ -0,0 +1,127 @@
+// src/ai/controller/PolicyNetwork.h
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "FeatureSchema.h"
+
+/**
+ * @file PolicyNetwork.h
+ * @brief 策略网络（多层感知机）的推理引擎（不依赖SFML）
+ * @details 网络结构 130 -> 256 -> 128 -> 64 -> 32 -> 16 -> 2，隐藏层ReLU，输出层线性
+ * - 模型文件中第l层权重按[输入][输出]存储（下标 j*out + i），加载时重排为按8个输出一组的面板：
+ *   面板p内第j个输入对应连续8个float，即输出p*8..p*8+7的权重，前向时沿输入方向顺序读取
+ * - 每层一次GEMV：广播一个输入，与最多8个面板做乘加，偏置作为累加初值，ReLU在写回时完成
+ * - 权重、偏置和各层激活都按32字节对齐，激活缓冲区在加载时分配并在每次调用之间复用，前向不分配内存
+ * - 批量前向把每层变成GEMM：每32行为一块依次穿过所有层，块内以4行x2面板的微块累加，
+ *   一次读入的权重被4行复用，2个面板的权重在扫过整块时留在L1中；大批量按连续区间分给多个线程
+ * 指令集在编译期选择：AVX2+FMA时使用256位融合乘加，否则为编译器自动向量化的通用实现，
+ * 两者的结果只有融合乘加带来的舍入差异；批量与单个前向的求和顺序相同，同一输入的输出逐位一致
+ */
+class PolicyNetwork {
+public:
+    /** @brief 层数 */
+    static constexpr int LAYERS = 6;
+
+    /** @brief 各层宽度（第0项为输入维度） */
+    static constexpr int DIMS[LAYERS + 1] = {FeatureSchema::FEATURE_COUNT, 256, 128, 64, 32, 16, 2};
+
+    /** @brief 输入维度 */
+    static constexpr int INPUT_DIM = DIMS[0];
+
+    /** @brief 输出维度（moveX, useEnergy） */
+    static constexpr int OUTPUT_DIM = DIMS[LAYERS];
+
+    /** @brief 离散化阈值：moveX超过±MOVE_THRESHOLD取±1，useEnergy超过ENERGY_THRESHOLD时飞行 */
+    static constexpr float MOVE_THRESHOLD = 0.33f;
+    static constexpr float ENERGY_THRESHOLD = 0.5f;
+
+    /** @brief 把moveX输出离散化为-1/0/1 */
+    static int discreteMoveX(float output) {
+        return output > MOVE_THRESHOLD ? 1 : (output < -MOVE_THRESHOLD ? -1 : 0);
+    }
+
+    /** @brief 把useEnergy输出离散化为0/1 */
+    static int discreteUseEnergy(float output) { return output > ENERGY_THRESHOLD ? 1 : 0; }
+
+    /**
+     * @brief 读取fp32模型文件（SLTrainer保存的二进制格式）
+     * @details 依次为每层权重、每层偏置，各自以size_t长度开头，长度必须与DIMS一致
+     * @param filename 模型文件路径
+     * @param weights 输出：每层权重，按[输入][输出]顺序
+     * @param biases 输出：每层偏置
+     * @return 文件无法打开或尺寸不符时返回false并输出原因
+     */
+    static bool readModel(const std::string& filename, std::vector<std::vector<float>>& weights,
+                          std::vector<std::vector<float>>& biases);
+
+    /**
+     * @brief 加载权重并重排为面板格式
+     * @param weights 每层权重，按模型文件的[输入][输出]顺序，长度DIMS[l]*DIMS[l+1]
+     * @param biases 每层偏置，长度DIMS[l+1]
+     * @return 层数或尺寸不符时返回false，原有权重保持不变
+     */
+    bool load(const std::vector<std::vector<float>>& weights, const std::vector<std::vector<float>>& biases);
+
+    /** @brief 是否已加载权重 */
+    bool isLoaded() const { return loaded; }
+
+    /**
+     * @brief 单个输入的前向传播
+     * @param input 标准化特征，长度INPUT_DIM
+     * @param output 输出，长度OUTPUT_DIM
+     * @note 使用成员激活缓冲区，同一实例不能在多个线程中同时调用
+     */
+    void forward(const float* input, float* output);
+
+    /**
+     * @brief 批量前向传播
+     * @param inputs 输入矩阵，第i行（长度INPUT_DIM）位于inputs + i*inputStride
+     * @param count 行数
+     * @param inputStride 相邻输入行的间隔（以float计），不小于INPUT_DIM
+     * @param outputs 输出矩阵，第i行写在outputs + i*OUTPUT_DIM
+     * @param threads 工作线程数，行按连续区间分给各线程（每线程至少64行）；1表示在当前线程计算
+     * @return 步长不足时返回false，不写输出；未加载权重时输出全0
+     * @note 各线程的激活缓冲区由成员保存，只在线程数或首次调用时增长，同一实例不能在多个线程中同时调用
+     */
+    bool forwardBatch(const float* inputs, int count, size_t inputStride, float* outputs, int threads = 1);
+
+    /** @brief 编译时选用的指令集（"AVX2+FMA"或"Generic"） */
+    static const char* instructionSet();
+
+private:
+    /** @brief 8个float，32字节对齐（对齐分配由C++17的对齐new保证） */
+    struct alignas(32) Lane8 {
+        float v[8];
+    };
+
+    /** @brief 一层的面板权重 */
+    struct Layer {
+        int in = 0;
+        int out = 0;
+        int panels = 0;                 // (out + 7) / 8
+        std::vector<Lane8> weights;     // panels * in 个，面板p的第j行在 p*in + j
+        std::vector<Lane8> bias;        // panels 个，超出out的通道为0
+    };
+
+    /** @brief 一层GEMV：out = act(bias + W^T * in) */
+    static void gemv(const Layer& layer, const float* input, Lane8* output, bool relu);
+
+    /**
+     * @brief 一层GEMM：rows行输入各自做一次GEMV，按微块共享权重读取
+     * @param input 第r行位于input + r*inputStride
+     * @param output 第r行写在output + r*outputStride（32字节对齐，按面板补齐）
+     */
+    static void gemm(const Layer& layer, const float* input, size_t inputStride, int rows,
+                     float* output, size_t outputStride, bool relu);
+
+    /** @brief 在当前线程计算[begin, end)行，scratch为两块交替使用的激活缓冲区 */
+    void forwardRange(const float* inputs, int begin, int end, size_t inputStride, float* outputs,
+                      Lane8* scratch) const;
+
+    Layer layers[LAYERS];
+    std::vector<Lane8> activations[LAYERS];  // 每层输出，按面板补齐到8的倍数
+    std::vector<Lane8> batchScratch;         // 批量前向：每线程两块BLOCK_ROWS行的激活
+    bool loaded = false;
+};
@@ -0,0 +1,295 @@
+// src/ai/controller/QuantizedModel.cpp
+// 策略网络训练后量化：按通道校准、FP16转换与量化模型文件读写
+#include "QuantizedModel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static_assert(sizeof(QuantizedModel::Header) == 16, "QuantizedModel header layout changed");
+
+namespace {
+
+constexpr char MAGIC[4] = {'N', 'Q', 'P', 'M'};
+
+template <typename T>
+void writeArray(std::ofstream& file, const std::vector<T>& values) {
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+void readArray(std::ifstream& file, std::vector<T>& values, size_t count) {
+    values.resize(count);
+    file.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+}
+
+}  // namespace
+
+bool QuantizedModel::quantize(const std::vector<std::vector<float>>& weights,
+                              const std::vector<std::vector<float>>& biases,
+                              const float* frames, int count, size_t stride, Precision target) {
+    constexpr int LAYERS = PolicyNetwork::LAYERS;
+    if (weights.size() < LAYERS || biases.size() < LAYERS || stride < static_cast<size_t>(PolicyNetwork::INPUT_DIM)) {
+        return false;
+    }
+    for (int l = 0; l < LAYERS; ++l) {
+        if (weights[l].size() != static_cast<size_t>(PolicyNetwork::DIMS[l]) * PolicyNetwork::DIMS[l + 1] ||
+            biases[l].size() != static_cast<size_t>(PolicyNetwork::DIMS[l + 1])) {
+            return false;
+        }
+    }
+    if (target == Precision::Int8 && count <= 0) {
+        return false;
+    }
+
+    precision = target;
+    agreement = 0.0f;
+    for (int l = 0; l < LAYERS; ++l) {
+        Layer& layer = layers[l];
+        layer = Layer{};
+        layer.in = PolicyNetwork::DIMS[l];
+        layer.out = PolicyNetwork::DIMS[l + 1];
+        layer.bias = biases[l];
+    }
+
+    if (target == Precision::Fp16) {
+        for (int l = 0; l < LAYERS; ++l) {
+            layers[l].halfWeights.resize(weights[l].size());
+            std::transform(weights[l].begin(), weights[l].end(), layers[l].halfWeights.begin(), floatToHalf);
+        }
+        loaded = true;
+        return true;
+    }
+
+    // 校准：fp32逐帧前向，记录每层每个输入通道的取值范围
+    std::vector<float> minValue[LAYERS], maxValue[LAYERS];
+    for (int l = 0; l < LAYERS; ++l) {
+        minValue[l].assign(PolicyNetwork::DIMS[l], 0.0f);
+        maxValue[l].assign(PolicyNetwork::DIMS[l], 0.0f);
+    }
+    std::vector<float> x, y;
+    for (int i = 0; i < count; ++i) {
+        const float* frame = frames + static_cast<size_t>(i) * stride;
+        x.assign(frame, frame + PolicyNetwork::INPUT_DIM);
+        for (int l = 0; l < LAYERS; ++l) {
+            const int in = PolicyNetwork::DIMS[l], out = PolicyNetwork::DIMS[l + 1];
+            for (int j = 0; j < in; ++j) {
+                minValue[l][j] = std::min(minValue[l][j], x[j]);
+                maxValue[l][j] = std::max(maxValue[l][j], x[j]);
+            }
+            y.assign(biases[l].begin(), biases[l].end());
+            for (int j = 0; j < in; ++j) {
+                const float* w = weights[l].data() + static_cast<size_t>(j) * out;
+                for (int o = 0; o < out; ++o) {
+                    y[o] += x[j] * w[o];
+                }
+            }
+            if (l + 1 < LAYERS) {
+                for (float& value : y) value = std::max(value, 0.0f);
+            }
+            x.swap(y);
+        }
+    }
+
+    for (int l = 0; l < LAYERS; ++l) {
+        Layer& layer = layers[l];
+        // 输入：范围[min(最小值,0), max(最大值,0)]映射到[0,ACTIVATION_MAX]，从不出现非零值的通道缩放取1
+        layer.inputScale.resize(layer.in);
+        layer.inputZero.resize(layer.in);
+        for (int j = 0; j < layer.in; ++j) {
+            const float range = maxValue[l][j] - minValue[l][j];
+            const float scale = range > 0.0f ? range / ACTIVATION_MAX : 1.0f;
+            layer.inputScale[j] = scale;
+            layer.inputZero[j] = static_cast<uint8_t>(
+                std::clamp<long>(std::lround(-minValue[l][j] / scale), 0, ACTIVATION_MAX));
+        }
+
+        // 权重：先乘上输入缩放，再按输出通道取最大绝对值对称量化
+        // 校准中恒为0的通道（如从不激活的ReLU）权重无关紧要，量化为0，不参与缩放，否则缩放1会压扁其余权重
+        const std::vector<float>& w = weights[l];
+        layer.weightScale.assign(layer.out, 0.0f);
+        for (int j = 0; j < layer.in; ++j) {
+            if (maxValue[l][j] == minValue[l][j]) continue;
+            for (int o = 0; o < layer.out; ++o) {
+                const float folded = std::fabs(w[static_cast<size_t>(j) * layer.out + o] * layer.inputScale[j]);
+                layer.weightScale[o] = std::max(layer.weightScale[o], folded);
+            }
+        }
+        for (float& scale : layer.weightScale) {
+            scale = scale > 0.0f ? scale / WEIGHT_MAX : 1.0f;
+        }
+        layer.weights.assign(w.size(), 0);
+        for (int j = 0; j < layer.in; ++j) {
+            if (maxValue[l][j] == minValue[l][j]) continue;
+            for (int o = 0; o < layer.out; ++o) {
+                const size_t index = static_cast<size_t>(j) * layer.out + o;
+                const long q = std::lround(w[index] * layer.inputScale[j] / layer.weightScale[o]);
+                layer.weights[index] = static_cast<int8_t>(std::clamp<long>(q, -WEIGHT_MAX, WEIGHT_MAX));
+            }
+        }
+    }
+    loaded = true;
+    return true;
+}
+
+bool QuantizedModel::toFloat(std::vector<std::vector<float>>& weights,
+                             std::vector<std::vector<float>>& biases) const {
+    if (!loaded || precision != Precision::Fp16) {
+        return false;
+    }
+    weights.assign(PolicyNetwork::LAYERS, {});
+    biases.assign(PolicyNetwork::LAYERS, {});
+    for (int l = 0; l < PolicyNetwork::LAYERS; ++l) {
+        weights[l].resize(layers[l].halfWeights.size());
+        std::transform(layers[l].halfWeights.begin(), layers[l].halfWeights.end(), weights[l].begin(), halfToFloat);
+        biases[l] = layers[l].bias;
+    }
+    return true;
+}
+
+bool QuantizedModel::save(const std::string& path) const {
+    if (!loaded) {
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "[QUANT] Cannot write " << path << std::endl;
+        return false;
+    }
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.precision = static_cast<uint32_t>(precision);
+    header.agreement = agreement;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const Layer& layer : layers) {
+        if (precision == Precision::Int8) {
+            writeArray(file, layer.inputScale);
+            writeArray(file, layer.inputZero);
+            writeArray(file, layer.weightScale);
+            writeArray(file, layer.weights);
+        } else {
+            writeArray(file, layer.halfWeights);
+        }
+        writeArray(file, layer.bias);
+    }
+    if (!file) {
+        std::cerr << "[QUANT] Failed while writing " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool QuantizedModel::load(const std::string& path) {
+    loaded = false;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "[QUANT] Cannot open " << path << std::endl;
+        return false;
+    }
+    Header header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "[QUANT] " << path << " is not a quantized model file" << std::endl;
+        return false;
+    }
+    if (header.version != VERSION) {
+        std::cerr << "[QUANT] Unsupported quantized model version " << header.version
+                  << " (expected " << VERSION << ")" << std::endl;
+        return false;
+    }
+    if (header.precision != static_cast<uint32_t>(Precision::Int8) &&
+        header.precision != static_cast<uint32_t>(Precision::Fp16)) {
+        std::cerr << "[QUANT] Unknown precision " << header.precision << " in " << path << std::endl;
+        return false;
+    }
+
+    precision = static_cast<Precision>(header.precision);
+    agreement = header.agreement;
+    for (int l = 0; l < PolicyNetwork::LAYERS; ++l) {
+        Layer& layer = layers[l];
+        layer = Layer{};
+        layer.in = PolicyNetwork::DIMS[l];
+        layer.out = PolicyNetwork::DIMS[l + 1];
+        const size_t weightCount = static_cast<size_t>(layer.in) * layer.out;
+        if (precision == Precision::Int8) {
+            readArray(file, layer.inputScale, layer.in);
+            readArray(file, layer.inputZero, layer.in);
+            readArray(file, layer.weightScale, layer.out);
+            readArray(file, layer.weights, weightCount);
+        } else {
+            readArray(file, layer.halfWeights, weightCount);
+        }
+        readArray(file, layer.bias, layer.out);
+    }
+    if (!file || file.peek() != std::char_traits<char>::eof()) {
+        std::cerr << "[QUANT] " << path << " does not match the network structure" << std::endl;
+        return false;
+    }
+    loaded = true;
+    return true;
+}
+
+size_t QuantizedModel::fileSize() const {
+    size_t size = sizeof(Header);
+    for (const Layer& layer : layers) {
+        size += layer.inputScale.size() * sizeof(float) + layer.inputZero.size() +
+                layer.weightScale.size() * sizeof(float) + layer.weights.size() +
+                layer.halfWeights.size() * sizeof(uint16_t) + layer.bias.size() * sizeof(float);
+    }
+    return size;
+}
+
+const char* QuantizedModel::precisionName(Precision value) {
+    return value == Precision::Int8 ? "int8" : "fp16";
+}
+
+uint16_t QuantizedModel::floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t magnitude = bits & 0x7fffffffu;
+
+    if (magnitude >= 0x7f800000u) {
+        // 无穷保持无穷，NaN保留为静默NaN
+        return sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x0200u : 0u);
+    }
+    if (magnitude >= 0x477ff000u) {
+        // 不小于65520时舍入到无穷
+        return sign | 0x7c00u;
+    }
+    if (magnitude < 0x38800000u) {
+        // 半精度非规格化数：以2^-24为单位就近取整（乘以2的幂是精确的）
+        float absolute;
+        std::memcpy(&absolute, &magnitude, sizeof(absolute));
+        return sign | static_cast<uint16_t>(std::lrint(absolute * 16777216.0f));
+    }
+    // 规格化数：指数偏置127 -> 15，尾数23位 -> 10位，就近舍入到偶数（进位可以进到指数）
+    uint32_t half = (magnitude - 0x38000000u) >> 13;
+    const uint32_t rest = magnitude & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) {
+        ++half;
+    }
+    return sign | static_cast<uint16_t>(half);
+}
+
+float QuantizedModel::halfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1fu;
+    const uint32_t mantissa = value & 0x3ffu;
+    uint32_t bits;
+    if (exponent == 0) {
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 31) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
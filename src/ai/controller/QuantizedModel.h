@@ -0,0 +1,116 @@
+// src/ai/controller/QuantizedModel.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PolicyNetwork.h"
+
+/**
+ * @file QuantizedModel.h
+ * @brief 策略网络的训练后量化模型：校准、文件读写（不依赖SFML）
+ * @details 由quantize_model工具根据fp32模型和DataCollector录制的帧生成，AIController加载后以低精度推理
+ * - INT8：每层输入按通道非对称量化为7位无符号数[0,127]，缩放和零点取自校准帧上该通道的最小/最大值
+ *   （范围总是包含0，ReLU之后的零点为0）；输入缩放折进权重后，权重按输出通道对称量化为[-127,127]。
+ *   激活只用7位，使pmaddubsw相邻两项之和（最大2*127*127）不会在int16中饱和
+ * - FP16：权重以半精度存储，加载时展开为fp32，计算仍由PolicyNetwork完成
+ *
+ * 文件格式（小端序）：
+ * - 文件头（16字节）：magic "NQPM"、版本号、精度、量化后与fp32的决策一致率（工具在留出帧上测得）
+ * - INT8每层：输入缩放(float*in)、输入零点(uint8*in)、权重缩放(float*out)、权重(int8*in*out)、偏置(float*out)
+ * - FP16每层：权重(uint16*in*out)、偏置(float*out)
+ * 权重与fp32模型文件相同，按[输入][输出]顺序存储
+ */
+class QuantizedModel {
+public:
+    /** @brief 量化精度（写入文件头） */
+    enum class Precision : uint32_t {
+        Int8 = 1,
+        Fp16 = 2,
+    };
+
+    /** @brief 文件头 */
+    struct Header {
+        char magic[4];          // "NQPM"
+        uint32_t version;       // 格式版本
+        uint32_t precision;     // Precision
+        float agreement;        // 与fp32的决策一致率（0~1）
+    };
+
+    /** @brief 一层的量化参数 */
+    struct Layer {
+        int in = 0;
+        int out = 0;
+        std::vector<float> inputScale;      // INT8：每个输入通道的缩放，x ≈ scale * (q - zero)
+        std::vector<uint8_t> inputZero;     // INT8：每个输入通道的零点（0~ACTIVATION_MAX）
+        std::vector<float> weightScale;     // INT8：每个输出通道的权重缩放（已包含输入缩放）
+        std::vector<int8_t> weights;        // INT8：[输入][输出]
+        std::vector<uint16_t> halfWeights;  // FP16：[输入][输出]
+        std::vector<float> bias;            // 两种精度的偏置都保留fp32
+    };
+
+    static constexpr uint32_t VERSION = 1;
+
+    /** @brief 激活的最大量化值（7位） */
+    static constexpr int ACTIVATION_MAX = 127;
+
+    /** @brief 权重的最大量化绝对值 */
+    static constexpr int WEIGHT_MAX = 127;
+
+    /**
+     * @brief 用校准帧量化fp32模型
+     * @param weights 每层权重，按[输入][输出]顺序（PolicyNetwork::readModel的输出）
+     * @param biases 每层偏置
+     * @param frames 标准化特征矩阵，第i帧位于frames + i*stride
+     * @param count 帧数（INT8至少1帧）
+     * @param stride 相邻帧的间隔（以float计），不小于PolicyNetwork::INPUT_DIM
+     * @param precision 目标精度
+     * @return 模型尺寸不符、步长不足或INT8没有校准帧时返回false
+     * @note 决策一致率由调用方用推理引擎测得后通过setAgreement写入
+     */
+    bool quantize(const std::vector<std::vector<float>>& weights, const std::vector<std::vector<float>>& biases,
+                  const float* frames, int count, size_t stride, Precision precision);
+
+    /**
+     * @brief 展开为fp32权重（只支持FP16）
+     * @return 未加载或精度不是FP16时返回false
+     */
+    bool toFloat(std::vector<std::vector<float>>& weights, std::vector<std::vector<float>>& biases) const;
+
+    /**
+     * @brief 写入量化模型文件
+     * @return 写入成功返回true
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief 读取量化模型文件
+     * @return 文件不存在、格式、版本或层尺寸不符时返回false并输出原因
+     */
+    bool load(const std::string& path);
+
+    bool isLoaded() const { return loaded; }
+    Precision getPrecision() const { return precision; }
+    float getAgreement() const { return agreement; }
+    void setAgreement(float rate) { agreement = rate; }
+    const Layer& getLayer(int index) const { return layers[index]; }
+
+    /** @brief 文件字节数 */
+    size_t fileSize() const;
+
+    /** @brief 精度名称（"int8"/"fp16"） */
+    static const char* precisionName(Precision precision);
+
+    /** @brief fp32转半精度（就近舍入到偶数，溢出为无穷） */
+    static uint16_t floatToHalf(float value);
+
+    /** @brief 半精度转fp32 */
+    static float halfToFloat(uint16_t value);
+
+private:
+    Precision precision = Precision::Int8;
+    float agreement = 0.0f;
+    Layer layers[PolicyNetwork::LAYERS];
+    bool loaded = false;
+};
@@ -6,75 +6,248 @@
 
 #include "RayCasting.h"
 #include "../../core/Constants.h"
+#include "../../core/Map.h"
 #include <algorithm>
+#include <limits>
 #include <set>
 
 /**
  * @brief 构造函数
- * 初始化射线投射系统，无需特殊初始化
+ * @param mode 射线遍历算法
+ * @param raysPerQuadrant 预计算方向表对应的每象限射线数量
  */
-RayCasting::RayCasting() {}
+RayCasting::RayCasting(Mode mode, int raysPerQuadrant)
+    : mode(mode),
+      tableRaysPerQuadrant(raysPerQuadrant),
+      batchCaster(raysPerQuadrant),
+      directions(buildDirections(raysPerQuadrant)) {}
+
+/**
+ * @brief 计算指定射线密度下的单位方向
+ * @param raysPerQuadrant 每个象限的射线数量
+ * @return 按象限顺序排列的单位方向向量
+ * 
+ * @details
+ * - 将360度分为4个象限，每个象限发射指定数量的射线
+ * - 射线角度在象限内均匀分布
+ */
+std::vector<sf::Vector2f> RayCasting::buildDirections(int raysPerQuadrant) {
+    std::vector<sf::Vector2f> result;
+    if (raysPerQuadrant <= 0) return result;
+    
+    // 角度计算与SimdRayCaster共用，保证两者方向逐位一致
+    const size_t count = static_cast<size_t>(raysPerQuadrant) * 4;
+    std::vector<float> dirX(count), dirY(count);
+    SimdRayCaster::buildDirections(raysPerQuadrant, dirX.data(), dirY.data());
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.emplace_back(dirX[i], dirY[i]);
+    }
+    
+    return result;
+}
 
 /**
  * @brief 从指定位置进行全方位射线检测
  * @param origin 射线起点坐标（世界坐标系）
- * @param levelData 关卡数据，二维字符数组表示地形
+ * @param grid 关卡瓦片网格
  * @param raysPerQuadrant 每个象限发射的射线数量
  * @return 返回所有射线的命中信息数组
  * 
  * @details
- * - 将360度分为4个象限，每个象限发射指定数量的射线
- * - 射线角度在象限内均匀分布
- * - 总共发射raysPerQuadrant*4条射线
+ * - 总共发射raysPerQuadrant*4条射线，方向取自预计算方向表
  * - 使用castSingleRay投射每条射线
  */
 std::vector<RayHitInfo> RayCasting::castRays(const sf::Vector2f& origin, 
-                                             const std::vector<std::string>& levelData,
+                                             const TileGrid& grid,
                                              int raysPerQuadrant) const {
     std::vector<RayHitInfo> results;
-    
+    castRays(origin, grid, results, raysPerQuadrant);
+    return results;
+}
+
+void RayCasting::castRays(const sf::Vector2f& origin, const TileGrid& grid,
+                          std::vector<RayHitInfo>& out, int raysPerQuadrant) const {
     // 空关卡直接返回空结果
-    if (levelData.empty()) return results;
-    
-    // 定义四个象限的角度范围（弧度制）
-    const float PI = 3.14159265358979323846f;
-    const float quadrantAngles[4][2] = {
-        {0, PI/2},           // 第一象限 (0-90度，右上)
-        {PI/2, PI},          // 第二象限 (90-180度，左上)
-        {PI, 3*PI/2},        // 第三象限 (180-270度，左下)
-        {3*PI/2, 2*PI}       // 第四象限 (270-360度，右下)
-    };
+    if (grid.empty()) {
+        out.clear();
+        return;
+    }
     
-    /**
-     * @brief 为每个象限发射射线
-     * 遍历4个象限，在每个象限内均匀发射指定数量的射线
-     */
-    for (int quadrant = 0; quadrant < 4; ++quadrant) {
-        float startAngle = quadrantAngles[quadrant][0];
-        float endAngle = quadrantAngles[quadrant][1];
-        
-        // 在象限内均匀分布射线角度
-        for (int i = 0; i < raysPerQuadrant; ++i) {
-            // 计算当前射线的角度（线性插值）
-            float angle = startAngle + (endAngle - startAngle) * i / (raysPerQuadrant);
-            
-            // 计算方向向量
-            sf::Vector2f direction(std::cos(angle), std::sin(angle));
-            
-            // 投射单条射线并收集结果
-            RayHitInfo hit = const_cast<RayCasting*>(this)->castSingleRay(origin, direction, levelData);
-            results.push_back(hit);
+    // DDA模式且射线密度与方向表一致时，成组投射后再组装命中信息
+    if (mode == Mode::DDA && raysPerQuadrant == tableRaysPerQuadrant) {
+        const int count = batchCaster.getRayCount();
+        float distances[256];
+        uint8_t hits[256];
+        if (count <= 256) {
+            batchCaster.cast(origin.x, origin.y, grid, distances, hits);
+            out.resize(count);
+            for (int i = 0; i < count; ++i) {
+                RayHitInfo& info = out[i];
+                info.direction = directions[i];
+                info.distance = distances[i];
+                info.hit = hits[i] != 0;
+                info.hitType = info.hit ? RayHitType::Tile : RayHitType::None;
+                info.hitPoint = origin + directions[i] * distances[i];
+            }
+            return;
         }
     }
     
-    return results;
+    // 射线密度与方向表一致时直接使用，否则临时计算（不修改成员，保证线程安全）
+    std::vector<sf::Vector2f> customDirections;
+    const std::vector<sf::Vector2f>* rayDirections = &directions;
+    if (raysPerQuadrant != tableRaysPerQuadrant) {
+        customDirections = buildDirections(raysPerQuadrant);
+        rayDirections = &customDirections;
+    }
+    
+    // 投射每条射线并收集结果
+    out.resize(rayDirections->size());
+    for (size_t i = 0; i < rayDirections->size(); ++i) {
+        out[i] = castSingleRay(origin, (*rayDirections)[i], grid);
+    }
+}
+
+std::vector<RayHitInfo> RayCasting::castRays(const sf::Vector2f& origin, const Map& map) const {
+    RayObservation observation;
+    castRays(origin, map, observation);
+    return std::move(observation.rays);
+}
+
+void RayCasting::castRays(const sf::Vector2f& origin, const Map& map, RayObservation& out) const {
+    out.origin = origin;
+    castRays(origin, map.getTileGrid(), out.rays);
+}
+
+void RayCasting::castDirections(const sf::Vector2f& origin, const sf::Vector2f* rayDirections, int count,
+                                const TileGrid& grid, RayHitInfo* out) const {
+    if (mode != Mode::DDA) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = castSingleRay(origin, rayDirections[i], grid);
+        }
+        return;
+    }
+
+    // 方向拆成SoA后成组投射，每次最多256条
+    float dirX[256], dirY[256], distances[256];
+    uint8_t hits[256];
+    for (int base = 0; base < count; base += 256) {
+        const int chunk = std::min(256, count - base);
+        for (int i = 0; i < chunk; ++i) {
+            dirX[i] = rayDirections[base + i].x;
+            dirY[i] = rayDirections[base + i].y;
+        }
+        SimdRayCaster::castDirections(origin.x, origin.y, grid, dirX, dirY, chunk, distances, hits);
+        for (int i = 0; i < chunk; ++i) {
+            RayHitInfo& info = out[base + i];
+            info.direction = rayDirections[base + i];
+            info.distance = distances[i];
+            info.hit = hits[i] != 0;
+            info.hitType = info.hit ? RayHitType::Tile : RayHitType::None;
+            info.hitPoint = origin + info.direction * distances[i];
+        }
+    }
+}
+
+void RayCasting::applyEntityHits(const sf::Vector2f& origin, const SpatialHash& entities,
+                                 std::vector<RayHitInfo>& rays) {
+    if (entities.empty()) return;
+    for (RayHitInfo& ray : rays) {
+        float distance;
+        RayHitType type;
+        if (entities.castRay(origin.x, origin.y, ray.direction.x, ray.direction.y, ray.distance, distance, type)) {
+            ray.distance = distance;
+            ray.hit = true;
+            ray.hitType = type;
+            ray.hitPoint = origin + ray.direction * distance;
+        }
+    }
 }
 
 /**
  * @brief 投射单条射线
  * @param origin 射线起点坐标
  * @param direction 射线方向向量（需标准化）
- * @param levelData 关卡数据
+ * @param grid 关卡瓦片网格
+ * @return 返回该射线的详细命中信息
+ */
+RayHitInfo RayCasting::castSingleRay(const sf::Vector2f& origin, 
+                                     const sf::Vector2f& direction,
+                                     const TileGrid& grid) const {
+    return mode == Mode::DDA ? castSingleRayDDA(origin, direction, grid)
+                             : castSingleRayStepping(origin, direction, grid);
+}
+
+/**
+ * @brief DDA网格遍历投射单条射线
+ * @param origin 射线起点坐标
+ * @param direction 射线方向向量（需标准化）
+ * @param grid 关卡瓦片网格
+ * @return 返回该射线的详细命中信息
+ * 
+ * @details
+ * Amanatides–Woo遍历：tMaxX/tMaxY为射线到达下一条竖直/水平格线的距离，
+ * 每次进入距离较近的那条格线对应的相邻格子，每个经过的格子只访问一次
+ * 150像素内最多经过约22个格子，而步进算法需要150次查询
+ * 起点所在格子为障碍物时命中距离为0，离开关卡或超过最大距离视为未命中，与步进算法一致
+ */
+RayHitInfo RayCasting::castSingleRayDDA(const sf::Vector2f& origin,
+                                        const sf::Vector2f& direction,
+                                        const TileGrid& grid) const {
+    RayHitInfo result;
+    result.direction = direction;
+    result.hit = false;
+    result.distance = MAX_DISTANCE;
+    result.hitPoint = origin + direction * MAX_DISTANCE;
+
+    const float inf = std::numeric_limits<float>::infinity();
+    int cellX = static_cast<int>(std::floor(origin.x / TILE));
+    int cellY = static_cast<int>(std::floor(origin.y / TILE));
+
+    // 每个轴上的步进方向、到达下一条格线的距离和跨越一个格子的距离
+    int stepX = direction.x > 0 ? 1 : -1;
+    int stepY = direction.y > 0 ? 1 : -1;
+    float tDeltaX = direction.x != 0 ? TILE / std::abs(direction.x) : inf;
+    float tDeltaY = direction.y != 0 ? TILE / std::abs(direction.y) : inf;
+    float tMaxX = direction.x > 0 ? ((cellX + 1) * TILE - origin.x) / direction.x
+                : direction.x < 0 ? (cellX * TILE - origin.x) / direction.x : inf;
+    float tMaxY = direction.y > 0 ? ((cellY + 1) * TILE - origin.y) / direction.y
+                : direction.y < 0 ? (cellY * TILE - origin.y) / direction.y : inf;
+
+    float distance = 0.0f;
+    while (distance < MAX_DISTANCE) {
+        if (!grid.inBounds(cellX, cellY)) {
+            break;  // 超出边界，停止检测
+        }
+        if (grid.isSolid(cellX, cellY)) {
+            result.hit = true;
+            result.hitType = RayHitType::Tile;
+            result.distance = distance;
+            result.hitPoint = origin + direction * distance;
+            break;
+        }
+
+        // 进入距离较近的相邻格子
+        if (tMaxX < tMaxY) {
+            distance = tMaxX;
+            tMaxX += tDeltaX;
+            cellX += stepX;
+        } else {
+            distance = tMaxY;
+            tMaxY += tDeltaY;
+            cellY += stepY;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief 逐像素步进投射单条射线（旧实现）
+ * @param origin 射线起点坐标
+ * @param direction 射线方向向量（需标准化）
+ * @param grid 关卡瓦片网格
  * @return 返回该射线的详细命中信息
  * 
  * @details
@@ -85,9 +258,9 @@ std::vector<RayHitInfo> RayCasting::castRays(const sf::Vector2f& origin,
  * 4. 如果命中障碍物，记录命中信息并返回
  * 5. 如果到达最大距离仍未命中，返回未命中状态
  */
-RayHitInfo RayCasting::castSingleRay(const sf::Vector2f& origin, 
-                                     const sf::Vector2f& direction,
-                                     const std::vector<std::string>& levelData) {
+RayHitInfo RayCasting::castSingleRayStepping(const sf::Vector2f& origin,
+                                             const sf::Vector2f& direction,
+                                             const TileGrid& grid) const {
     RayHitInfo result;
     result.direction = direction;
     result.hit = false;
@@ -105,15 +278,14 @@ RayHitInfo RayCasting::castSingleRay(const sf::Vector2f& origin,
         int gridY = static_cast<int>(currentPos.y / TILE);
         
         // 检查是否超出关卡边界
-        if (gridX < 0 || gridY < 0 || 
-            gridY >= static_cast<int>(levelData.size()) ||
-            gridX >= static_cast<int>(levelData[gridY].size())) {
+        if (!grid.inBounds(gridX, gridY)) {
             break;  // 超出边界，停止检测
         }
         
         // 检查当前位置是否为障碍物
-        if (isObstacle(levelData, gridX, gridY)) {
+        if (isObstacle(grid, gridX, gridY)) {
             result.hit = true;
+            result.hitType = RayHitType::Tile;
             result.hitPoint = currentPos;
             result.distance = distance;
             break;  // 命中障碍物，返回结果
@@ -131,28 +303,22 @@ RayHitInfo RayCasting::castSingleRay(const sf::Vector2f& origin,
 
 /**
  * @brief 检查指定网格坐标是否为障碍物
- * @param levelData 关卡数据，二维字符数组
+ * @param grid 关卡瓦片网格
  * @param x 网格X坐标
  * @param y 网格Y坐标
  * @return true表示该位置是障碍物，false表示可通过
  * 
  * @details
  * - 如果坐标超出关卡边界，视为障碍物（安全策略）
- * - 字符'1'表示普通障碍物
- * - 字符'M'表示特殊障碍物（如移动平台或特殊地形）
+ * - 碰撞瓦片（'1' 'W' '3' '4' 'M'）视为障碍物，直接查询碰撞位图
  */
-bool RayCasting::isObstacle(const std::vector<std::string>& levelData, int x, int y) {
+bool RayCasting::isObstacle(const TileGrid& grid, int x, int y) {
     // 检查边界：超出关卡边界视为障碍物
-    if (y < 0 || y >= static_cast<int>(levelData.size()) ||
-        x < 0 || x >= static_cast<int>(levelData[y].size())) {
+    if (!grid.inBounds(x, y)) {
         return true; // 边界外视为障碍物（安全策略）
     }
     
-    // 获取该位置的字符
-    char cell = levelData[y][x];
-    
-    // '1'表示普通障碍物，'M'表示特殊障碍物
-    return (cell == '1' || cell == 'M' || cell == 'W' || cell == '3' || cell == '4'); // 可根据需要扩展更多障碍物类型
+    return grid.isSolid(x, y);
 }
 
 /**
@@ -167,7 +333,7 @@ bool RayCasting::isObstacle(const std::vector<std::string>& levelData, int x, in
  * - 黄色半透明矩形：被射线检测到的障碍物瓦片
  * - 圆点半径为3像素，便于观察
  */
-void RayCasting::drawRays(sf::RenderWindow& window, const std::vector<RayHitInfo>& rays, const sf::Vector2f& origin) {
+void RayCasting::drawRays(sf::RenderWindow& window, const std::vector<RayHitInfo>& rays, const sf::Vector2f& origin) const {
     // 用于存储被射线命中的瓦片位置，避免重复绘制
     std::set<std::pair<int, int>> hitTiles;
     
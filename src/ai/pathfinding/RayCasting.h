@@ -5,6 +5,11 @@
 #include <vector>
 #include <cmath>
 #include "../../core/Constants.h"
+#include "../../world/TileGrid.h"
+#include "SimdRayCaster.h"
+#include "SpatialHash.h"
+
+class Map;
 
 /**
  * @brief 射线命中信息结构体
@@ -14,33 +19,123 @@ struct RayHitInfo {
     sf::Vector2f hitPoint;    // 射线命中点的坐标（世界坐标系）
     float distance;          // 从起点到命中点的距离（像素单位）
     bool hit;               // 是否命中障碍物（true=命中，false=未命中）
+    RayHitType hitType = RayHitType::None;  // 命中对象类型（瓦片/敌人/子弹/物品），放在hit后的填充字节里
     sf::Vector2f direction;  // 射线方向向量（已标准化）
 };
 
+/**
+ * @brief 一帧的射线观测
+ * @details 每个模拟步只从玩家中心投射一次，AI决策、数据采集和调试绘制共同读取；
+ * 由调用方持有并反复写入，射线数组的容量在第一帧后不再变化
+ */
+struct RayObservation {
+    sf::Vector2f origin;            // 射线起点（玩家包围盒中心）
+    std::vector<RayHitInfo> rays;   // 按象限顺序的射线命中信息
+};
+
 /**
  * @brief 射线投射系统类
  * 提供高效的射线检测功能，用于AI视觉感知、碰撞检测、路径规划等场景
  * 支持360度全方位射线投射，可配置射线密度和最大距离
+ * 默认使用DDA网格遍历（Amanatides–Woo），每条射线只访问经过的格子，返回精确命中距离；
+ * 旧的逐像素步进实现保留为Stepping模式，用于对比精度和速度
+ * 射线方向表在构造时按射线密度预先计算，castRays不再逐帧调用cos/sin；
+ * DDA模式下使用默认密度时由SimdRayCaster成组遍历（AVX2每次8条射线），结果与逐条遍历一致；
+ * 所有投射函数都是const且不修改成员，同一个实例可以被多个线程共享
  */
 class RayCasting {
 public:
+    /** @brief 单条射线的遍历算法 */
+    enum class Mode {
+        DDA,        ///< 网格遍历：每个经过的格子访问一次，距离精确
+        Stepping    ///< 旧实现：每次前进STEP_SIZE像素，距离向上取整到步长
+    };
+
+    /** @brief 默认每个象限的射线数量（共60条） */
+    static constexpr int DEFAULT_RAYS_PER_QUADRANT = 15;
+
     /**
      * @brief 构造函数
-     * 初始化射线投射系统，设置默认参数
+     * @param mode 射线遍历算法，默认DDA
+     * @param raysPerQuadrant 预计算方向表对应的每象限射线数量
      */
-    RayCasting();
+    explicit RayCasting(Mode mode = Mode::DDA, int raysPerQuadrant = DEFAULT_RAYS_PER_QUADRANT);
+
+    /** @brief 切换射线遍历算法 */
+    void setMode(Mode newMode) { mode = newMode; }
+
+    /** @brief 当前射线遍历算法 */
+    Mode getMode() const { return mode; }
     
     /**
      * @brief 从指定位置进行全方位射线检测
      * @param origin 射线起点坐标（世界坐标系）
-     * @param levelData 关卡数据，二维字符数组表示地形
-     * @param raysPerQuadrant 每个象限发射的射线数量（默认4条）
+     * @param grid 关卡瓦片网格（由Map持有）
+     * @param raysPerQuadrant 每个象限发射的射线数量（默认15条）
      * @return 返回所有射线的命中信息数组
      * @note 总共发射raysPerQuadrant*4条射线，覆盖360度范围
+     * 与构造时的射线密度相同时直接使用预计算方向表，否则临时计算方向
      */
     std::vector<RayHitInfo> castRays(const sf::Vector2f& origin, 
-                                   const std::vector<std::string>& levelData,
-                                   int raysPerQuadrant = 15) const;
+                                   const TileGrid& grid,
+                                   int raysPerQuadrant = DEFAULT_RAYS_PER_QUADRANT) const;
+
+    /**
+     * @brief 从指定位置进行全方位射线检测（投射到地图的瓦片网格）
+     * @param origin 射线起点坐标（世界坐标系）
+     * @param map 地图
+     * @return 默认射线密度下所有射线的命中信息数组
+     */
+    std::vector<RayHitInfo> castRays(const sf::Vector2f& origin, const Map& map) const;
+
+    /**
+     * @brief 投射到调用方持有的缓冲区（逻辑同castRays(origin, grid, raysPerQuadrant)）
+     * @param out 输出缓冲区，按射线数量调整大小，容量足够时不重新分配
+     */
+    void castRays(const sf::Vector2f& origin, const TileGrid& grid, std::vector<RayHitInfo>& out,
+                  int raysPerQuadrant = DEFAULT_RAYS_PER_QUADRANT) const;
+
+    /**
+     * @brief 生成一帧的射线观测（逻辑同castRays(origin, map)）
+     * @param origin 射线起点，一般为Entity::getCenter()
+     * @param map 地图
+     * @param out 输出观测，射线数组容量足够时不重新分配
+     */
+    void castRays(const sf::Vector2f& origin, const Map& map, RayObservation& out) const;
+
+    /**
+     * @brief 沿调用方给定的一组方向投射
+     * @param origin 射线起点
+     * @param directions 射线单位方向，长度count
+     * @param count 射线数量
+     * @param grid 关卡瓦片网格
+     * @param out 输出：每条射线的命中信息，长度count
+     * @note 供自定义射线布局（RayObserver）使用；DDA模式下由SimdRayCaster成组遍历
+     */
+    void castDirections(const sf::Vector2f& origin, const sf::Vector2f* directions, int count,
+                        const TileGrid& grid, RayHitInfo* out) const;
+
+    /**
+     * @brief 用动态实体截短已投射的射线
+     * @param origin 射线起点（与投射时相同）
+     * @param entities 实体空间哈希
+     * @param rays 已投射的射线（瓦片结果），实体比瓦片更近时改写距离、命中点和命中类型
+     * @details 每条射线只在实体哈希中搜索到瓦片命中距离为止，适用于任何射线布局
+     */
+    static void applyEntityHits(const sf::Vector2f& origin, const SpatialHash& entities,
+                                std::vector<RayHitInfo>& rays);
+
+    /**
+     * @brief 预计算的射线单位方向（按象限顺序，与castRays的输出顺序一致）
+     */
+    const std::vector<sf::Vector2f>& getDirections() const { return directions; }
+
+    /**
+     * @brief 计算指定射线密度下的单位方向
+     * @param raysPerQuadrant 每个象限的射线数量
+     * @return raysPerQuadrant*4个方向，第i个象限从i*90度开始均匀分布
+     */
+    static std::vector<sf::Vector2f> buildDirections(int raysPerQuadrant);
     
     /**
      * @brief 可视化射线投射结果（调试用）
@@ -49,29 +144,49 @@ public:
      * @param origin 射线起点坐标
      * @note 绿色线条表示射线，黄色圆点表示命中点
      */
-    void drawRays(sf::RenderWindow& window, const std::vector<RayHitInfo>& rays, const sf::Vector2f& origin);
+    void drawRays(sf::RenderWindow& window, const std::vector<RayHitInfo>& rays, const sf::Vector2f& origin) const;
     
 private:
     /**
      * @brief 检查指定网格坐标是否为障碍物
-     * @param levelData 关卡数据
+     * @param grid 关卡瓦片网格
      * @param x 网格X坐标
      * @param y 网格Y坐标
      * @return true表示该位置是障碍物，false表示可通过
      */
-    bool isObstacle(const std::vector<std::string>& levelData, int x, int y);
+    static bool isObstacle(const TileGrid& grid, int x, int y);
     
     /**
-     * @brief 投射单条射线
+     * @brief 投射单条射线（按当前模式选择算法）
      * @param origin 射线起点
      * @param direction 射线方向向量（需标准化）
-     * @param levelData 关卡数据
+     * @param grid 关卡瓦片网格
      * @return 返回该射线的命中信息
-     * @note 使用步进算法，逐步检测路径上的障碍物
      */
     RayHitInfo castSingleRay(const sf::Vector2f& origin, 
                            const sf::Vector2f& direction,
-                           const std::vector<std::string>& levelData);
+                           const TileGrid& grid) const;
+
+    /**
+     * @brief DDA网格遍历投射单条射线
+     * @note 依次进入射线穿过的格子，命中距离为进入碰撞格子时的精确距离
+     */
+    RayHitInfo castSingleRayDDA(const sf::Vector2f& origin,
+                                const sf::Vector2f& direction,
+                                const TileGrid& grid) const;
+
+    /**
+     * @brief 逐像素步进投射单条射线（旧实现）
+     * @note 使用步进算法，逐步检测路径上的障碍物
+     */
+    RayHitInfo castSingleRayStepping(const sf::Vector2f& origin,
+                                     const sf::Vector2f& direction,
+                                     const TileGrid& grid) const;
+
+    Mode mode;
+    int tableRaysPerQuadrant;               // 方向表对应的每象限射线数量
+    SimdRayCaster batchCaster;              // 方向表对应的批量DDA投射器
+    std::vector<sf::Vector2f> directions;   // 预计算的射线单位方向
     
     static constexpr float MAX_DISTANCE = 150.0f;  // 最大射线距离（像素单位）
     static constexpr float STEP_SIZE = 1.0f;      // 射线步长（像素单位），影响精度和性能
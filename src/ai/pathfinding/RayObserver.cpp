@@ -0,0 +1,201 @@
+// src/ai/pathfinding/RayObserver.cpp
+// 射线布局与每帧观测：均匀/自适应布局，方向固定的射线轮流重投
+#include "RayObserver.h"
+#include "../../core/Constants.h"
+#include "../../core/Map.h"
+#include "../../entity/Player.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const float PI = 3.14159265358979323846f;
+constexpr float MIN_FAN_SPEED = 1.0f;  // 速度低于该值时速度扇形朝下（重力方向）
+
+// 扇形内第i条射线相对中心方向的偏角（度）
+float fanOffset(int index, int count, float halfAngle) {
+    if (count <= 1) return 0.0f;
+    return -halfAngle + 2.0f * halfAngle * index / (count - 1);
+}
+
+std::string formatAngle(float degrees, bool withSign) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), withSign ? "%+.1f" : "%.1f", degrees);
+    return buffer;
+}
+
+}  // namespace
+
+int RayLayout::rayCount() const {
+    if (kind == Kind::Adaptive) {
+        return std::max(0, targetRays) + std::max(0, velocityRays) + std::max(0, ringRays);
+    }
+    return std::max(0, raysPerQuadrant) * 4;
+}
+
+bool RayLayout::isDefault() const {
+    return kind == Kind::Uniform && raysPerQuadrant == RayCasting::DEFAULT_RAYS_PER_QUADRANT &&
+           recastInterval <= 1;
+}
+
+bool RayLayout::matchesModelInput() const {
+    return kind == Kind::Uniform && raysPerQuadrant == RayCasting::DEFAULT_RAYS_PER_QUADRANT;
+}
+
+std::string RayLayout::describe() const {
+    std::string text;
+    if (kind == Kind::Adaptive) {
+        text = "adaptive(target=" + std::to_string(targetRays) +
+               ",velocity=" + std::to_string(velocityRays) +
+               ",fan=" + formatAngle(fanHalfAngle, false) +
+               ",ring=" + std::to_string(ringRays);
+    } else {
+        text = "uniform(perQuadrant=" + std::to_string(raysPerQuadrant);
+    }
+    return text + ",recast=" + std::to_string(std::max(1, recastInterval)) + ")";
+}
+
+std::string RayLayout::rayLabel(int index) const {
+    if (kind == Kind::Uniform) {
+        return std::to_string(index);
+    }
+    if (index < targetRays) {
+        return "t" + formatAngle(fanOffset(index, targetRays, fanHalfAngle), true);
+    }
+    index -= targetRays;
+    if (index < velocityRays) {
+        return "v" + formatAngle(fanOffset(index, velocityRays, fanHalfAngle), true);
+    }
+    index -= velocityRays;
+    return "r" + formatAngle(360.0f * index / std::max(1, ringRays), false);
+}
+
+bool RayLayout::parse(const std::string& spec, RayLayout& out) {
+    if (spec == "adaptive") {
+        out.kind = Kind::Adaptive;
+        return true;
+    }
+    if (spec == "uniform") {
+        out.kind = Kind::Uniform;
+        out.raysPerQuadrant = RayCasting::DEFAULT_RAYS_PER_QUADRANT;
+        return true;
+    }
+    const std::string prefix = "uniform:";
+    if (spec.compare(0, prefix.size(), prefix) == 0) {
+        try {
+            int perQuadrant = std::stoi(spec.substr(prefix.size()));
+            if (perQuadrant <= 0 || perQuadrant * 4 > MAX_RAYS) return false;
+            out.kind = Kind::Uniform;
+            out.raysPerQuadrant = perQuadrant;
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+    return false;
+}
+
+RayObserver::RayObserver(const RayLayout& layout) {
+    setLayout(layout);
+}
+
+void RayObserver::setLayout(const RayLayout& newLayout) {
+    layout = newLayout;
+    if (layout.kind == RayLayout::Kind::Adaptive) {
+        const int count = std::max(0, layout.ringRays);
+        fixedDirections.resize(count);
+        for (int i = 0; i < count; ++i) {
+            float angle = 2.0f * PI * i / count;
+            fixedDirections[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+    } else {
+        fixedDirections = RayCasting::buildDirections(std::max(0, layout.raysPerQuadrant));
+    }
+    fixedResults.assign(fixedDirections.size(), RayHitInfo{});
+
+    // 扇形各射线相对中心方向的旋转（cos, sin），每帧只需旋转，不再调用三角函数
+    auto buildFan = [this](int count, std::vector<sf::Vector2f>& rotations) {
+        rotations.resize(std::max(0, count));
+        for (int i = 0; i < count; ++i) {
+            float angle = fanOffset(i, count, layout.fanHalfAngle) * PI / 180.0f;
+            rotations[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+    };
+    buildFan(layout.kind == RayLayout::Kind::Adaptive ? layout.targetRays : 0, targetFan);
+    buildFan(layout.kind == RayLayout::Kind::Adaptive ? layout.velocityRays : 0, velocityFan);
+    reset();
+}
+
+void RayObserver::reset() {
+    fixedValid = false;
+    phase = 0;
+}
+
+void RayObserver::appendFan(const sf::Vector2f& center, const std::vector<sf::Vector2f>& rotations,
+                            std::vector<sf::Vector2f>& out) const {
+    const float length = std::hypot(center.x, center.y);
+    const sf::Vector2f axis = length > 0.0f ? center / length : sf::Vector2f(1.0f, 0.0f);
+    for (const sf::Vector2f& r : rotations) {
+        out.emplace_back(axis.x * r.x - axis.y * r.y, axis.x * r.y + axis.y * r.x);
+    }
+}
+
+void RayObserver::observe(const RayCasting& caster, const Player& player, const Map& map, RayObservation& out) {
+    const sf::Vector2f origin = player.getCenter();
+
+    // 默认布局：一次批量投射，与旧版本观测相同
+    if (layout.isDefault()) {
+        caster.castRays(origin, map, out);
+        lastCastCount = static_cast<int>(out.rays.size());
+    } else {
+        observeLayout(caster, player, map, origin, out);
+    }
+
+    // 实体在瓦片之前时截短射线（固定方向射线的缓存只保存瓦片结果，实体每帧重新求交）
+    if (entities) {
+        RayCasting::applyEntityHits(origin, *entities, out.rays);
+    }
+}
+
+void RayObserver::observeLayout(const RayCasting& caster, const Player& player, const Map& map,
+                                const sf::Vector2f& origin, RayObservation& out) {
+    out.origin = origin;
+    out.rays.clear();
+    lastCastCount = 0;
+    const TileGrid& grid = map.getTileGrid();
+    if (grid.empty()) return;
+
+    // 扇形方向随终点和速度变化，每帧都重新投射；方向固定的射线首帧全部投射，
+    // 之后每帧只重投下标 % interval == phase 的一份。本帧要投的方向收集到一起一次成组投射
+    pendingDirections.clear();
+    if (layout.kind == RayLayout::Kind::Adaptive) {
+        sf::Vector2f toTarget = map.getTargetPosition() + sf::Vector2f(TILE / 2.0f, TILE / 2.0f) - origin;
+        appendFan(toTarget, targetFan, pendingDirections);
+        sf::Vector2f velocity = player.getVelocity();
+        bool moving = std::hypot(velocity.x, velocity.y) >= MIN_FAN_SPEED;
+        appendFan(moving ? velocity : sf::Vector2f(0.0f, 1.0f), velocityFan, pendingDirections);
+    }
+    const size_t fanCount = pendingDirections.size();
+
+    const int interval = std::max(1, layout.recastInterval);
+    const bool full = !fixedValid || interval == 1;
+    const size_t first = full ? 0 : static_cast<size_t>(phase);
+    const size_t stride = full ? 1 : static_cast<size_t>(interval);
+    for (size_t i = first; i < fixedDirections.size(); i += stride) {
+        pendingDirections.push_back(fixedDirections[i]);
+    }
+
+    pendingResults.resize(pendingDirections.size());
+    caster.castDirections(origin, pendingDirections.data(), static_cast<int>(pendingDirections.size()),
+                          grid, pendingResults.data());
+    lastCastCount = static_cast<int>(pendingDirections.size());
+
+    for (size_t k = fanCount; k < pendingResults.size(); ++k) {
+        fixedResults[first + (k - fanCount) * stride] = pendingResults[k];
+    }
+    out.rays.assign(pendingResults.begin(), pendingResults.begin() + fanCount);
+    phase = full ? 0 : (phase + 1) % interval;
+    fixedValid = true;
+    out.rays.insert(out.rays.end(), fixedResults.begin(), fixedResults.end());
+}
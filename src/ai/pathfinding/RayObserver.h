@@ -0,0 +1,126 @@
+// src/ai/pathfinding/RayObserver.h
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "RayCasting.h"
+
+class Player;
+class Map;
+
+/**
+ * @brief 射线布局配置
+ * @details 决定每帧观测包含哪些射线以及按什么顺序排列（即特征中射线部分的布局）
+ * - Uniform：raysPerQuadrant*4条均匀分布的射线（默认15，共60条，与旧版本特征一致）
+ * - Adaptive：朝向终点的密集扇形 + 沿速度方向的密集扇形 + 稀疏的均匀环形射线，
+ *   扇形角度相对于终点/速度方向，环形射线方向固定
+ * 方向固定的射线（Uniform的全部射线、Adaptive的环形射线）可以轮流重投：
+ * recastInterval为k时每帧只投射其中1/k，其余沿用上次的结果
+ */
+struct RayLayout {
+    /** @brief 每帧观测的最大射线数（默认布局的60条），特征行因此固定为10 + 2*60 = 130个float */
+    static constexpr int MAX_RAYS = 60;
+
+    enum class Kind {
+        Uniform,    ///< 均匀分布
+        Adaptive    ///< 终点/速度方向密集，其余方向稀疏
+    };
+
+    Kind kind = Kind::Uniform;
+    int raysPerQuadrant = RayCasting::DEFAULT_RAYS_PER_QUADRANT;  ///< Uniform：每象限射线数
+    int targetRays = 8;         ///< Adaptive：朝向终点的扇形射线数
+    int velocityRays = 8;       ///< Adaptive：沿速度方向的扇形射线数（几乎静止时朝下）
+    float fanHalfAngle = 45.0f; ///< Adaptive：扇形半角（度）
+    int ringRays = 16;          ///< Adaptive：均匀环形射线数
+    int recastInterval = 1;     ///< 方向固定的射线每隔几帧重投一次（1表示每帧全部重投）
+
+    /** @brief 每帧观测的射线总数 */
+    int rayCount() const;
+
+    /** @brief 是否为默认布局（每象限15条均匀射线、每帧全部重投），默认布局走批量投射快速路径 */
+    bool isDefault() const;
+
+    /**
+     * @brief 射线特征是否与默认布局的列含义相同（每象限15条均匀射线，重投间隔不改变列的含义）
+     * @details 训练脚本、quantize_model和AIController都按FeatureSchema::FEATURE_COUNT列的默认布局读写模型输入，
+     * 其他布局只能用于采集数据，不能交给已训练的模型
+     */
+    bool matchesModelInput() const;
+
+    /** @brief 可读的布局描述（日志用），如 "adaptive(target=8,velocity=8,fan=45,ring=16,recast=2)" */
+    std::string describe() const;
+
+    /**
+     * @brief 第i条射线的列名后缀，数据集表头为 ray_dist_<后缀> / ray_hit_<后缀>
+     * @details 默认布局为下标（与旧数据集相同）；其余布局带上分组和角度，
+     * 如 "t-45.0"（终点扇形，相对终点方向-45度）、"v+12.9"（速度扇形）、"r90.0"（环形，世界角度）
+     * 表头因此完整记录了射线特征的布局
+     */
+    std::string rayLabel(int index) const;
+
+    /**
+     * @brief 解析命令行写法
+     * @param spec "uniform"、"uniform:<每象限射线数>" 或 "adaptive"
+     * @param out 解析结果（只修改kind和raysPerQuadrant）
+     * @return 无法识别或射线总数超过MAX_RAYS时返回false
+     */
+    static bool parse(const std::string& spec, RayLayout& out);
+};
+
+/**
+ * @brief 按射线布局生成每帧观测（每个智能体一个实例）
+ * @details 保存轮流重投的进度和方向固定射线的上次结果，因此不能在智能体之间共享；
+ * 投射本身由传入的RayCasting完成（只读，可共享）
+ */
+class RayObserver {
+public:
+    explicit RayObserver(const RayLayout& layout = RayLayout());
+
+    /** @brief 更换布局（清空缓存） */
+    void setLayout(const RayLayout& newLayout);
+    const RayLayout& getLayout() const { return layout; }
+
+    /**
+     * @brief 设置动态实体哈希（nullptr表示只检测瓦片）
+     * @details 设置后每帧观测的射线还会被更近的实体截短，RayHitInfo::hitType报告命中类型；
+     * 哈希由调用方持有并在每帧更新
+     */
+    void setEntities(const SpatialHash* hash) { entities = hash; }
+
+    /** @brief 新回合或玩家位置跳变时调用，下一次observe()重新投射全部射线 */
+    void reset();
+
+    /**
+     * @brief 生成本帧观测
+     * @param caster 射线检测器
+     * @param player 玩家（起点为包围盒中心，速度决定速度扇形的方向）
+     * @param map 地图（终点决定终点扇形的方向）
+     * @param out 输出观测，射线顺序为布局顺序
+     */
+    void observe(const RayCasting& caster, const Player& player, const Map& map, RayObservation& out);
+
+    /** @brief 上一次observe()实际投射的射线数 */
+    int getLastCastCount() const { return lastCastCount; }
+
+private:
+    /** @brief 按非默认布局投射瓦片射线 */
+    void observeLayout(const RayCasting& caster, const Player& player, const Map& map,
+                       const sf::Vector2f& origin, RayObservation& out);
+
+    /** @brief 把预计算的扇形旋转作用到中心方向上，追加一组扇形方向 */
+    void appendFan(const sf::Vector2f& center, const std::vector<sf::Vector2f>& rotations,
+                   std::vector<sf::Vector2f>& out) const;
+
+    RayLayout layout;
+    const SpatialHash* entities = nullptr;
+    std::vector<sf::Vector2f> fixedDirections;  // 方向固定的射线（Uniform全部 / Adaptive环形）
+    std::vector<RayHitInfo> fixedResults;       // 方向固定射线的最近一次结果
+    std::vector<sf::Vector2f> targetFan;        // 终点扇形各射线相对中心方向的旋转(cos, sin)
+    std::vector<sf::Vector2f> velocityFan;      // 速度扇形各射线相对中心方向的旋转
+    std::vector<sf::Vector2f> pendingDirections;  // 本帧要投射的方向：扇形 + 轮到的固定方向（复用容量）
+    std::vector<RayHitInfo> pendingResults;
+    bool fixedValid = false;
+    int phase = 0;
+    int lastCastCount = 0;
+};
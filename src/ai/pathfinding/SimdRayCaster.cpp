@@ -0,0 +1,492 @@
+// src/ai/pathfinding/SimdRayCaster.cpp
+// 批量DDA射线投射：AVX2 / SSE2 / 标量三种实现
+#include "SimdRayCaster.h"
+#include "../../core/Constants.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_RAYCASTER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_RAYCASTER_SSE2 1
+#endif
+
+namespace {
+
+constexpr int LANES = 8;
+constexpr int PADDING = 2 * LANES;  // AVX2实现每次交错处理两组
+constexpr int MIN_ORIGINS_PER_THREAD = 64;  // 每个线程至少分到的起点数，避免线程启动开销超过投射本身
+const float INF = std::numeric_limits<float>::infinity();
+
+// 到达下一条格线的射线长度（方向分量为0时为无穷大）
+inline float firstBoundary(int cell, float origin, float direction) {
+    if (direction > 0) return ((cell + 1) * TILE - origin) / direction;
+    if (direction < 0) return (cell * TILE - origin) / direction;
+    return INF;
+}
+
+}  // namespace
+
+SimdRayCaster::SimdRayCaster(int raysPerQuadrant)
+    : rayCount(std::max(0, raysPerQuadrant) * 4) {
+    const size_t padded = (static_cast<size_t>(rayCount) + PADDING - 1) / PADDING * PADDING;
+    dirX.assign(padded, 1.0f);
+    dirY.assign(padded, 0.0f);
+    buildDirections(raysPerQuadrant, dirX.data(), dirY.data());
+
+    deltaX.resize(padded);
+    deltaY.resize(padded);
+    stepX.resize(padded);
+    stepY.resize(padded);
+    for (size_t i = 0; i < padded; ++i) {
+        deltaX[i] = dirX[i] != 0 ? TILE / std::abs(dirX[i]) : INF;
+        deltaY[i] = dirY[i] != 0 ? TILE / std::abs(dirY[i]) : INF;
+        stepX[i] = dirX[i] > 0 ? 1 : -1;
+        stepY[i] = dirY[i] > 0 ? 1 : -1;
+    }
+}
+
+void SimdRayCaster::buildDirections(int raysPerQuadrant, float* outX, float* outY) {
+    // 定义四个象限的角度范围（弧度制）
+    const float PI = 3.14159265358979323846f;
+    const float quadrantAngles[4][2] = {
+        {0, PI/2},           // 第一象限 (0-90度，右上)
+        {PI/2, PI},          // 第二象限 (90-180度，左上)
+        {PI, 3*PI/2},        // 第三象限 (180-270度，左下)
+        {3*PI/2, 2*PI}       // 第四象限 (270-360度，右下)
+    };
+
+    int index = 0;
+    for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        float startAngle = quadrantAngles[quadrant][0];
+        float endAngle = quadrantAngles[quadrant][1];
+        for (int i = 0; i < raysPerQuadrant; ++i) {
+            float angle = startAngle + (endAngle - startAngle) * i / (raysPerQuadrant);
+            outX[index] = std::cos(angle);
+            outY[index] = std::sin(angle);
+            ++index;
+        }
+    }
+}
+
+bool SimdRayCaster::castBatch(const float* originsX, const float* originsY, int count,
+                              const TileGrid* const* grids, float* distances, size_t distanceStride,
+                              uint64_t* hitMasks, int threads) const {
+    return dispatchBatch(originsX, originsY, count, grids, 1, distances, distanceStride, hitMasks, threads);
+}
+
+bool SimdRayCaster::castBatch(const float* originsX, const float* originsY, int count,
+                              const TileGrid& grid, float* distances, size_t distanceStride,
+                              uint64_t* hitMasks, int threads) const {
+    const TileGrid* shared = &grid;
+    return dispatchBatch(originsX, originsY, count, &shared, 0, distances, distanceStride, hitMasks, threads);
+}
+
+bool SimdRayCaster::dispatchBatch(const float* originsX, const float* originsY, int count,
+                                  const TileGrid* const* grids, size_t gridStride,
+                                  float* distances, size_t distanceStride, uint64_t* hitMasks,
+                                  int threads) const {
+    if (rayCount > MAX_MASK_RAYS) {
+        std::cerr << "[RAYCAST] Batch cast supports at most " << MAX_MASK_RAYS
+                  << " rays per origin, got " << rayCount << std::endl;
+        return false;
+    }
+    if (distanceStride < static_cast<size_t>(rayCount)) {
+        std::cerr << "[RAYCAST] Distance stride " << distanceStride
+                  << " is smaller than ray count " << rayCount << std::endl;
+        return false;
+    }
+    if (count <= 0) return true;
+
+    // 起点按连续区间分给各线程，每个线程写互不重叠的输出行
+    threads = std::max(1, std::min(threads, (count + MIN_ORIGINS_PER_THREAD - 1) / MIN_ORIGINS_PER_THREAD));
+    if (threads == 1) {
+        castRange(originsX, originsY, 0, count, grids, gridStride, distances, distanceStride, hitMasks);
+        return true;
+    }
+    std::vector<std::thread> pool;
+    const int chunk = (count + threads - 1) / threads;
+    for (int begin = 0; begin < count; begin += chunk) {
+        const int end = std::min(count, begin + chunk);
+        pool.emplace_back([this, originsX, originsY, begin, end, grids, gridStride,
+                           distances, distanceStride, hitMasks]() {
+            castRange(originsX, originsY, begin, end, grids, gridStride, distances, distanceStride, hitMasks);
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return true;
+}
+
+void SimdRayCaster::castRange(const float* originsX, const float* originsY, int begin, int end,
+                              const TileGrid* const* grids, size_t gridStride,
+                              float* distances, size_t distanceStride, uint64_t* hitMasks) const {
+    uint8_t hits[MAX_MASK_RAYS];
+    for (int i = begin; i < end; ++i) {
+        // 距离直接写进输出行，命中标志压缩为64位掩码
+        cast(originsX[i], originsY[i], *grids[i * gridStride], distances + i * distanceStride, hits);
+        uint64_t mask = 0;
+        for (int r = 0; r < rayCount; ++r) {
+            mask |= static_cast<uint64_t>(hits[r]) << r;
+        }
+        hitMasks[i] = mask;
+    }
+}
+
+const char* SimdRayCaster::instructionSet() {
+#if defined(SIMD_RAYCASTER_AVX2)
+    return "AVX2";
+#elif defined(SIMD_RAYCASTER_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+void SimdRayCaster::castScalar(float originX, float originY, const TileGrid& grid,
+                               float* distances, uint8_t* hits) const {
+    castTablesScalar(originX, originY, grid, memberTables(), distances, hits);
+}
+
+void SimdRayCaster::castDirections(float originX, float originY, const TileGrid& grid,
+                                   const float* directionsX, const float* directionsY, int count,
+                                   float* distances, uint8_t* hits) {
+    // 方向不固定时在栈上临时计算遍历参数，超过一块的方向分块投射
+    constexpr int CHUNK = 256;
+    alignas(32) float chunkDirX[CHUNK], chunkDirY[CHUNK], chunkDeltaX[CHUNK], chunkDeltaY[CHUNK];
+    alignas(32) int32_t chunkStepX[CHUNK], chunkStepY[CHUNK];
+
+    for (int begin = 0; begin < count; begin += CHUNK) {
+        const int n = std::min(CHUNK, count - begin);
+        const int padded = (n + PADDING - 1) / PADDING * PADDING;
+        for (int i = 0; i < padded; ++i) {
+            chunkDirX[i] = i < n ? directionsX[begin + i] : 1.0f;
+            chunkDirY[i] = i < n ? directionsY[begin + i] : 0.0f;
+            chunkDeltaX[i] = chunkDirX[i] != 0 ? TILE / std::abs(chunkDirX[i]) : INF;
+            chunkDeltaY[i] = chunkDirY[i] != 0 ? TILE / std::abs(chunkDirY[i]) : INF;
+            chunkStepX[i] = chunkDirX[i] > 0 ? 1 : -1;
+            chunkStepY[i] = chunkDirY[i] > 0 ? 1 : -1;
+        }
+        DirectionTables tables{chunkDirX, chunkDirY, chunkDeltaX, chunkDeltaY, chunkStepX, chunkStepY, n};
+        castTables(originX, originY, grid, tables, distances + begin, hits + begin);
+    }
+}
+
+SimdRayCaster::DirectionTables SimdRayCaster::memberTables() const {
+    return DirectionTables{dirX.data(), dirY.data(), deltaX.data(), deltaY.data(),
+                           stepX.data(), stepY.data(), rayCount};
+}
+
+void SimdRayCaster::cast(float originX, float originY, const TileGrid& grid,
+                         float* distances, uint8_t* hits) const {
+    castTables(originX, originY, grid, memberTables(), distances, hits);
+}
+
+void SimdRayCaster::castTablesScalar(float originX, float originY, const TileGrid& grid,
+                                     const DirectionTables& t, float* distances, uint8_t* hits) {
+    const int originCellX = static_cast<int>(std::floor(originX / TILE));
+    const int originCellY = static_cast<int>(std::floor(originY / TILE));
+
+    for (int i = 0; i < t.count; ++i) {
+        int cellX = originCellX;
+        int cellY = originCellY;
+        float tMaxX = firstBoundary(cellX, originX, t.dirX[i]);
+        float tMaxY = firstBoundary(cellY, originY, t.dirY[i]);
+        float distance = 0.0f;
+
+        distances[i] = MAX_DISTANCE;
+        hits[i] = 0;
+        while (distance < MAX_DISTANCE && grid.inBounds(cellX, cellY)) {
+            if (grid.isSolid(cellX, cellY)) {
+                distances[i] = distance;
+                hits[i] = 1;
+                break;
+            }
+            if (tMaxX < tMaxY) {
+                distance = tMaxX;
+                tMaxX += t.deltaX[i];
+                cellX += t.stepX[i];
+            } else {
+                distance = tMaxY;
+                tMaxY += t.deltaY[i];
+                cellY += t.stepY[i];
+            }
+        }
+    }
+}
+
+#if defined(SIMD_RAYCASTER_AVX2)
+
+namespace {
+
+// 一组8条射线的遍历状态
+struct RayGroup {
+    __m256 tMaxX, tMaxY, tDeltaX, tDeltaY;
+    __m256 distance, result;
+    __m256i cellX, cellY, rowOffset;    // rowOffset = cellY * 每行32位字数
+    __m256i stepX, stepY, stepRow;
+    __m256i hitMask, active;
+};
+
+// 遍历所需的关卡常量
+struct GridConstants {
+    const int* bitmap;
+    __m256i words32PerRow, width, height;
+    __m256i minusOne, one, bitIndexMask;
+    __m256 maxDistance, inf, zero;
+    __m256 nextBoundaryX, prevBoundaryX, nextBoundaryY, prevBoundaryY;
+};
+
+inline void initGroup(RayGroup& g, const GridConstants& c, int originCellX, int originCellY,
+                      const float* dirX, const float* dirY, const float* deltaX, const float* deltaY,
+                      const int32_t* stepX, const int32_t* stepY) {
+    const __m256 dx = _mm256_loadu_ps(dirX);
+    const __m256 dy = _mm256_loadu_ps(dirY);
+    g.tDeltaX = _mm256_loadu_ps(deltaX);
+    g.tDeltaY = _mm256_loadu_ps(deltaY);
+    g.stepX = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stepX));
+    g.stepY = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stepY));
+    g.stepRow = _mm256_mullo_epi32(g.stepY, c.words32PerRow);
+
+    // tMax：方向为正取下一条格线，为负取上一条格线，为0时无穷大
+    g.tMaxX = _mm256_div_ps(_mm256_blendv_ps(c.prevBoundaryX, c.nextBoundaryX, _mm256_cmp_ps(dx, c.zero, _CMP_GT_OQ)), dx);
+    g.tMaxY = _mm256_div_ps(_mm256_blendv_ps(c.prevBoundaryY, c.nextBoundaryY, _mm256_cmp_ps(dy, c.zero, _CMP_GT_OQ)), dy);
+    g.tMaxX = _mm256_blendv_ps(g.tMaxX, c.inf, _mm256_cmp_ps(dx, c.zero, _CMP_EQ_OQ));
+    g.tMaxY = _mm256_blendv_ps(g.tMaxY, c.inf, _mm256_cmp_ps(dy, c.zero, _CMP_EQ_OQ));
+
+    g.cellX = _mm256_set1_epi32(originCellX);
+    g.cellY = _mm256_set1_epi32(originCellY);
+    g.rowOffset = _mm256_mullo_epi32(g.cellY, c.words32PerRow);
+    g.distance = c.zero;
+    g.result = c.maxDistance;
+    g.hitMask = _mm256_setzero_si256();
+    g.active = c.minusOne;
+}
+
+// 推进一步：检查当前格子，未命中的射线进入下一个格子；返回是否仍有活动射线
+inline bool advanceGroup(RayGroup& g, const GridConstants& c) {
+    // 未超过最大距离且仍在关卡内的射线继续遍历
+    __m256i inRange = _mm256_castps_si256(_mm256_cmp_ps(g.distance, c.maxDistance, _CMP_LT_OQ));
+    __m256i inBounds = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpgt_epi32(g.cellX, c.minusOne), _mm256_cmpgt_epi32(c.width, g.cellX)),
+        _mm256_and_si256(_mm256_cmpgt_epi32(g.cellY, c.minusOne), _mm256_cmpgt_epi32(c.height, g.cellY)));
+    g.active = _mm256_and_si256(g.active, _mm256_and_si256(inRange, inBounds));
+    if (_mm256_testz_si256(g.active, g.active)) return false;
+
+    // 位图查询：只对活动通道gather，越界通道不访问内存
+    __m256i wordIndex = _mm256_add_epi32(g.rowOffset, _mm256_srli_epi32(g.cellX, 5));
+    __m256i words = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), c.bitmap, wordIndex, g.active, 4);
+    __m256i bits = _mm256_and_si256(_mm256_srlv_epi32(words, _mm256_and_si256(g.cellX, c.bitIndexMask)), c.one);
+    __m256i solid = _mm256_and_si256(_mm256_cmpeq_epi32(bits, c.one), g.active);
+
+    g.result = _mm256_blendv_ps(g.result, g.distance, _mm256_castsi256_ps(solid));
+    g.hitMask = _mm256_or_si256(g.hitMask, solid);
+    g.active = _mm256_andnot_si256(solid, g.active);
+
+    // 进入距离较近的相邻格子
+    __m256 stepAlongX = _mm256_cmp_ps(g.tMaxX, g.tMaxY, _CMP_LT_OQ);
+    __m256i stepAlongXi = _mm256_castps_si256(stepAlongX);
+    g.distance = _mm256_blendv_ps(g.tMaxY, g.tMaxX, stepAlongX);
+    g.tMaxX = _mm256_blendv_ps(g.tMaxX, _mm256_add_ps(g.tMaxX, g.tDeltaX), stepAlongX);
+    g.tMaxY = _mm256_blendv_ps(_mm256_add_ps(g.tMaxY, g.tDeltaY), g.tMaxY, stepAlongX);
+    g.cellX = _mm256_add_epi32(g.cellX, _mm256_and_si256(g.stepX, stepAlongXi));
+    g.cellY = _mm256_add_epi32(g.cellY, _mm256_andnot_si256(stepAlongXi, g.stepY));
+    g.rowOffset = _mm256_add_epi32(g.rowOffset, _mm256_andnot_si256(stepAlongXi, g.stepRow));
+    return true;
+}
+
+inline void storeGroup(const RayGroup& g, int base, int rayCount, float* distances, uint8_t* hits) {
+    alignas(32) float laneDistances[LANES];
+    alignas(32) int laneHits[LANES];
+    _mm256_store_ps(laneDistances, g.result);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneHits), g.hitMask);
+    const int count = std::min(LANES, rayCount - base);
+    for (int lane = 0; lane < count; ++lane) {
+        distances[base + lane] = laneDistances[lane];
+        hits[base + lane] = laneHits[lane] != 0 ? 1 : 0;
+    }
+}
+
+}  // namespace
+
+void SimdRayCaster::castTables(float originX, float originY, const TileGrid& grid,
+                               const DirectionTables& t, float* distances, uint8_t* hits) {
+    if (grid.empty()) {
+        std::fill(distances, distances + t.count, MAX_DISTANCE);
+        std::fill(hits, hits + t.count, 0);
+        return;
+    }
+
+    const int originCellX = static_cast<int>(std::floor(originX / TILE));
+    const int originCellY = static_cast<int>(std::floor(originY / TILE));
+
+    GridConstants c;
+    // 碰撞位图按32位字访问：64位字w的低/高32位分别是32位字2w/2w+1（小端序）
+    c.bitmap = reinterpret_cast<const int*>(grid.solidRow(0));
+    c.words32PerRow = _mm256_set1_epi32(grid.getWordsPerRow() * 2);
+    c.width = _mm256_set1_epi32(grid.getWidth());
+    c.height = _mm256_set1_epi32(grid.getHeight());
+    c.minusOne = _mm256_set1_epi32(-1);
+    c.one = _mm256_set1_epi32(1);
+    c.bitIndexMask = _mm256_set1_epi32(31);
+    c.maxDistance = _mm256_set1_ps(MAX_DISTANCE);
+    c.inf = _mm256_set1_ps(INF);
+    c.zero = _mm256_setzero_ps();
+
+    // 起点所在格子的边界（所有射线共用）
+    c.nextBoundaryX = _mm256_set1_ps((originCellX + 1) * TILE - originX);
+    c.prevBoundaryX = _mm256_set1_ps(originCellX * TILE - originX);
+    c.nextBoundaryY = _mm256_set1_ps((originCellY + 1) * TILE - originY);
+    c.prevBoundaryY = _mm256_set1_ps(originCellY * TILE - originY);
+
+    // 两组射线交错推进，隐藏gather和比较链的延迟
+    for (int base = 0; base < t.count; base += 2 * LANES) {
+        const int second = base + LANES;
+        RayGroup a, b;
+        initGroup(a, c, originCellX, originCellY, t.dirX + base, t.dirY + base,
+                  t.deltaX + base, t.deltaY + base, t.stepX + base, t.stepY + base);
+        initGroup(b, c, originCellX, originCellY, t.dirX + second, t.dirY + second,
+                  t.deltaX + second, t.deltaY + second, t.stepX + second, t.stepY + second);
+
+        bool aActive = true, bActive = true;
+        while (aActive | bActive) {
+            if (aActive) aActive = advanceGroup(a, c);
+            if (bActive) bActive = advanceGroup(b, c);
+        }
+
+        storeGroup(a, base, t.count, distances, hits);
+        if (second < t.count) {
+            storeGroup(b, second, t.count, distances, hits);
+        }
+    }
+}
+
+#elif defined(SIMD_RAYCASTER_SSE2)
+
+namespace {
+
+inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// 每个通道的 1 << n（n为0..31）：SSE2没有逐通道变长移位，把n写进float的指数位再截断为整数，
+// n为31时截断结果为0x80000000，恰好也是1 << 31
+inline __m128i powerOfTwo(__m128i n) {
+    return _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23)));
+}
+
+}  // namespace
+
+void SimdRayCaster::castTables(float originX, float originY, const TileGrid& grid,
+                               const DirectionTables& t, float* distances, uint8_t* hits) {
+    if (grid.empty()) {
+        std::fill(distances, distances + t.count, MAX_DISTANCE);
+        std::fill(hits, hits + t.count, 0);
+        return;
+    }
+
+    constexpr int SSE_LANES = 4;
+    const int originCellX = static_cast<int>(std::floor(originX / TILE));
+    const int originCellY = static_cast<int>(std::floor(originY / TILE));
+
+    // 碰撞位图按32位字访问，与AVX2实现相同
+    const int* bitmap = reinterpret_cast<const int*>(grid.solidRow(0));
+    const int words32PerRow = grid.getWordsPerRow() * 2;
+    const __m128i rowWords = _mm_set1_epi32(words32PerRow);
+    const __m128i width = _mm_set1_epi32(grid.getWidth());
+    const __m128i height = _mm_set1_epi32(grid.getHeight());
+    const __m128i minusOne = _mm_set1_epi32(-1);
+    const __m128i bitIndexMask = _mm_set1_epi32(31);
+    const __m128i zeroi = _mm_setzero_si128();
+    const __m128 maxDistance = _mm_set1_ps(MAX_DISTANCE);
+    const __m128 inf = _mm_set1_ps(INF);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 nextBoundaryX = _mm_set1_ps((originCellX + 1) * TILE - originX);
+    const __m128 prevBoundaryX = _mm_set1_ps(originCellX * TILE - originX);
+    const __m128 nextBoundaryY = _mm_set1_ps((originCellY + 1) * TILE - originY);
+    const __m128 prevBoundaryY = _mm_set1_ps(originCellY * TILE - originY);
+
+    alignas(16) int laneWordIndex[SSE_LANES];
+    alignas(16) float laneDistances[SSE_LANES];
+
+    for (int base = 0; base < t.count; base += SSE_LANES) {
+        const __m128 dx = _mm_loadu_ps(t.dirX + base);
+        const __m128 dy = _mm_loadu_ps(t.dirY + base);
+        const __m128 tDeltaX = _mm_loadu_ps(t.deltaX + base);
+        const __m128 tDeltaY = _mm_loadu_ps(t.deltaY + base);
+        const __m128i stepXs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.stepX + base));
+        const __m128i stepYs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.stepY + base));
+        // 步进为±1，每行字数按符号取反即为行偏移的步进（SSE2没有32位乘法）
+        const __m128i stepSign = _mm_srai_epi32(stepYs, 31);
+        const __m128i stepRow = _mm_sub_epi32(_mm_xor_si128(rowWords, stepSign), stepSign);
+
+        __m128 tMaxX = _mm_div_ps(select(_mm_cmpgt_ps(dx, zero), nextBoundaryX, prevBoundaryX), dx);
+        __m128 tMaxY = _mm_div_ps(select(_mm_cmpgt_ps(dy, zero), nextBoundaryY, prevBoundaryY), dy);
+        tMaxX = select(_mm_cmpeq_ps(dx, zero), inf, tMaxX);
+        tMaxY = select(_mm_cmpeq_ps(dy, zero), inf, tMaxY);
+
+        __m128i cellX = _mm_set1_epi32(originCellX);
+        __m128i cellY = _mm_set1_epi32(originCellY);
+        __m128i rowOffset = _mm_set1_epi32(originCellY * words32PerRow);
+        __m128 distance = zero;
+        __m128 result = maxDistance;
+        __m128i hitMask = zeroi;
+        __m128i active = minusOne;
+
+        for (;;) {
+            // 未超过最大距离且仍在关卡内的射线继续遍历
+            __m128i inRange = _mm_castps_si128(_mm_cmplt_ps(distance, maxDistance));
+            __m128i inBounds = _mm_and_si128(
+                _mm_and_si128(_mm_cmpgt_epi32(cellX, minusOne), _mm_cmpgt_epi32(width, cellX)),
+                _mm_and_si128(_mm_cmpgt_epi32(cellY, minusOne), _mm_cmpgt_epi32(height, cellY)));
+            active = _mm_and_si128(active, _mm_and_si128(inRange, inBounds));
+            if (_mm_movemask_epi8(active) == 0) break;
+
+            // 位图查询：下标和位掩码按向量计算，只有读取4个字是逐通道的（SSE2没有gather），
+            // 非活动通道的下标置0，读取的字不参与结果
+            __m128i wordIndex = _mm_and_si128(_mm_add_epi32(rowOffset, _mm_srai_epi32(cellX, 5)), active);
+            _mm_store_si128(reinterpret_cast<__m128i*>(laneWordIndex), wordIndex);
+            __m128i words = _mm_set_epi32(bitmap[laneWordIndex[3]], bitmap[laneWordIndex[2]],
+                                          bitmap[laneWordIndex[1]], bitmap[laneWordIndex[0]]);
+            __m128i bit = powerOfTwo(_mm_and_si128(cellX, bitIndexMask));
+            __m128i solid = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(words, bit), zeroi), active);
+
+            result = select(_mm_castsi128_ps(solid), distance, result);
+            hitMask = _mm_or_si128(hitMask, solid);
+            active = _mm_andnot_si128(solid, active);
+
+            // 进入距离较近的相邻格子
+            __m128 stepAlongX = _mm_cmplt_ps(tMaxX, tMaxY);
+            __m128i stepAlongXi = _mm_castps_si128(stepAlongX);
+            distance = select(stepAlongX, tMaxX, tMaxY);
+            tMaxX = select(stepAlongX, _mm_add_ps(tMaxX, tDeltaX), tMaxX);
+            tMaxY = select(stepAlongX, tMaxY, _mm_add_ps(tMaxY, tDeltaY));
+            cellX = _mm_add_epi32(cellX, _mm_and_si128(stepXs, stepAlongXi));
+            cellY = _mm_add_epi32(cellY, _mm_andnot_si128(stepAlongXi, stepYs));
+            rowOffset = _mm_add_epi32(rowOffset, _mm_andnot_si128(stepAlongXi, stepRow));
+        }
+
+        _mm_store_ps(laneDistances, result);
+        const int mask = _mm_movemask_ps(_mm_castsi128_ps(hitMask));
+        const int count = std::min(SSE_LANES, t.count - base);
+        for (int lane = 0; lane < count; ++lane) {
+            distances[base + lane] = laneDistances[lane];
+            hits[base + lane] = (mask >> lane) & 1;
+        }
+    }
+}
+
+#else
+
+void SimdRayCaster::castTables(float originX, float originY, const TileGrid& grid,
+                               const DirectionTables& t, float* distances, uint8_t* hits) {
+    castTablesScalar(originX, originY, grid, t, distances, hits);
+}
+
+#endif
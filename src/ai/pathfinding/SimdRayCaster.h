@@ -0,0 +1,157 @@
+// src/ai/pathfinding/SimdRayCaster.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../../world/TileGrid.h"
+
+/**
+ * @file SimdRayCaster.h
+ * @brief 批量DDA射线投射（不依赖SFML）
+ * @details 同一起点发出的所有射线按8条一组同步推进网格遍历（Amanatides–Woo），
+ * 每一步用TileGrid的碰撞位图判断占用，结果以结构体数组（SoA）形式写出：距离数组 + 命中标志数组
+ * 指令集在编译期选择：
+ * - AVX2：8条射线一组、两组交错推进，位图按32位字gather读取，变长移位取出占用位
+ * - SSE2：4条射线一组，越界判断、字下标和位掩码按向量计算，只有读取位图字是逐通道的（没有gather）
+ * - 标量：逐条射线遍历（非x86平台）
+ * 三种实现的浮点运算顺序相同，结果与RayCasting的DDA模式逐位一致
+ */
+class SimdRayCaster {
+public:
+    /** @brief 最大射线距离（像素），与RayCasting一致 */
+    static constexpr float MAX_DISTANCE = 150.0f;
+
+    /**
+     * @brief 构造函数
+     * @param raysPerQuadrant 每个象限的射线数量，共raysPerQuadrant*4条射线
+     */
+    explicit SimdRayCaster(int raysPerQuadrant = 15);
+
+    /** @brief 射线数量 */
+    int getRayCount() const { return rayCount; }
+
+    /** @brief 射线方向X分量（长度getRayCount()，按象限顺序） */
+    const float* getDirectionsX() const { return dirX.data(); }
+
+    /** @brief 射线方向Y分量（长度getRayCount()，按象限顺序） */
+    const float* getDirectionsY() const { return dirY.data(); }
+
+    /**
+     * @brief 从一点投射全部射线
+     * @param originX 起点X坐标（像素）
+     * @param originY 起点Y坐标（像素）
+     * @param grid 关卡瓦片网格
+     * @param distances 输出：每条射线的命中距离，未命中为MAX_DISTANCE，长度getRayCount()
+     * @param hits 输出：每条射线是否命中（0/1），长度getRayCount()
+     * @note 只读取成员，可在多个线程中共享同一实例
+     */
+    void cast(float originX, float originY, const TileGrid& grid, float* distances, uint8_t* hits) const;
+
+    /**
+     * @brief 标量参考实现（逐条射线遍历），用于校验和对比
+     * @param originX 起点X坐标（像素）
+     * @param originY 起点Y坐标（像素）
+     * @param grid 关卡瓦片网格
+     * @param distances 输出：每条射线的命中距离
+     * @param hits 输出：每条射线是否命中（0/1）
+     */
+    void castScalar(float originX, float originY, const TileGrid& grid, float* distances, uint8_t* hits) const;
+
+    /**
+     * @brief 沿调用方给定的方向投射（方向随帧变化的射线布局使用）
+     * @param originX 起点X坐标（像素）
+     * @param originY 起点Y坐标（像素）
+     * @param grid 关卡瓦片网格
+     * @param directionsX 单位方向X分量，长度count
+     * @param directionsY 单位方向Y分量，长度count
+     * @param count 射线数量
+     * @param distances 输出：每条射线的命中距离，长度count
+     * @param hits 输出：每条射线是否命中（0/1），长度count
+     * @details 遍历参数在栈上临时计算，之后与cast()使用同一套成组遍历代码，结果与cast()逐位一致
+     */
+    static void castDirections(float originX, float originY, const TileGrid& grid,
+                               const float* directionsX, const float* directionsY, int count,
+                               float* distances, uint8_t* hits);
+
+    /** @brief 批量投射时单个命中掩码能容纳的最大射线数量 */
+    static constexpr int MAX_MASK_RAYS = 64;
+
+    /**
+     * @brief 从多个起点批量投射（每个起点使用各自的关卡）
+     * @param originsX 起点X坐标数组，长度count
+     * @param originsY 起点Y坐标数组，长度count
+     * @param count 起点数量
+     * @param grids 每个起点对应的关卡网格指针，长度count
+     * @param distances 输出：第i个起点的射线距离写在distances + i*distanceStride处，连续getRayCount()个
+     * @param distanceStride 相邻起点距离行的间隔（以float计），不小于getRayCount()；
+     *        取特征行宽度时可直接写进网络输入矩阵，无需重新打包
+     * @param hitMasks 输出：第i个起点的命中掩码，第r位表示第r条射线命中，长度count
+     * @param threads 工作线程数，起点按连续区间分给各线程；1表示在当前线程投射
+     * @return 射线数量超过MAX_MASK_RAYS或步长不足时返回false，不写输出
+     * @details 方向表、遍历参数和各关卡的碰撞位图在所有起点之间共用，每个起点只做一次cast()
+     */
+    bool castBatch(const float* originsX, const float* originsY, int count,
+                   const TileGrid* const* grids, float* distances, size_t distanceStride,
+                   uint64_t* hitMasks, int threads = 1) const;
+
+    /**
+     * @brief 从多个起点批量投射（所有起点共用一个关卡）
+     * @details 参数含义同上
+     */
+    bool castBatch(const float* originsX, const float* originsY, int count,
+                   const TileGrid& grid, float* distances, size_t distanceStride,
+                   uint64_t* hitMasks, int threads = 1) const;
+
+    /** @brief 编译时选用的指令集（"AVX2"、"SSE2"或"Scalar"） */
+    static const char* instructionSet();
+
+    /**
+     * @brief 计算射线单位方向
+     * @param raysPerQuadrant 每个象限的射线数量
+     * @param outX 输出方向X分量，长度raysPerQuadrant*4
+     * @param outY 输出方向Y分量，长度raysPerQuadrant*4
+     * @details 第i个象限从i*90度开始，象限内均匀分布
+     */
+    static void buildDirections(int raysPerQuadrant, float* outX, float* outY);
+
+private:
+    /** @brief 一组射线方向的遍历参数（数组长度补齐到16的倍数，count为有效射线数） */
+    struct DirectionTables {
+        const float* dirX;
+        const float* dirY;
+        const float* deltaX;
+        const float* deltaY;
+        const int32_t* stepX;
+        const int32_t* stepY;
+        int count;
+    };
+
+    /** @brief 构造时预计算的方向表 */
+    DirectionTables memberTables() const;
+
+    /** @brief 按编译时选定的指令集投射一组方向 */
+    static void castTables(float originX, float originY, const TileGrid& grid,
+                           const DirectionTables& tables, float* distances, uint8_t* hits);
+
+    /** @brief 逐条射线遍历一组方向（标量参考实现） */
+    static void castTablesScalar(float originX, float originY, const TileGrid& grid,
+                                 const DirectionTables& tables, float* distances, uint8_t* hits);
+
+    /** @brief 投射[begin, end)区间内的起点（gridStride为0时所有起点共用grids[0]） */
+    void castRange(const float* originsX, const float* originsY, int begin, int end,
+                   const TileGrid* const* grids, size_t gridStride,
+                   float* distances, size_t distanceStride, uint64_t* hitMasks) const;
+
+    /** @brief 检查参数并把起点分配到工作线程 */
+    bool dispatchBatch(const float* originsX, const float* originsY, int count,
+                       const TileGrid* const* grids, size_t gridStride,
+                       float* distances, size_t distanceStride, uint64_t* hitMasks, int threads) const;
+
+    int rayCount;
+
+    // 按方向预计算的遍历参数，长度补齐到16的倍数（补齐的射线结果被丢弃）
+    std::vector<float> dirX, dirY;
+    std::vector<float> deltaX, deltaY;  // 跨越一个格子的射线长度（方向分量为0时为无穷大）
+    std::vector<int32_t> stepX, stepY;  // 每个轴上的格子步进方向（±1）
+};
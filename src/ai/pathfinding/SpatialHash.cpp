@@ -0,0 +1,184 @@
+// src/ai/pathfinding/SpatialHash.cpp
+// 动态实体的均匀空间哈希：增量更新与射线求交
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SpatialHash::SpatialHash(float cellSize, int bucketCount)
+    : cellSize(cellSize), invCellSize(1.0f / cellSize) {
+    size_t count = 1;
+    while (count < static_cast<size_t>(std::max(bucketCount, 1))) {
+        count <<= 1;
+    }
+    bucketMask = count - 1;
+    buckets.resize(count);
+}
+
+int SpatialHash::cellCoord(float v) const {
+    return static_cast<int>(std::floor(v * invCellSize));
+}
+
+size_t SpatialHash::bucketOf(int cellX, int cellY) const {
+    // 两个大素数相乘后异或（Teschner等人的空间哈希）
+    const uint32_t h = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u;
+    return h & bucketMask;
+}
+
+int SpatialHash::insert(float minX, float minY, float maxX, float maxY, RayHitType type) {
+    int handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<int>(entries.size());
+        entries.emplace_back();
+    }
+    Entry& e = entries[handle];
+    e.minX = minX;
+    e.minY = minY;
+    e.maxX = maxX;
+    e.maxY = maxY;
+    e.cellX0 = cellCoord(minX);
+    e.cellY0 = cellCoord(minY);
+    e.cellX1 = cellCoord(maxX);
+    e.cellY1 = cellCoord(maxY);
+    e.type = type;
+    e.alive = true;
+    link(handle);
+    liveCount++;
+    return handle;
+}
+
+void SpatialHash::update(int handle, float minX, float minY, float maxX, float maxY) {
+    if (handle < 0 || handle >= static_cast<int>(entries.size()) || !entries[handle].alive) return;
+    Entry& e = entries[handle];
+    e.minX = minX;
+    e.minY = minY;
+    e.maxX = maxX;
+    e.maxY = maxY;
+
+    const int x0 = cellCoord(minX), y0 = cellCoord(minY);
+    const int x1 = cellCoord(maxX), y1 = cellCoord(maxY);
+    if (x0 == e.cellX0 && y0 == e.cellY0 && x1 == e.cellX1 && y1 == e.cellY1) {
+        return;  // 仍在原来的方格内，只需更新包围盒
+    }
+    unlink(handle);
+    e.cellX0 = x0;
+    e.cellY0 = y0;
+    e.cellX1 = x1;
+    e.cellY1 = y1;
+    link(handle);
+    relinkCount++;
+}
+
+void SpatialHash::remove(int handle) {
+    if (handle < 0 || handle >= static_cast<int>(entries.size()) || !entries[handle].alive) return;
+    unlink(handle);
+    entries[handle].alive = false;
+    freeHandles.push_back(handle);
+    liveCount--;
+}
+
+void SpatialHash::clear() {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    entries.clear();
+    freeHandles.clear();
+    liveCount = 0;
+    relinkCount = 0;
+}
+
+void SpatialHash::link(int handle) {
+    const Entry& e = entries[handle];
+    for (int cy = e.cellY0; cy <= e.cellY1; ++cy) {
+        for (int cx = e.cellX0; cx <= e.cellX1; ++cx) {
+            buckets[bucketOf(cx, cy)].push_back(handle);
+        }
+    }
+}
+
+void SpatialHash::unlink(int handle) {
+    const Entry& e = entries[handle];
+    for (int cy = e.cellY0; cy <= e.cellY1; ++cy) {
+        for (int cx = e.cellX0; cx <= e.cellX1; ++cx) {
+            // 桶一般只有几个句柄，线性查找后与末尾交换删除（每个方格只登记一次）
+            std::vector<int>& bucket = buckets[bucketOf(cx, cy)];
+            auto it = std::find(bucket.begin(), bucket.end(), handle);
+            if (it != bucket.end()) {
+                *it = bucket.back();
+                bucket.pop_back();
+            }
+        }
+    }
+}
+
+bool SpatialHash::castRay(float originX, float originY, float dirX, float dirY, float maxDistance,
+                          float& distance, RayHitType& type) const {
+    if (liveCount == 0 || maxDistance <= 0.0f) return false;
+
+    const float inf = std::numeric_limits<float>::infinity();
+    const float invX = dirX != 0.0f ? 1.0f / dirX : inf;
+    const float invY = dirY != 0.0f ? 1.0f / dirY : inf;
+
+    int cellX = cellCoord(originX);
+    int cellY = cellCoord(originY);
+    const int stepX = dirX > 0 ? 1 : -1;
+    const int stepY = dirY > 0 ? 1 : -1;
+    const float tDeltaX = dirX != 0.0f ? cellSize * std::fabs(invX) : inf;
+    const float tDeltaY = dirY != 0.0f ? cellSize * std::fabs(invY) : inf;
+    float tMaxX = dirX > 0 ? ((cellX + 1) * cellSize - originX) * invX
+                : dirX < 0 ? (cellX * cellSize - originX) * invX : inf;
+    float tMaxY = dirY > 0 ? ((cellY + 1) * cellSize - originY) * invY
+                : dirY < 0 ? (cellY * cellSize - originY) * invY : inf;
+
+    float best = maxDistance;
+    RayHitType bestType = RayHitType::None;
+    while (true) {
+        for (int handle : buckets[bucketOf(cellX, cellY)]) {
+            const Entry& e = entries[handle];
+            // 桶冲突带来的其他方格实体直接跳过
+            if (cellX < e.cellX0 || cellX > e.cellX1 || cellY < e.cellY0 || cellY > e.cellY1) continue;
+
+            // 平板法求交，方向分量为0时只检查起点是否在该轴范围内
+            float tNear = 0.0f, tFar = best;
+            if (dirX != 0.0f) {
+                float t1 = (e.minX - originX) * invX;
+                float t2 = (e.maxX - originX) * invX;
+                tNear = std::max(tNear, std::min(t1, t2));
+                tFar = std::min(tFar, std::max(t1, t2));
+            } else if (originX < e.minX || originX > e.maxX) {
+                continue;
+            }
+            if (dirY != 0.0f) {
+                float t1 = (e.minY - originY) * invY;
+                float t2 = (e.maxY - originY) * invY;
+                tNear = std::max(tNear, std::min(t1, t2));
+                tFar = std::min(tFar, std::max(t1, t2));
+            } else if (originY < e.minY || originY > e.maxY) {
+                continue;
+            }
+            if (tNear <= tFar && tNear < best) {
+                best = tNear;
+                bestType = e.type;
+            }
+        }
+
+        // 已有命中不晚于当前方格的出口时，后面的方格不可能更近
+        const float exit = std::min(tMaxX, tMaxY);
+        if (best <= exit || exit >= maxDistance) break;
+        if (tMaxX < tMaxY) {
+            tMaxX += tDeltaX;
+            cellX += stepX;
+        } else {
+            tMaxY += tDeltaY;
+            cellY += stepY;
+        }
+    }
+
+    if (bestType == RayHitType::None) return false;
+    distance = best;
+    type = bestType;
+    return true;
+}
@@ -0,0 +1,110 @@
+// src/ai/pathfinding/SpatialHash.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 射线命中的对象类型
+ */
+enum class RayHitType : uint8_t {
+    None = 0,   ///< 未命中
+    Tile,       ///< 碰撞瓦片
+    Enemy,      ///< 敌人
+    Bullet,     ///< 子弹
+    Item        ///< 物品
+};
+
+/**
+ * @file SpatialHash.h
+ * @brief 动态实体的均匀空间哈希（不依赖SFML）
+ * @details 世界按cellSize划分为方格，每个实体的包围盒登记在它覆盖的所有方格里，
+ * 方格坐标哈希到固定数量的桶（桶数为2的幂），关卡外的子弹也能登记
+ * - 实体用句柄标识，句柄在remove()之后复用
+ * - update()只在包围盒覆盖的方格范围变化时才改动桶，
+ *   实体每帧移动几个像素时绝大多数更新只写包围盒，每帧开销与实体数量成线性而非重建
+ * - castRay()沿射线按方格顺序遍历（与瓦片DDA相同），只测试经过方格内的实体，
+ *   找到的最近命中不晚于当前方格出口时提前结束；桶冲突只会多测几个包围盒，不影响结果
+ * 默认方格边长60像素（4个瓦片），150像素的射线最多经过约6个方格
+ */
+class SpatialHash {
+public:
+    /** @brief 无效句柄 */
+    static constexpr int NO_HANDLE = -1;
+
+    /**
+     * @brief 构造函数
+     * @param cellSize 方格边长（像素），应不小于常见实体的尺寸
+     * @param bucketCount 桶数量，向上取整到2的幂
+     */
+    explicit SpatialHash(float cellSize = 60.0f, int bucketCount = 1024);
+
+    /**
+     * @brief 登记实体
+     * @param minX 包围盒左边界（像素）
+     * @param minY 包围盒上边界
+     * @param maxX 包围盒右边界
+     * @param maxY 包围盒下边界
+     * @param type 实体类型（射线命中时报告）
+     * @return 实体句柄
+     */
+    int insert(float minX, float minY, float maxX, float maxY, RayHitType type);
+
+    /**
+     * @brief 更新实体包围盒（增量：覆盖的方格不变时不改动桶）
+     * @param handle insert()返回的句柄
+     */
+    void update(int handle, float minX, float minY, float maxX, float maxY);
+
+    /** @brief 移除实体，句柄之后会被复用 */
+    void remove(int handle);
+
+    /** @brief 清空全部实体（保留桶的容量） */
+    void clear();
+
+    /** @brief 当前登记的实体数量 */
+    int size() const { return liveCount; }
+    bool empty() const { return liveCount == 0; }
+
+    /** @brief 自上次resetRelinkCount()以来因跨越方格而改动桶的update()次数 */
+    size_t getRelinkCount() const { return relinkCount; }
+    void resetRelinkCount() { relinkCount = 0; }
+
+    /**
+     * @brief 射线与实体包围盒求交
+     * @param originX 起点X坐标（像素）
+     * @param originY 起点Y坐标
+     * @param dirX 单位方向X分量
+     * @param dirY 单位方向Y分量
+     * @param maxDistance 只报告距离小于该值的命中（一般为瓦片命中距离）
+     * @param distance 输出：最近命中距离（起点在包围盒内时为0）
+     * @param type 输出：最近命中实体的类型
+     * @return 是否命中
+     * @note 只读，可在多个线程中同时查询
+     */
+    bool castRay(float originX, float originY, float dirX, float dirY, float maxDistance,
+                 float& distance, RayHitType& type) const;
+
+private:
+    struct Entry {
+        float minX, minY, maxX, maxY;
+        int cellX0, cellY0, cellX1, cellY1;  // 覆盖的方格范围（闭区间）
+        RayHitType type;
+        bool alive;
+    };
+
+    int cellCoord(float v) const;
+    size_t bucketOf(int cellX, int cellY) const;
+    void link(int handle);
+    void unlink(int handle);
+
+    float cellSize;
+    float invCellSize;
+    size_t bucketMask;
+    std::vector<std::vector<int>> buckets;  // 桶 -> 实体句柄
+    std::vector<Entry> entries;
+    std::vector<int> freeHandles;
+    int liveCount = 0;
+    size_t relinkCount = 0;
+};
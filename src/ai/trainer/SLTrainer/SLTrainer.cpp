@@ -438,25 +438,9 @@ std::vector<float> SLTrainer::BehaviorCloningAgent::forward(const std::vector<fl
 std::vector<float> SLTrainer::BehaviorCloningAgent::normalizeInput(const std::vector<float>& input) {
     std::vector<float> normalized = input;
     
-    // 简单的归一化：将输入值缩放到[-1, 1]范围
-    // 这里假设输入特征的大致范围，可以根据实际数据调整
-    for (size_t i = 0; i < normalized.size(); ++i) {
-        // 位置特征归一化（假设范围在-1000到1000）
-        if (i < 2) { // x, y位置
-            normalized[i] = normalized[i] / 1000.0f;
-        }
-        // 速度特征归一化（假设范围在-10到10）
-        else if (i < 4) { // vx, vy速度
-            normalized[i] = normalized[i] / 10.0f;
-        }
-        // 距离特征归一化（假设范围在0到1000）
-        else if (i < 6) { // 距离相关特征
-            normalized[i] = normalized[i] / 1000.0f;
-        }
-        // 其他特征归一化
-        else {
-            normalized[i] = std::tanh(normalized[i]); // 使用tanh函数将值压缩到[-1, 1]
-        }
+    // 输入为数据集中的一行原始特征，按特征布局标准化（与游戏内推理相同）
+    if (normalized.size() == static_cast<size_t>(FeatureSchema::FEATURE_COUNT)) {
+        FeatureSchema::normalize(normalized.data());
     }
     
     return normalized;
@@ -13,6 +13,8 @@
 #include <limits>
 #include <string>
 
+#include "../../controller/FeatureSchema.h"
+
 namespace SimpleML {
     /**
      * @brief 训练数据结构体
@@ -115,7 +117,7 @@ public:
     
     /**
      * @brief 使用模型进行预测
-     * @param state 输入状态
+     * @param state 输入状态（数据集中的一行原始特征，内部标准化）
      * @return 预测的动作向量
      */
     std::vector<float> predict(const std::vector<float>& state);
@@ -279,7 +281,7 @@ private:
         
     private:
         TrainingConfig config;                    ///< 训练配置
-        const int inputDim = 130;                 ///< 输入维度
+        const int inputDim = FeatureSchema::FEATURE_COUNT;  ///< 输入维度（特征布局决定，130）
         const int hiddenDim1 = 256;               ///< 第一层隐藏层维度（扩展）
         const int hiddenDim2 = 128;               ///< 第二层隐藏层维度
         const int hiddenDim3 = 64;                ///< 第三层隐藏层维度
@@ -323,8 +325,8 @@ private:
         std::vector<float> forwardNetwork(const std::vector<float>& input);
         
         /**
-         * @brief 输入归一化
-         * @param input 输入向量
+         * @brief 输入归一化（按FeatureSchema标准化，与游戏内推理一致）
+         * @param input 数据集中的一行原始特征
          * @return 归一化后的向量
          */
         std::vector<float> normalizeInput(const std::vector<float>& input);
@@ -1,4 +1,5 @@
 #include "SequenceTrainer.h"
+#include "../../controller/FeatureSchema.h"
 #include <algorithm>
 #include <fstream>
 #include <sstream>
@@ -567,7 +568,7 @@ SequenceTrainer::LSTMSequenceModel::LSTMSequenceModel(const SequenceTrainingConf
 SequenceTrainer::LSTMSequenceModel::~LSTMSequenceModel() = default;
 
 void SequenceTrainer::LSTMSequenceModel::initializeLSTMWeights() {
-    int inputSize = 130; // 状态特征维度
+    int inputSize = FeatureSchema::FEATURE_COUNT; // 状态特征维度
     int lstm1Size = config.lstmHiddenSize1;
     int lstm2Size = config.lstmHiddenSize2;
     int denseSize = config.denseHiddenSize;
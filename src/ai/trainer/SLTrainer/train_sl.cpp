@@ -9,6 +9,8 @@
 #include <chrono>
 #include <ctime>
 
+#include "../../controller/FeatureSchema.h"
+
 int main() {
     std::cout << "Supervised Learning Training Module" << std::endl;
     
@@ -49,8 +51,17 @@ int main() {
     std::string line;
     std::vector<std::vector<float>> allData;
     
-    // 跳过表头
+    // 表头必须与特征布局一致，否则各列含义不同，直接拒绝而不是按列号硬读
     std::getline(file, line);
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    if (line != FeatureSchema::datasetHeader()) {
+        std::cerr << "Error: dataset columns do not match the feature layout (expected "
+                  << FeatureSchema::DATASET_COLUMNS << " columns: "
+                  << FeatureSchema::datasetHeader().substr(0, 80) << "...)" << std::endl;
+        return 1;
+    }
     
     // 读取所有数据行
     while (std::getline(file, line)) {
@@ -62,7 +73,7 @@ int main() {
             row.push_back(std::stof(value));
         }
         
-        if (row.size() >= 132) {
+        if (row.size() == static_cast<size_t>(FeatureSchema::DATASET_COLUMNS)) {
             allData.push_back(row);
         }
     }
@@ -81,16 +92,14 @@ int main() {
     for (const auto& row : allData) {
         SimpleML::TrainingData sample;
         
-        // 前130列是状态数据
-        sample.state.resize(130);
-        for (int i = 0; i < 130; ++i) {
-            sample.state[i] = row[i];
-        }
+        // 前FEATURE_COUNT列是原始状态特征，按特征布局标准化（与游戏内推理相同）
+        sample.state.assign(row.begin(), row.begin() + FeatureSchema::FEATURE_COUNT);
+        FeatureSchema::normalize(sample.state.data());
         
         // 接下来的2列是动作数据
         sample.action.resize(2);
-        sample.action[0] = row[130]; // action_x
-        sample.action[1] = row[131]; // use_energy
+        sample.action[0] = row[FeatureSchema::ACTION_X];
+        sample.action[1] = row[FeatureSchema::USE_ENERGY];
         
         // 设置默认奖励和结束标志
         sample.reward = 0.0f;
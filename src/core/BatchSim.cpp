@@ -0,0 +1,125 @@
+// BatchSim.cpp
+
+#include "BatchSim.h"
+#include "../world/Parser.h"
+#include "../physics/GridCollision.h"
+#include <algorithm>
+#include <cmath>
+
+BatchSim::BatchSim(int count, float fixedDt)
+    : count(count), fixedDt(fixedDt),
+      posX(count), posY(count), velX(count), velY(count), energy(count),
+      onGround(count), reached(count), steps(count),
+      grids(count), spawnX(count), spawnY(count), targetX(count), targetY(count),
+      gridPointers(count), centerX(count), centerY(count) {
+    for (int i = 0; i < count; ++i) {
+        gridPointers[i] = &grids[i];
+    }
+}
+
+bool BatchSim::castRaysBatch(const SimdRayCaster& caster, float* distances, size_t distanceStride,
+                             uint64_t* hitMasks, int threads) {
+    const float halfSize = PLAYER_SIZE / 2.0f;
+    for (int i = 0; i < count; ++i) {
+        centerX[i] = posX[i] + halfSize;
+        centerY[i] = posY[i] + halfSize;
+    }
+    return caster.castBatch(centerX.data(), centerY.data(), count, gridPointers.data(),
+                            distances, distanceStride, hitMasks, threads);
+}
+
+void BatchSim::resetAll() {
+    for (int i = 0; i < count; ++i) {
+        resetEnv(i);
+    }
+}
+
+void BatchSim::resetEnv(int index) {
+    loadLevel(index, Parser::parseLevel());
+}
+
+void BatchSim::loadLevel(int index, const std::vector<std::string>& levelData) {
+    TileGrid& grid = grids[index];
+    grid.build(levelData);
+
+    // 查找出生点和终点
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x) {
+            TileKind kind = grid.kindAt(x, y);
+            if (kind == TileKind::Player) {
+                spawnX[index] = static_cast<float>(x * TILE);
+                spawnY[index] = static_cast<float>(y * TILE);
+            } else if (kind == TileKind::Target) {
+                targetX[index] = static_cast<float>(x * TILE);
+                targetY[index] = static_cast<float>(y * TILE);
+            }
+        }
+    }
+
+    posX[index] = spawnX[index];
+    posY[index] = spawnY[index];
+    velX[index] = 0.0f;
+    velY[index] = 0.0f;
+    energy[index] = PLAYER_MAX_ENERGY;
+    onGround[index] = 0;
+    reached[index] = 0;
+    steps[index] = 0;
+}
+
+void BatchSim::step(const float* moveX, const uint8_t* useEnergy) {
+    integrate(moveX, useEnergy);
+    resolveCollisions();
+
+    // 终点检测：玩家包围盒与终点瓦片相交
+    for (int i = 0; i < count; ++i) {
+        bool hit = posX[i] < targetX[i] + TILE && posX[i] + PLAYER_SIZE > targetX[i] &&
+                   posY[i] < targetY[i] + TILE && posY[i] + PLAYER_SIZE > targetY[i];
+        reached[i] = hit ? 1 : 0;
+        steps[i]++;
+    }
+}
+
+void BatchSim::integrate(const float* moveX, const uint8_t* useEnergy) {
+    const float dt = fixedDt;
+    const float flyVelocity = -JUMP_VELOCITY * FLY_VELOCITY_FACTOR;
+    const float drain = ENERGY_CONSUMPTION_RATE * dt;
+    const float regen = ENERGY_REGEN_RATE * dt;
+    const float gravityStep = GRAVITY * dt;
+
+    float* vxs = velX.data();
+    float* vys = velY.data();
+    float* es = energy.data();
+    uint8_t* grounded = onGround.data();
+
+    // 无分支写法，便于编译器自动向量化
+    for (int i = 0; i < count; ++i) {
+        float e = es[i];
+        bool g = grounded[i] != 0;
+
+        // 输入（Player::handleInput，AI模式）
+        float vx = moveX[i] * MOVE_SPEED;
+        float vy = (useEnergy[i] != 0 && e > 0.0f) ? flyVelocity : vys[i];
+
+        // 能量管理（Player::update）
+        bool flying = vy < 0.0f && !g;
+        float drained = std::max(e - drain, 0.0f);
+        float restored = std::min(e + regen, PLAYER_MAX_ENERGY);
+        e = (flying && e > 0.0f) ? drained : ((g && e < PLAYER_MAX_ENERGY) ? restored : e);
+
+        // 重力与下落速度限制
+        vy = (vy < MAX_FALL_SPEED) ? vy + gravityStep : vy;
+
+        vxs[i] = vx;
+        vys[i] = vy;
+        es[i] = e;
+    }
+}
+
+void BatchSim::resolveCollisions() {
+    for (int i = 0; i < count; ++i) {
+        bool grounded = false;
+        sweepGridCollision(posX[i], posY[i], PLAYER_SIZE, PLAYER_SIZE,
+                           velX[i], velY[i], grounded, fixedDt, grids[i]);
+        onGround[i] = grounded ? 1 : 0;
+    }
+}
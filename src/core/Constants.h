@@ -75,6 +75,50 @@ constexpr float JUMP_VELOCITY  = 400.f;
  */
 constexpr float MOVE_SPEED = 160.f;
 
+/**
+ * @brief 飞行上升速度系数
+ * @details 消耗能量上升时的垂直速度为 -JUMP_VELOCITY × 该系数
+ * 键盘控制与AI控制共用，保证两种输入方式手感一致
+ */
+constexpr float FLY_VELOCITY_FACTOR = 0.45f;
+
+/**
+ * @brief 最大下落速度（像素/秒）
+ * @details 垂直速度达到该值后不再叠加重力，避免高速下落穿透平台
+ */
+constexpr float MAX_FALL_SPEED = 500.f;
+
+/**
+ * @brief 玩家碰撞盒边长（像素）
+ * @details 玩家为0.8个瓦片大小的正方形，12×12像素，任意时刻最多与2×2个瓦片重叠
+ */
+constexpr float PLAYER_SIZE = TILE * 0.8f;
+
+/**
+ * @brief 玩家最大能量值
+ * @details 飞行时消耗，站在地面上时恢复
+ */
+constexpr float PLAYER_MAX_ENERGY = 150.f;
+
+/**
+ * @brief 飞行能量消耗速率（单位/秒）
+ * @details 150能量约可连续飞行1.5秒
+ */
+constexpr float ENERGY_CONSUMPTION_RATE = 100.f;
+
+/**
+ * @brief 地面能量恢复速率（单位/秒）
+ * @details 远高于消耗速率，落地约0.3秒即可回满
+ */
+constexpr float ENERGY_REGEN_RATE = 500.f;
+
+/**
+ * @brief 无窗口/并行模拟允许的最大步长（秒）
+ * @details 连续碰撞检测在1/15秒的步长下验证过（最大下落速度时不穿过一格厚的平台），
+ * 更粗的步长下能量、跳跃等按帧更新的行为未经验证，--dt超出该值时拒绝运行
+ */
+constexpr float MAX_FIXED_DT = 1.0f / 15.0f;
+
 /**
  * @brief 寻路节点间距（像素）
  * @details A*寻路算法中节点之间的最小间距，影响路径精度和计算效率
@@ -89,4 +133,11 @@ constexpr float NODE_SPACING = 15.0f;
  */
 constexpr const char* AI_MODEL_PATH = "d:/steam/steamapps/common/Noita/mods/NoitaCoreAI/aiDev/models/SL_models/intermediate_model_epoch_20.bin";
 
+/**
+ * @brief 量化模型文件路径
+ * @details 由quantize_model工具从AI_MODEL_PATH生成（INT8或FP16），存在时游戏以量化模型推理，
+ * 与fp32的决策一致率不足时自动退回AI_MODEL_PATH
+ */
+constexpr const char* AI_QUANTIZED_MODEL_PATH = "d:/steam/steamapps/common/Noita/mods/NoitaCoreAI/aiDev/models/SL_models/intermediate_model_epoch_20.qpm";
+
 #endif // CONSTANTS_H
\ No newline at end of file
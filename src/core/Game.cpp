@@ -80,6 +80,9 @@ Game::Game()
     
     // 初始化AI控制器并加载模型
     aiController.loadModel(AI_MODEL_PATH);
+    if (std::filesystem::exists(AI_QUANTIZED_MODEL_PATH)) {
+        aiController.loadQuantizedModel(AI_QUANTIZED_MODEL_PATH);
+    }
     std::cout << "[DEBUG] AI controller initialized and model loaded" << std::endl;
     
     // 初始化游戏局数计数器
@@ -102,9 +105,11 @@ Game::~Game() {
  */
 void Game::initResources() {    
 
-    // 确保地图数据已加载 - 直接触发地图初始化
+    // 确保地图数据已加载 - 直接触发地图初始化（无需窗口）
     map.resetMap();
-    map.draw(window.getMainWindow());
+    map.loadLevel();
+    rayObserver.setEntities(&entityHash);
+    registerLevelEntities();
 
     // 初始化玩家位置为安全默认值
     sf::Vector2f playerPos = map.getPlayerPos();
@@ -114,7 +119,7 @@ void Game::initResources() {
     playerSpawnPosition = playerPos;
     
     // 注册玩家到安全检查器
-    safetyChecker.registerEntity("player", [this]() -> Entity* { return &this->player; });
+    playerSafetyHandle = safetyChecker.registerEntity(&player);
     
     // 开始第一个回合，但默认不收集数据
     dataCollector.setRecordingEnabled(false);
@@ -147,7 +152,7 @@ void Game::handleInput(float dt) {
     // 检查是否由AI控制
     if (aiMode) {
         // 普通AI模式 - 使用已训练的模型
-        AIController::ActionResult result = aiController.decideActionWithDetails(player, map, rayCaster);
+        AIController::ActionResult result = aiController.decideActionWithDetails(player, map, currentObservation());
         
         // 调试输出AI动作信息（包含离散化和原始值）
         std::cout << "AI Action - Discrete: [moveX=" << result.action.moveX 
@@ -183,7 +188,7 @@ void Game::handleInput(float dt) {
             if (!currentState) {
                 // 开启收集时开始新回合
                 dataCollector.startEpisode();
-                episodeStartTime = timeManager.getGameTime();
+                episodeStartTime = timeManager.getSimTime();
                 episodeFrameCount = 0;
                 std::cout << "[DATA] Data collection ENABLED" << std::endl;
             } else {
@@ -210,42 +215,30 @@ void Game::handleInput(float dt) {
  * 4. 边界检查与处理
  */
 void Game::update(float dt) {
-    // 物理更新：处理重力、速度积分和动画状态
-    player.update(dt);
-    player.setOnGround(false);  // 重置地面状态标记，碰撞检测阶段会重新评估
-                                //碰撞检测存在概率性失败 通过该句建立安全默认值，避免检测失败导致穿越平台        
-
-    // 准备碰撞检测数据
-    PlayerCollisionData cd{player.getShapeRef(), player.getVelocity(), player.isOnGround()};
-    // 处理玩家与平台碰撞检测与响应
-    // 计算碰撞后的新位置和速度，并更新地面状态
-    handlePlayerPlatformCollision(cd, map.getTiles(), map.getLevelData());
-    
-    // 更新游戏状态(碰撞后)
-    player.setPosition(cd.shape.getPosition());      // 更新玩家位置
-    player.setVelocity(cd.velocity); // 更新玩家速度
-    player.setOnGround(cd.onGround); // 更新地面状态
+    // 收集训练数据：记录动作执行前的状态，与AI决策看到的观测相同（与并行采集的顺序一致）
+    if (dataCollector.isRecordingEnabled()) {
+        // 监督学习模式 - 使用共享的数据收集器
+        dataCollector.recordCurrentFrame(dataCollector.getCurrentFrameData(player, map, currentObservation()));
+    }
+
+    // 物理更新与平台碰撞响应（与无窗口模拟共用同一实现）
+    sf::Vector2f previousPosition = player.getPosition();
+    HeadlessSim::stepPlayerPhysics(player, map, dt);
     
     // 增加帧计数
     episodeFrameCount++;
 
-    // 收集训练数据
     if (dataCollector.isRecordingEnabled()) {
-        // 监督学习模式 - 使用共享的数据收集器
-        dataCollector.recordCurrentFrame(dataCollector.getCurrentFrameData(player, map, rayCaster));
-        
-        // 更新距离跟踪（从DataCollector内部获取最新距离）
+        // 更新距离跟踪
         sf::Vector2f targetPos = map.getTargetPosition();
         sf::Vector2f diff = targetPos - player.getPosition();
         lastDistanceToTarget = std::sqrt(diff.x * diff.x + diff.y * diff.y);
     }
 
     // 检测玩家是否到达目标点
-    sf::Vector2f targetPos = map.getTargetPosition();
-    sf::FloatRect targetBounds(targetPos, sf::Vector2f(TILE, TILE));
-    if (player.getShape().getGlobalBounds().intersects(targetBounds)) {
+    if (HeadlessSim::isTargetReached(player, map, previousPosition)) {
         // 成功完成，记录数据
-        float gameDuration = timeManager.getGameTime() - episodeStartTime;
+        float gameDuration = timeManager.getSimTime() - episodeStartTime;
         float averageFPS = (gameDuration > 0.0f) ? static_cast<float>(episodeFrameCount) / gameDuration : 0.0f;
         
         dataCollector.endEpisode(true, gameDuration, averageFPS);
@@ -258,23 +251,10 @@ void Game::update(float dt) {
         return;
     }
     
-    // 边界检查：防止玩家掉落到地图边界外
-    // 使用实际地图尺寸进行边界检测（左上角坐标系）
-    auto playerBounds = player.getShape().getGlobalBounds();
-    
-    // 计算实际地图尺寸（像素）
-    const auto& levelData = map.getLevelData();
-    
-    // 更新射线检测
-    if (showRayDebug) {
-        sf::Vector2f playerPos = player.getPosition() + sf::Vector2f(TILE/2, TILE/2);
-        rayHits = rayCaster.castRays(playerPos, map.getLevelData());
-    }
-    
     // 运行时安全检查
-    if (safetyChecker.updateEntitySafety("player", map.getLevelData(), map.getTiles(), dt)) {
+    if (safetyChecker.updateEntitySafety(playerSafetyHandle, map.getTileGrid(), dt)) {
         // 安全检查失败，记录数据
-        float gameDuration = timeManager.getGameTime() - episodeStartTime;
+        float gameDuration = timeManager.getSimTime() - episodeStartTime;
         float averageFPS = (gameDuration > 0.0f) ? static_cast<float>(episodeFrameCount) / gameDuration : 0.0f;
         
         dataCollector.endEpisode(false, gameDuration, averageFPS);
@@ -303,14 +283,19 @@ void Game::render() {
     // 更新渲染器状态
     renderer.setPlayerSpawnPosition(playerSpawnPosition);
     
-    auto playerSafety = safetyChecker.getEntitySafety("player");
+    const auto& playerSafety = safetyChecker.getEntitySafety(playerSafetyHandle);
     renderer.setDangerState(playerSafety.isInDanger, playerSafety.dangerTimer);
     
+    // 射线调试直接绘制本模拟步的观测（即AI和数据采集看到的射线），只在没有模拟步投射过时补投一次
+    if (showRayDebug) {
+        currentObservation();
+    }
+    
     // 使用新的渲染器接口渲染完整游戏画面
     renderer.renderMainWindow(mainWindowRef, map, player, ui, 
                              timeManager.getGameTime(), 
                              static_cast<float>(timeManager.getFPS()), 
-                             showRayDebug, rayHits);
+                             showRayDebug, rayObservation);
     
     // 显示AI模式状态
     if (aiMode) {
@@ -333,6 +318,17 @@ void Game::render() {
     dataCollectionText.setFillColor(dataCollector.isRecordingEnabled() ? sf::Color::Green : sf::Color::Red);
     dataCollectionText.setPosition(10, 75);
     mainWindowRef.draw(dataCollectionText);
+
+    // 显示模拟倍速
+    sf::Text speedText;
+    speedText.setFont(renderer.getFont());
+    speedText.setString(timeManager.isUncapped()
+                            ? std::string("Speed: MAX")
+                            : "Speed: " + std::to_string(static_cast<int>(timeManager.getTimeScale())) + "x");
+    speedText.setCharacterSize(14);
+    speedText.setFillColor(sf::Color::Blue);
+    speedText.setPosition(10, 95);
+    mainWindowRef.draw(speedText);
 }
 
 /**
@@ -340,9 +336,12 @@ void Game::render() {
  * @details 重置游戏到初始状态，包括地图、玩家位置、时间等
  */
 void Game::resetLevel() {
+    rayObservationValid = false;  // 关卡和玩家位置变化，旧观测作废
+    rayObserver.reset();
+
     // 结束当前数据收集回合
     if (episodeFrameCount > 0) {
-        float gameDuration = timeManager.getGameTime() - episodeStartTime;
+        float gameDuration = timeManager.getSimTime() - episodeStartTime;
         float averageFPS = (gameDuration > 0.0f) ? static_cast<float>(episodeFrameCount) / gameDuration : 0.0f;
         dataCollector.endEpisode(false, gameDuration, averageFPS);
     }
@@ -358,10 +357,12 @@ void Game::resetLevel() {
 
     // 重新初始化地图资源 - 强制重新加载关卡数据
     map.resetMap();
-    map.draw(window.getMainWindow());
+    map.loadLevel();
+    registerLevelEntities();
+    std::cout << "[DEBUG] Level seed: " << map.getLevelSeed() << std::endl;
 
     // 重置安全检查器状态
-    safetyChecker.resetEntitySafety("player");
+    safetyChecker.resetEntitySafety(playerSafetyHandle);
 
     // 重置距离跟踪
     lastDistanceToTarget = 0.0f;
@@ -370,7 +371,7 @@ void Game::resetLevel() {
     sf::Vector2f playerPos = map.getPlayerPos();
     sf::Vector2f targetPos = map.getTargetPosition();
 
-    player.setPosition(playerPos);
+    player.respawn(playerPos);
     playerSpawnPosition = playerPos;
 
     // 重置时间管理器
@@ -379,11 +380,11 @@ void Game::resetLevel() {
     // 只有在数据收集启用时才开始新回合
     if (dataCollector.isRecordingEnabled()) {
         dataCollector.startEpisode();
-        episodeStartTime = timeManager.getGameTime();
+        episodeStartTime = timeManager.getSimTime();
         episodeFrameCount = 0;
         std::cout << "[DEBUG] New episode started - Data collection ENABLED" << std::endl;
     } else {
-        episodeStartTime = timeManager.getGameTime();
+        episodeStartTime = timeManager.getSimTime();
         episodeFrameCount = 0;
         std::cout << "[DEBUG] New episode started - Data collection DISABLED" << std::endl;
     }
@@ -391,6 +392,27 @@ void Game::resetLevel() {
     return;
 }
 
+/**
+ * @brief 按关卡标记重建实体哈希
+ * @details 生成器产出的关卡不含'E'/'I'标记，此时哈希为空，射线观测不增加开销
+ */
+void Game::registerLevelEntities() {
+    entityHash.clear();
+    const TileGrid& grid = map.getTileGrid();
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x) {
+            TileKind kind = grid.kindAt(x, y);
+            if (kind != TileKind::Enemy && kind != TileKind::Item) continue;
+            entityHash.insert(static_cast<float>(x * TILE), static_cast<float>(y * TILE),
+                              static_cast<float>((x + 1) * TILE), static_cast<float>((y + 1) * TILE),
+                              kind == TileKind::Enemy ? RayHitType::Enemy : RayHitType::Item);
+        }
+    }
+    if (!entityHash.empty()) {
+        std::cout << "[RAYCAST] Registered " << entityHash.size() << " level entities" << std::endl;
+    }
+}
+
 /**
  * @brief 保存收集的数据
  * @details 将训练数据保存到文件，包括二进制数据和CSV格式
@@ -418,13 +440,93 @@ void Game::saveCollectedData() {
     std::cout << "[DEBUG] Data saved to " << basePath << "collected_data.bin and " << basePath << "training_dataset.csv" << std::endl;
 }
 
+/**
+ * @brief 使用预生成关卡库
+ * @param path 关卡库文件路径
+ * @return 打开成功返回true
+ */
+bool Game::useLevelBank(const std::string& path) {
+    if (!levelBank.open(path)) {
+        return false;
+    }
+    map.setLevelBank(&levelBank);
+    resetLevel();
+    return true;
+}
+
+void Game::setRayLayout(const RayLayout& layout) {
+    rayObserver.setLayout(layout);
+    dataCollector.setRayLayout(layout);
+    rayObservationValid = false;
+    std::cout << "[RAYCAST] Ray layout: " << layout.describe() << std::endl;
+}
+
+/**
+ * @brief 执行一个固定时间步长的模拟步
+ * @param dt 固定时间步长(秒)
+ */
+void Game::stepSimulation(float dt) {
+    timeManager.advanceSimStep();
+    rayObservationValid = false;  // 新的模拟步，观测按需重新投射
+    handleInput(dt);  // 处理用户输入
+    update(dt);       // 更新游戏状态
+}
+
+const RayObservation& Game::currentObservation() {
+    if (!rayObservationValid) {
+        rayObserver.observe(rayCaster, player, map, rayObservation);
+        rayObservationValid = true;
+    }
+    return rayObservation;
+}
+
+/**
+ * @brief 设置模拟倍速
+ * @param scale 模拟时间与真实时间之比
+ * @param uncapped 是否不限速（忽略scale）
+ */
+void Game::setSimulationSpeed(float scale, bool uncapped) {
+    timeManager.setTimeScale(scale);
+    timeManager.setUncapped(uncapped);
+    if (uncapped) {
+        std::cout << "[TIME] Simulation speed: uncapped" << std::endl;
+    } else {
+        std::cout << "[TIME] Simulation speed: " << timeManager.getTimeScale() << "x" << std::endl;
+    }
+}
+
+/**
+ * @brief 按档位调整模拟倍速
+ * @param direction +1提高一档，-1降低一档；最高档之上为不限速
+ */
+void Game::changeSimulationSpeed(int direction) {
+    static const float SPEED_PRESETS[] = {1.0f, 2.0f, 5.0f, 10.0f, 25.0f, 50.0f, 100.0f};
+    const int presetCount = static_cast<int>(sizeof(SPEED_PRESETS) / sizeof(SPEED_PRESETS[0]));
+
+    // 当前档位：不限速视为最高档之上
+    int level = presetCount;
+    if (!timeManager.isUncapped()) {
+        level = 0;
+        while (level + 1 < presetCount && SPEED_PRESETS[level + 1] <= timeManager.getTimeScale()) {
+            level++;
+        }
+    }
+
+    level = std::clamp(level + direction, 0, presetCount);
+    if (level == presetCount) {
+        setSimulationSpeed(SPEED_PRESETS[presetCount - 1], true);
+    } else {
+        setSimulationSpeed(SPEED_PRESETS[level], false);
+    }
+}
+
 /**
  * @brief 游戏主循环
  * @details 控制游戏生命周期的核心函数，实现：
  * 1. 事件处理循环(窗口关闭、键盘输入等)
  * 2. FPS计算与显示更新
  * 3. 游戏状态更新控制(暂停/帧步模式)
- * 4. 固定时间步长的游戏逻辑更新
+ * 4. 固定时间步长的游戏逻辑更新（累加器，支持倍速/不限速，[ ]键调整）
  * 5. 画面渲染
  * 循环持续到窗口关闭
  */
@@ -453,7 +555,12 @@ void Game::run() {
         
         // P键切换AI控制模式
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::P)) {
-            if (!pPressed) {
+            if (!pPressed && !aiMode && !rayObserver.getLayout().matchesModelInput()) {
+                // 模型输入固定为默认布局的特征，其他布局的观测无法交给模型
+                std::cout << "[AI] AI control mode needs the default ray layout, current: "
+                          << rayObserver.getLayout().describe() << std::endl;
+                pPressed = true;
+            } else if (!pPressed) {
                 aiMode = !aiMode;
                 aiController.setAIEnabled(aiMode);
                 std::cout << "[AI] AI control mode: " << (aiMode ? "ENABLED" : "DISABLED") << std::endl;
@@ -463,13 +570,41 @@ void Game::run() {
             pPressed = false;
         }
 
-        // 游戏逻辑更新控制
-    float dt = timeManager.getDeltaTime();
-    
-    if (!timeManager.isPaused()) {
-        handleInput(dt);  // 处理用户输入
-        update(dt);       // 更新游戏状态
-    }
+        // [ / ] 键调整模拟倍速（最高档为不限速）
+        static bool lbPressed = false;
+        static bool rbPressed = false;
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::LBracket)) {
+            if (!lbPressed) {
+                changeSimulationSpeed(-1);
+                lbPressed = true;
+            }
+        } else {
+            lbPressed = false;
+        }
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::RBracket)) {
+            if (!rbPressed) {
+                changeSimulationSpeed(+1);
+                rbPressed = true;
+            }
+        } else {
+            rbPressed = false;
+        }
+
+        // 固定时间步长的游戏逻辑更新：每帧执行整数个模拟步，物理只看到固定步长
+        int steps = timeManager.consumeFixedSteps();
+        float dt = timeManager.getFixedTimeStep();
+        if (steps < 0) {
+            // 不限速：在帧时间预算内尽可能多地推进模拟，然后渲染一帧
+            sf::Clock budgetClock;
+            do {
+                stepSimulation(dt);
+            } while (window.isMainWindowOpen() &&
+                     budgetClock.getElapsedTime().asSeconds() < TimeManager::UNCAPPED_FRAME_BUDGET);
+        } else {
+            for (int i = 0; i < steps && window.isMainWindowOpen(); ++i) {
+                stepSimulation(dt);
+            }
+        }
 
         render();
     }
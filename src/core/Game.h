@@ -7,6 +7,7 @@
 #include "../entity/Player.h"
 #include "../physics/Collision.h"
 #include "../ai/pathfinding/RayCasting.h"
+#include "../ai/pathfinding/RayObserver.h"
 
 #include "Renderer.h"
 #include "SafetyChecker.h"
@@ -15,6 +16,7 @@
 #include "Window.h"
 #include "UI.h"
 #include "Map.h"
+#include "HeadlessSim.h"
 #include "Constants.h"
 #include "../ai/controller/DataCollector.h"
 #include "../ai/controller/AIController.h"
@@ -50,8 +52,17 @@ private:
     /** @brief 射线检测系统 */
     RayCasting rayCaster;
     
-    /** @brief 射线检测结果 */
-    std::vector<RayHitInfo> rayHits;
+    /** @brief 按射线布局生成每步观测（保存轮流重投的进度） */
+    RayObserver rayObserver;
+    
+    /** @brief 动态实体的空间哈希（射线观测可以看到其中的敌人、子弹和物品） */
+    SpatialHash entityHash;
+    
+    /** @brief 本模拟步的射线观测（AI决策、数据采集和调试绘制共用） */
+    RayObservation rayObservation;
+    
+    /** @brief rayObservation是否已按本模拟步的玩家位置投射 */
+    bool rayObservationValid = false;
     
     /** @brief 是否显示射线调试信息 */
     bool showRayDebug = false;
@@ -62,12 +73,18 @@ private:
     /** @brief 安全检测器 */
     SafetyChecker safetyChecker;
     
+    /** @brief 玩家在安全检测器中的句柄 */
+    SafetyChecker::Handle playerSafetyHandle = SafetyChecker::INVALID_HANDLE;
+    
     /** @brief UI管理器 */
     UI ui;
 
     /** @brief 地图对象 */
     Map map;
 
+    /** @brief 预生成关卡库（useLevelBank打开后由map按顺序取关卡） */
+    LevelBank levelBank;
+
     /** @brief 渲染器对象 */
     Renderer renderer;
     
@@ -115,6 +132,27 @@ private:
      */
     void update(float dt);
     
+    /**
+     * @brief 执行一个固定时间步长的模拟步
+     * @param dt 固定时间步长（秒）
+     * @details 依次处理输入和更新游戏状态，并累计模拟时间
+     */
+    void stepSimulation(float dt);
+    
+    /**
+     * @brief 获取本模拟步的射线观测
+     * @details 每个模拟步第一次调用时从玩家中心投射，之后直接返回缓存，
+     * 因此无论AI、数据采集和射线调试开启几项，每步最多投射一次
+     */
+    const RayObservation& currentObservation();
+    
+    /**
+     * @brief 按档位调整模拟倍速
+     * @param direction +1提高一档，-1降低一档
+     * @details 档位为1/2/5/10/25/50/100倍速，最高档之上为不限速
+     */
+    void changeSimulationSpeed(int direction);
+    
     /**
      * @brief 渲染游戏画面
      * @details 清空窗口、绘制所有游戏元素、更新显示
@@ -129,6 +167,12 @@ private:
      */
     void resetLevel();
     
+    /**
+     * @brief 按关卡中的敌人('E')和物品('I')标记重建实体哈希
+     * @details 每个标记登记为一个瓦片大小的包围盒；运行中移动的实体通过getEntityHash()增量更新
+     */
+    void registerLevelEntities();
+    
     /**
      * @brief 保存收集的数据到文件
      * @details 将当前收集的所有episode数据保存到二进制和CSV文件
@@ -149,7 +193,34 @@ public:
     /**
      * @brief 启动游戏主循环
      * @details 包含输入处理、更新、渲染的完整游戏循环
-     * 控制游戏帧率，计算deltaTime并处理暂停状态
+     * 每帧按累加器换算出整数个固定步长的模拟步（支持倍速和不限速），然后渲染一帧
      */
     void run();
+    
+    /**
+     * @brief 设置模拟倍速
+     * @param scale 模拟时间与真实时间之比（1为实时）
+     * @param uncapped true时不限速：每帧在帧时间预算内尽可能多地执行模拟步
+     */
+    void setSimulationSpeed(float scale, bool uncapped = false);
+    
+    /**
+     * @brief 使用预生成关卡库
+     * @param path 关卡库文件路径（见tools/LevelBankGen）
+     * @return 打开成功返回true，并立即切换到关卡库中的第一个关卡
+     */
+    bool useLevelBank(const std::string& path);
+    
+    /**
+     * @brief 设置射线布局
+     * @param layout 射线布局，同时写入数据集表头
+     * @note 非默认布局改变特征维度，需要用同一布局采集的数据训练的模型
+     */
+    void setRayLayout(const RayLayout& layout);
+    
+    /**
+     * @brief 动态实体的空间哈希
+     * @details 实体系统在这里登记敌人、子弹和物品并每帧调用update()，射线观测随之看到它们
+     */
+    SpatialHash& getEntityHash() { return entityHash; }
 };
\ No newline at end of file
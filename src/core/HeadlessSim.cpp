@@ -0,0 +1,90 @@
+// HeadlessSim.cpp
+
+#include "HeadlessSim.h"
+#include "../physics/GridCollision.h"
+#include <algorithm>
+#include <cmath>
+
+HeadlessSim::HeadlessSim(float fixedDt)
+    : player(sf::Vector2f(0, 0)), fixedDt(fixedDt) {
+    playerSafetyHandle = safetyChecker.registerEntity(&player);
+}
+
+void HeadlessSim::reset() {
+    // 生成新关卡（不绘制）
+    map.resetMap();
+    map.loadLevel();
+
+    player.respawn(map.getPlayerPos());
+    safetyChecker.resetEntitySafety(playerSafetyHandle);
+    episodeSteps = 0;
+}
+
+HeadlessSim::StepResult HeadlessSim::step(const Action& action) {
+    StepResult result;
+
+    player.handleInput(fixedDt, true, action.moveX, action.useEnergy);
+    sf::Vector2f previousPosition = player.getPosition();
+    stepPlayerPhysics(player, map, fixedDt);
+    episodeSteps++;
+
+    if (isTargetReached(player, map, previousPosition)) {
+        result.reachedTarget = true;
+        return result;
+    }
+
+    result.safetyFailed = safetyChecker.updateEntitySafety(playerSafetyHandle, map.getTileGrid(), fixedDt);
+    return result;
+}
+
+HeadlessSim::EpisodeResult HeadlessSim::runEpisode(const Policy& policy, int maxSteps) {
+    EpisodeResult episode;
+
+    while (episodeSteps < maxSteps) {
+        StepResult result = step(policy(*this));
+        if (result.done()) {
+            episode.success = result.reachedTarget;
+            episode.safetyFailed = result.safetyFailed;
+            break;
+        }
+    }
+
+    episode.steps = episodeSteps;
+    episode.simTime = episodeSteps * fixedDt;
+    return episode;
+}
+
+void HeadlessSim::stepPlayerPhysics(Player& player, const Map& map, float dt) {
+    // 物理更新：能量和重力只改变速度，位移交给连续碰撞检测
+    player.applyForces(dt);
+
+    // 沿速度方向扫掠，在首个阻挡瓦片前停下，大时间步长也不会穿墙
+    sf::Vector2f position = player.getPosition();
+    sf::Vector2f velocity = player.getVelocity();
+    bool onGround = false;
+    sweepGridCollision(position.x, position.y, player.getWidth(), player.getHeight(),
+                       velocity.x, velocity.y, onGround, dt, map.getTileGrid());
+
+    // 写回碰撞后的位置、速度和地面状态
+    player.setPosition(position);
+    player.setVelocity(velocity);
+    player.setOnGround(onGround);
+}
+
+bool HeadlessSim::isTargetReached(const Player& player, const Map& map) {
+    sf::FloatRect targetBounds(map.getTargetPosition(), sf::Vector2f(TILE, TILE));
+    return player.getShape().getGlobalBounds().intersects(targetBounds);
+}
+
+bool HeadlessSim::isTargetReached(const Player& player, const Map& map, const sf::Vector2f& previousPosition) {
+    // 用本步起点和终点包围盒的并集检测，较大时间步长下也不会越过终点
+    sf::FloatRect bounds = player.getShape().getGlobalBounds();
+    sf::Vector2f delta = player.getPosition() - previousPosition;
+    bounds.left -= std::max(delta.x, 0.0f);
+    bounds.top -= std::max(delta.y, 0.0f);
+    bounds.width += std::abs(delta.x);
+    bounds.height += std::abs(delta.y);
+
+    sf::FloatRect targetBounds(map.getTargetPosition(), sf::Vector2f(TILE, TILE));
+    return bounds.intersects(targetBounds);
+}
@@ -0,0 +1,121 @@
+// HeadlessSim.h
+
+#pragma once
+#include <functional>
+#include "../entity/Player.h"
+#include "Map.h"
+#include "SafetyChecker.h"
+#include "Constants.h"
+
+/**
+ * @brief 无窗口模拟器
+ * @details 只运行玩家物理、平台碰撞、终点检测和安全检查，不创建窗口、不加载字体、不构造sf::Text
+ * 每次step按固定时间步长推进一帧，循环速度只受CPU限制，用于批量生成和评估回合数据
+ */
+class HeadlessSim {
+public:
+    /** @brief 单步输入动作 */
+    struct Action {
+        float moveX = 0.0f;      ///< 水平移动输入（-1到1）
+        bool useEnergy = false;  ///< 是否消耗能量上升
+    };
+
+    /** @brief 单步结果 */
+    struct StepResult {
+        bool reachedTarget = false;  ///< 本步是否到达终点
+        bool safetyFailed = false;   ///< 本步是否因安全检查失败而结束
+
+        /** @brief 回合是否在本步结束 */
+        bool done() const { return reachedTarget || safetyFailed; }
+    };
+
+    /** @brief 回合结果 */
+    struct EpisodeResult {
+        bool success = false;        ///< 是否到达终点
+        bool safetyFailed = false;   ///< 是否因安全检查失败而结束
+        int steps = 0;               ///< 执行的模拟步数
+        float simTime = 0.0f;        ///< 模拟时间（秒）
+    };
+
+    /** @brief 策略函数：根据当前模拟状态给出本步动作 */
+    using Policy = std::function<Action(const HeadlessSim&)>;
+
+    /**
+     * @brief 构造函数
+     * @param fixedDt 固定时间步长（秒），默认1/60秒与交互模式一致
+     */
+    explicit HeadlessSim(float fixedDt = 1.0f / 60.0f);
+
+    // 安全检查器持有指向player的指针，禁止拷贝
+    HeadlessSim(const HeadlessSim&) = delete;
+    HeadlessSim& operator=(const HeadlessSim&) = delete;
+
+    /**
+     * @brief 开始新回合
+     * @details 生成新关卡，将玩家放回出生点并清空速度、地面和安全状态
+     */
+    void reset();
+
+    /**
+     * @brief 设置关卡库模式
+     * @param bank 已打开的关卡库，reset()按顺序从中取关卡；传nullptr恢复随机生成
+     * @param startIndex 第一个关卡的下标
+     */
+    void setLevelBank(const LevelBank* bank, size_t startIndex = 0) { map.setLevelBank(bank, startIndex); }
+
+    /**
+     * @brief 推进一个固定时间步长
+     * @param action 本步动作
+     * @return 本步结果
+     */
+    StepResult step(const Action& action);
+
+    /**
+     * @brief 运行一个完整回合
+     * @param policy 策略函数
+     * @param maxSteps 最大步数，超过后视为失败
+     * @return 回合结果
+     * @note 调用前需先reset()，结束后不会自动生成下一关
+     */
+    EpisodeResult runEpisode(const Policy& policy, int maxSteps);
+
+    /**
+     * @brief 执行一帧玩家物理更新与平台碰撞响应
+     * @param player 玩家对象
+     * @param map 地图对象
+     * @param dt 时间增量（秒）
+     * @details Game::update与HeadlessSim::step共用此函数，保证两种模式物理行为一致
+     * 使用连续碰撞检测（sweepGridCollision），dt较大时也不会穿过瓦片
+     */
+    static void stepPlayerPhysics(Player& player, const Map& map, float dt);
+
+    /**
+     * @brief 检测玩家是否到达终点
+     * @param player 玩家对象
+     * @param map 地图对象
+     * @return true表示玩家与终点瓦片相交
+     */
+    static bool isTargetReached(const Player& player, const Map& map);
+
+    /**
+     * @brief 检测玩家本步移动过程中是否经过终点
+     * @param player 玩家对象（已移动到本步终点）
+     * @param map 地图对象
+     * @param previousPosition 本步开始时玩家的位置
+     * @return true表示本步扫过的包围盒与终点瓦片相交
+     */
+    static bool isTargetReached(const Player& player, const Map& map, const sf::Vector2f& previousPosition);
+
+    const Player& getPlayer() const { return player; }
+    const Map& getMap() const { return map; }
+    float getFixedDt() const { return fixedDt; }
+    int getEpisodeSteps() const { return episodeSteps; }
+
+private:
+    Map map;
+    Player player;
+    SafetyChecker safetyChecker;
+    SafetyChecker::Handle playerSafetyHandle = SafetyChecker::INVALID_HANDLE;
+    float fixedDt;
+    int episodeSteps = 0;
+};
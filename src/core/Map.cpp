@@ -11,88 +11,120 @@ Map::~Map() {
 }
 
 void Map::resetMap() {
-    levelData.clear();
-    tiles.clear();
+    tileGrid.clear();
+    tileVertices.clear();
+    tileVerticesDirty = true;
     playerPos = sf::Vector2f(-1.0f, -1.0f);
     targetPosition = sf::Vector2f(-1.0f, -1.0f);
 }
 
-void Map::draw(sf::RenderWindow& window)
+void Map::setLevelBank(const LevelBank* bank, size_t startIndex) {
+    levelBank = bank;
+    levelBankCursor = startIndex;
+}
+
+void Map::loadLevel()
 {
-    // 如果关卡数据为空，先获取关卡数据
-    if (levelData.empty()) {
-        levelData = Parser::parseLevel();
-        
-        // 在重新加载后验证地图数据
-        if (!levelData.empty()) {
-            bool hasPlayer = false;
-            for (const auto& row : levelData) {
-                if (row.find('P') != std::string::npos) {
-                    std::cout << "P found" << std::endl;
-                    hasPlayer = true;
-                    break;
-                }
-            }
-            
-            if (!hasPlayer) {
-                std::cout << "Warning: Map has no player starting position character 'P'" << std::endl;
+    // 已有关卡时保持不变，resetMap清空网格后才取新关卡
+    if (!tileGrid.empty()) {
+        return;
+    }
+
+    // 关卡库模式：直接定位下一条记录，跳过随机游走和墙检测
+    if (levelBank && levelBank->size() > 0) {
+        size_t index = levelBankCursor++ % levelBank->size();
+        const LevelBank::RecordHeader& record = levelBank->getRecord(index);
+
+        levelBank->loadLevel(index, tileGrid);
+        levelSeed = record.seed;
+        playerPos = sf::Vector2f(record.playerX * TILE, record.playerY * TILE);
+        targetPosition = sf::Vector2f(record.targetX * TILE, record.targetY * TILE);
+        tileVerticesDirty = true;
+        return;
+    }
+
+    // 随机生成：字符数据只是生成器的临时输出，转换为瓦片网格后即丢弃
+    levelSeed = Parser::randomSeed();
+    std::vector<std::string> levelData = Parser::parseLevel(levelSeed);
+
+    // 验证地图数据
+    if (!levelData.empty()) {
+        bool hasPlayer = false;
+        for (const auto& row : levelData) {
+            if (row.find('P') != std::string::npos) {
+                std::cout << "P found" << std::endl;
+                hasPlayer = true;
+                break;
             }
         }
+
+        if (!hasPlayer) {
+            std::cout << "Warning: Map has no player starting position character 'P'" << std::endl;
+        }
     }
 
-    // 清空现有瓦片
-    tiles.clear();
-    
-    // 遍历关卡数据的二维网格，创建对应的游戏对象
-    // y坐标：行索引，对应游戏世界的垂直位置
-    for (size_t y = 0; y < levelData.size(); ++y) {
-        // x坐标：列索引，对应游戏世界的水平位置
-        for (size_t x = 0; x < levelData[y].size(); ++x) {
-            char c = levelData[y][x];  // 获取当前单元格的标识字符
-            
-            // 瓦片创建部分，根据字符创建不同类型的瓦片
-            // '1'表示创建固体瓦片(黑色方块)  'W'表示创建墙瓦片(青色方块)  '3'表示创建墙顶瓦片(青色方块)  '4'表示创建墙底瓦片(青色方块)
-            if (c == '1' || c == 'W' || c == '3' || c == '4') {
-                // 创建瓦片对象，大小为TILE x TILE像素
-                sf::RectangleShape tile({static_cast<float>(TILE), static_cast<float>(TILE)});
-                // 设置瓦片位置：网格坐标(x,y)转换为像素坐标
-                tile.setPosition(static_cast<float>(x * TILE), static_cast<float>(y * TILE));
-                tile.setFillColor(sf::Color::Black);  // 设置瓦片颜色为黑色
-                tiles.emplace_back(tile);  // 添加到瓦片列表
-            } 
-            else if (c == 'M')
-            {
-                // 创建被标记的瓦片
-                sf::RectangleShape tile({static_cast<float>(TILE), static_cast<float>(TILE)});
-                tile.setPosition(static_cast<float>(x * TILE), static_cast<float>(y * TILE));
-                tile.setFillColor(sf::Color::Red);  // 设置瓦片颜色为红色
-                tiles.emplace_back(tile);  // 添加到瓦片列表
-            }
-            else if (std::string("0PTEI").find(c) != std::string::npos)
-            {
-                // 创建空白瓦片（用于渲染但排除碰撞）
-                sf::RectangleShape tile({static_cast<float>(TILE), static_cast<float>(TILE)});
-                tile.setPosition(static_cast<float>(x * TILE), static_cast<float>(y * TILE));
-                tile.setFillColor(sf::Color::Transparent);  // 透明标记 Transparent (暂时设定为黄色用于辨识)
-                tiles.emplace_back(tile);  // 添加到瓦片列表
-            }
-            
-            // 实体创建部分
-            // 'P'表示玩家起始位置
-            if (c == 'P') {
+    tileGrid.build(levelData);
+    locateSpawnAndTarget();
+    tileVerticesDirty = true;
+}
+
+void Map::locateSpawnAndTarget()
+{
+    // 遍历瓦片网格，记录实体位置（网格坐标转换为像素坐标）
+    for (int y = 0; y < tileGrid.getHeight(); ++y) {
+        for (int x = 0; x < tileGrid.getWidth(); ++x) {
+            TileKind kind = tileGrid.kindAt(x, y);
+            // 玩家起始位置
+            if (kind == TileKind::Player) {
                 playerPos = sf::Vector2f(x * TILE, y * TILE);
-                // std::cout << "Player: (" << x * TILE << ", " << y * TILE << ")" << std::endl;
-            } 
-            // 'T'表示目标点位置(终点)
-            else if (c == 'T') {
-                // 记录目标点像素坐标
+            }
+            // 目标点位置(终点)
+            else if (kind == TileKind::Target) {
                 targetPosition = sf::Vector2f(x * TILE, y * TILE);
             }
         }
     }
+}
+
+void Map::buildTileVertices()
+{
+    tileVertices.clear();
+    tileVertices.setPrimitiveType(sf::Quads);
+
+    // 固体/墙/墙顶/墙底为黑色，被标记的方块为红色
+    // 空白、出生点、终点、敌人、物品为透明瓦片，绘制结果不可见，直接跳过
+    for (int y = 0; y < tileGrid.getHeight(); ++y) {
+        for (int x = 0; x < tileGrid.getWidth(); ++x) {
+            if (!tileGrid.isSolid(x, y)) continue;
+
+            sf::Color color = tileGrid.kindAt(x, y) == TileKind::Marked ? sf::Color::Red : sf::Color::Black;
+            float left = static_cast<float>(x * TILE);
+            float top = static_cast<float>(y * TILE);
+            float right = left + TILE;
+            float bottom = top + TILE;
+
+            tileVertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+            tileVertices.append(sf::Vertex(sf::Vector2f(right, top), color));
+            tileVertices.append(sf::Vertex(sf::Vector2f(right, bottom), color));
+            tileVertices.append(sf::Vertex(sf::Vector2f(left, bottom), color));
+        }
+    }
+
+    tileVerticesDirty = false;
+}
+
+void Map::draw(sf::RenderWindow& window)
+{
+    // 尚未加载关卡时先加载
+    if (tileGrid.empty()) {
+        loadLevel();
+    }
 
-    // 绘制所有瓦片
-    for (const auto& tile : tiles) {
-        window.draw(tile);
+    // 关卡变化后重建几何缓存
+    if (tileVerticesDirty) {
+        buildTileVertices();
     }
+
+    // 一次调用绘制所有瓦片
+    window.draw(tileVertices);
 }
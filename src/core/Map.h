@@ -6,29 +6,70 @@
 #include <string>
 
 #include "../world/Parser.h"
+#include "../world/TileGrid.h"
+#include "../world/LevelBank.h"
 
 class Map {
 private:
-    /** @brief 关卡数据二维网格 */
-    std::vector<std::string> levelData;
-    /** @brief 地图瓦片集合 */
-    std::vector<sf::RectangleShape> tiles;
+    /** @brief 扁平瓦片网格（关卡的唯一存储，碰撞、射线检测、安全检测和渲染共同查询） */
+    TileGrid tileGrid;
+    /**
+     * @brief 静态瓦片几何缓存（渲染专用）
+     * @details 每个可见瓦片4个顶点（sf::Quads），每个关卡只构建一次，一次draw调用绘制
+     * 与碰撞数据（tileGrid）相互独立
+     */
+    sf::VertexArray tileVertices{sf::Quads};
+    /** @brief 几何缓存是否需要重建（关卡变化后置位，首次绘制时重建） */
+    bool tileVerticesDirty = true;
     
     sf::Vector2f playerPos = sf::Vector2f(0.0f, 0.0f);
 
     /** @brief 目标点位置（玩家需要到达的位置） */
     sf::Vector2f targetPosition = sf::Vector2f(-1.0f, -1.0f);
 
+    /** @brief 关卡库（非空时按顺序从关卡库取关卡，不再随机生成） */
+    const LevelBank* levelBank = nullptr;
+    /** @brief 关卡库中下一个关卡的下标 */
+    size_t levelBankCursor = 0;
+    /** @brief 当前关卡的种子（相同难度和Parser::GENERATOR_VERSION下，Parser::parseLevel(seed)可重新生成同一关卡） */
+    uint32_t levelSeed = 0;
+
+    /** @brief 根据瓦片网格记录玩家/目标位置 */
+    void locateSpawnAndTarget();
+
+    /** @brief 根据瓦片网格重建渲染几何缓存 */
+    void buildTileVertices();
+
 public:
     Map();
     ~Map();
 
+    /**
+     * @brief 加载关卡并构建瓦片网格（不依赖窗口）
+     * @details 瓦片网格为空（resetMap之后）时取新关卡：设置了关卡库时O(1)取出下一条记录直接解码到网格，
+     * 否则用新的随机种子从Parser生成，字符数据只作为临时结果转换为网格，供无窗口模拟直接使用
+     * 已有关卡时不做任何事；取新关卡后将渲染几何缓存标记为待重建
+     */
+    void loadLevel();
+
+    /**
+     * @brief 绘制地图
+     * @details 只在关卡变化后重建一次几何缓存，之后每帧一次draw调用
+     */
     void draw(sf::RenderWindow& window);
     void resetMap();
-    const std::vector<std::string>& getLevelData() const { return levelData; }
-    const std::vector<sf::RectangleShape>& getTiles() const { return tiles; }
+
+    /**
+     * @brief 设置关卡库模式
+     * @param bank 已打开的关卡库，传nullptr恢复随机生成（须在Map使用期间保持有效）
+     * @param startIndex 第一个关卡的下标，之后依次递增并循环
+     */
+    void setLevelBank(const LevelBank* bank, size_t startIndex = 0);
+
+    const TileGrid& getTileGrid() const { return tileGrid; }
     const sf::Vector2f& getPlayerPos() const { return playerPos; }
     const sf::Vector2f& getTargetPosition() const { return targetPosition; }
+    uint32_t getLevelSeed() const { return levelSeed; }
 };
 
 
@@ -13,7 +13,6 @@ const sf::Color BACKGROUND_COLOR = sf::Color(100, 149, 237); // 天蓝色
 const sf::Color TARGET_COLOR = sf::Color::Red;
 const sf::Color PLAYER_SPAWN_COLOR = sf::Color(255, 255, 0); // 黄色
 const sf::Color DANGER_WARNING_COLOR = sf::Color(255, 0, 0); // 红色
-const sf::Color WALL_MARKER_COLOR = sf::Color(0, 255, 255); // 青色 - 墙标记颜色
 
 Renderer::Renderer() : initialized(false), playerInDanger(false), dangerTimer(0.0f) {
 }
@@ -51,7 +50,7 @@ void Renderer::renderMainWindow(sf::RenderWindow& window,
                               float gameTime, 
                               float fps,
                               bool showRayDebug,
-                              const std::vector<RayHitInfo>& rayHits) {
+                              const RayObservation& observation) {
     
     sf::Vector2u windowSize = window.getSize();
     
@@ -82,8 +81,7 @@ void Renderer::renderMainWindow(sf::RenderWindow& window,
     
     // 渲染射线调试信息
     if (showRayDebug) {
-        sf::Vector2f playerPos = player.getPosition() + sf::Vector2f(TILE/2, TILE/2);
-        renderRayDebug(window, ui, rayHits, playerPos);
+        renderRayDebug(window, ui, observation.rays, observation.origin);
     }
     
     // 渲染危险警告
@@ -115,12 +113,6 @@ void Renderer::setDangerState(bool isInDanger, float timer) {
 
 void Renderer::renderMap(sf::RenderWindow& window, Map& map) {
     map.draw(window);
-    
-    // 获取地图数据并渲染墙标记
-    const std::vector<std::string>& mapData = map.getLevelData();
-    if (!mapData.empty()) {
-        renderWallMarkers(window, map, mapData);
-    }
 }
 
 void Renderer::renderPlayer(sf::RenderWindow& window, Player& player, UI& ui) {
@@ -186,13 +178,18 @@ void Renderer::renderRayDebug(sf::RenderWindow& window,
             
             // 如果射线命中障碍物，记录命中的瓦片
             if (hit.hit) {
-                int tileX = static_cast<int>(hit.hitPoint.x / TILE);
-                int tileY = static_cast<int>(hit.hitPoint.y / TILE);
-                hitTiles.insert(std::make_pair(static_cast<int>(tileX), static_cast<int>(tileY)));
+                if (hit.hitType == RayHitType::Tile) {
+                    int tileX = static_cast<int>(hit.hitPoint.x / TILE);
+                    int tileY = static_cast<int>(hit.hitPoint.y / TILE);
+                    hitTiles.insert(std::make_pair(static_cast<int>(tileX), static_cast<int>(tileY)));
+                }
                 
-                // 绘制黄色命中点
+                // 绘制命中点：瓦片黄色，敌人红色，子弹橙色，物品青色
                 sf::CircleShape hitPoint(3);
-                hitPoint.setFillColor(sf::Color::Yellow);
+                hitPoint.setFillColor(hit.hitType == RayHitType::Enemy  ? sf::Color::Red
+                                    : hit.hitType == RayHitType::Bullet ? sf::Color(255, 140, 0)
+                                    : hit.hitType == RayHitType::Item   ? sf::Color::Cyan
+                                                                        : sf::Color::Yellow);
                 hitPoint.setPosition(hit.hitPoint.x - 1.5f, hit.hitPoint.y - 1.5f);
                 window.draw(hitPoint);
             }
@@ -253,34 +250,6 @@ void Renderer::renderPlayerSpawnPoint(sf::RenderWindow& window, UI& ui, sf::Vect
     // }
 }
 
-void Renderer::renderWallMarkers(sf::RenderWindow& window, Map& map, const std::vector<std::string>& mapData) {
-    // if (mapData.empty()) return;
-    
-    // int width = mapData[0].size();
-    // int height = mapData.size();
-    
-    // // 创建半透明的青色矩形来标记墙
-    // sf::RectangleShape wallMarker(sf::Vector2f(TILE, TILE));
-    // wallMarker.setFillColor(sf::Color(WALL_MARKER_COLOR.r, WALL_MARKER_COLOR.g, WALL_MARKER_COLOR.b, 128)); // 半透明青色
-    // wallMarker.setOutlineThickness(1);
-    // wallMarker.setOutlineColor(WALL_MARKER_COLOR);
-    
-    // // 遍历地图数据，渲染'W', '3', '4'标记的墙结构
-    // for (int y = 0; y < height; ++y) {
-    //     for (int x = 0; x < width; ++x) {
-    //         if (mapData[y][x] == 'W' || mapData[y][x] == '3' || mapData[y][x] == '4') {
-    //             wallMarker.setPosition(x * TILE, y * TILE);
-    //             if (mapData[y][x] == '3' || mapData[y][x] == '4') {
-    //                 wallMarker.setFillColor(sf::Color(0, 0, 139, 128)); // 深蓝色半透明
-    //             } else {
-    //                 wallMarker.setFillColor(sf::Color(WALL_MARKER_COLOR.r, WALL_MARKER_COLOR.g, WALL_MARKER_COLOR.b, 128));
-    //             }
-    //             window.draw(wallMarker);
-    //         }
-    //     }
-    // }
-}
-
 
 
 
@@ -42,7 +42,7 @@ public:
      * @param gameTime 游戏时间
      * @param fps 帧率
      * @param showRayDebug 是否显示射线调试
-     * @param rayHits 射线碰撞数据
+     * @param observation 射线观测（起点和命中数据）
      */
     void renderMainWindow(sf::RenderWindow& window, 
                         Map& map, 
@@ -51,7 +51,7 @@ public:
                         float gameTime, 
                         float fps,
                         bool showRayDebug,
-                        const std::vector<RayHitInfo>& rayHits);
+                        const RayObservation& observation);
     
     /**
      * @brief 清空屏幕
@@ -147,14 +147,6 @@ private:
      * @brief 渲染玩家出生点标记
      */
     void renderPlayerSpawnPoint(sf::RenderWindow& window, UI& ui, sf::Vector2f& position);
-    
-    /**
-     * @brief 渲染墙标记
-     * @param window SFML渲染窗口
-     * @param map 地图对象
-     * @param wallMap 墙标记信息
-     */
-    void renderWallMarkers(sf::RenderWindow& window, Map& map, const std::vector<std::string>& wallMap);
 
     // 成员变量
     sf::Font font;
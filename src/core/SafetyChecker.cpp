@@ -1,84 +1,105 @@
 #include "SafetyChecker.h"
 #include "../entity/Entity.h"
 #include "Constants.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
-void SafetyChecker::registerEntity(const std::string& entityId, std::function<Entity*()> getter) {
-    entityGetters[entityId] = getter;
+SafetyChecker::Handle SafetyChecker::registerEntity(const Entity* entity) {
+    entities.push_back(entity);
+    safetyStates.emplace_back();
+    return static_cast<Handle>(entities.size() - 1);
 }
 
-Entity* SafetyChecker::getEntity(const std::string& entityId) const {
-    auto it = entityGetters.find(entityId);
-    if (it != entityGetters.end() && it->second) {
-        return it->second();
-    }
-    return nullptr;
-}
-
-bool SafetyChecker::validateSpawnPosition(const std::string& entityId,
-                                        const std::vector<std::string>& levelData,
-                                        const std::vector<sf::RectangleShape>& tiles) {
-    Entity* entity = getEntity(entityId);
-    if (!entity) {
-        std::cerr << "Warning: Entity " << entityId << " not found for spawn validation" << std::endl;
+bool SafetyChecker::validateSpawnPosition(Handle handle, const TileGrid& grid) const {
+    if (!isValidHandle(handle) || !entities[handle]) {
+        std::cerr << "Warning: Entity handle " << handle << " not found for spawn validation" << std::endl;
         return false;
     }
-    
-    return isOnValidGround(*entity, levelData);
+
+    return isOnValidGround(entities[handle]->getBounds(), grid);
 }
 
-SafetyChecker::SafetyResult SafetyChecker::checkPositionSafety(const std::string& entityId,
-                                                               const std::vector<std::string>& levelData,
-                                                               const std::vector<sf::RectangleShape>& tiles) {
-    SafetyResult result;
-    result.isSafe = true;
-    
-    Entity* entity = getEntity(entityId);
-    if (!entity) {
+SafetyChecker::SafetyResult SafetyChecker::checkPositionSafety(Handle handle, const TileGrid& grid) const {
+    if (!isValidHandle(handle) || !entities[handle]) {
+        SafetyResult result;
         result.isSafe = false;
         result.reason = "Entity not found";
         return result;
     }
-    
+
+    return checkBounds(entities[handle]->getBounds(), grid);
+}
+
+SafetyChecker::SafetyResult SafetyChecker::checkBounds(const sf::FloatRect& bounds, const TileGrid& grid) {
+    SafetyResult result;
+
     // 检查是否在地图外
-    if (!isWithinMapBounds(*entity, levelData)) {
+    if (!isWithinMapBounds(bounds, grid)) {
         result.isSafe = false;
+        result.issue = Issue::OutOfBounds;
         result.reason = "Out of map bounds";
         return result;
     }
-    
+
     // 检查是否在地图边缘
-    if (isNearMapEdge(*entity, levelData)) {
+    if (isNearMapEdge(bounds, grid)) {
         result.isSafe = false;
+        result.issue = Issue::NearEdge;
         result.reason = "Near map edge";
         return result;
     }
-    
+
     // 检查实体是否在墙中
-    if (isCollidingWithWall(*entity, tiles)) {
+    if (isCollidingWithWall(bounds, grid)) {
         result.isSafe = false;
+        result.issue = Issue::StuckInWall;
         result.reason = "Entity stuck in wall";
         return result;
     }
-    
+
     return result;
 }
 
-bool SafetyChecker::updateEntitySafety(const std::string& entityId,
-                                     const std::vector<std::string>& levelData,
-                                     const std::vector<sf::RectangleShape>& tiles,
-                                     float dt) {
-    Entity* entity = getEntity(entityId);
-    if (!entity) {
+void SafetyChecker::checkBatch(const float* x, const float* y, float width, float height, int count,
+                               const TileGrid& grid, Issue* issues) {
+    for (int i = 0; i < count; ++i) {
+        issues[i] = checkBounds(sf::FloatRect(x[i], y[i], width, height), grid).issue;
+    }
+}
+
+bool SafetyChecker::updateEntitySafety(Handle handle, const TileGrid& grid, float dt) {
+    if (!isValidHandle(handle) || !entities[handle]) {
         return false;
     }
-    
-    auto& safety = entitySafetyMap[entityId];
-    
+
     // 检查当前位置安全性
-    auto result = checkPositionSafety(entityId, levelData, tiles);
-    
-    if (!result.isSafe) {
+    const Entity& entity = *entities[handle];
+    SafetyResult result = checkBounds(entity.getBounds(), grid);
+
+    if (advanceDangerTimer(safetyStates[handle], result.isSafe, entity.getPosition(), dt)) {
+        std::cerr << "Warning: entity " << handle << " in dangerous position for "
+                 << DANGER_RESET_TIME << " seconds (" << result.reason << "), resetting position..." << std::endl;
+        return true; // 需要重置位置
+    }
+
+    return false; // 不需要重置位置
+}
+
+int SafetyChecker::updateAll(const TileGrid& grid, float dt, uint8_t* needsReset) {
+    int resetCount = 0;
+    for (Handle handle = 0; handle < entityCount(); ++handle) {
+        bool reset = updateEntitySafety(handle, grid, dt);
+        resetCount += reset ? 1 : 0;
+        if (needsReset) {
+            needsReset[handle] = reset ? 1 : 0;
+        }
+    }
+    return resetCount;
+}
+
+bool SafetyChecker::advanceDangerTimer(EntitySafety& safety, bool isSafe, const sf::Vector2f& position, float dt) {
+    if (!isSafe) {
         if (!safety.isInDanger) {
             // 首次检测到危险位置
             safety.isInDanger = true;
@@ -87,114 +108,93 @@ bool SafetyChecker::updateEntitySafety(const std::string& entityId,
             // 累积危险时间
             safety.dangerTimer += dt;
             if (safety.dangerTimer >= DANGER_RESET_TIME) {
-                std::cerr << "Warning: " << entityId << " in dangerous position for " 
-                         << DANGER_RESET_TIME << " seconds, resetting position..." << std::endl;
-                return true; // 需要重置位置
+                return true;
             }
         }
     } else {
         // 位置安全，重置计时器并记录安全位置
         safety.isInDanger = false;
         safety.dangerTimer = 0.0f;
-        safety.lastSafePosition = entity->getPosition();
+        safety.lastSafePosition = position;
     }
-    
-    return false; // 不需要重置位置
+
+    return false;
 }
 
-SafetyChecker::EntitySafety SafetyChecker::getEntitySafety(const std::string& entityId) const {
-    auto it = entitySafetyMap.find(entityId);
-    if (it != entitySafetyMap.end()) {
-        return it->second;
-    }
-    return EntitySafety(); // 返回默认安全状态
+const SafetyChecker::EntitySafety& SafetyChecker::getEntitySafety(Handle handle) const {
+    static const EntitySafety defaultSafety;
+    return isValidHandle(handle) ? safetyStates[handle] : defaultSafety; // 无效句柄返回默认安全状态
 }
 
-void SafetyChecker::resetEntitySafety(const std::string& entityId) {
-    entitySafetyMap.erase(entityId);
+void SafetyChecker::resetEntitySafety(Handle handle) {
+    if (isValidHandle(handle)) {
+        safetyStates[handle] = EntitySafety();
+    }
 }
 
 void SafetyChecker::clearAllEntities() {
-    entitySafetyMap.clear();
-    entityGetters.clear();
+    entities.clear();
+    safetyStates.clear();
 }
 
 // 私有辅助函数
-bool SafetyChecker::isWithinMapBounds(const Entity& entity, 
-                                    const std::vector<std::string>& levelData) const {
-    sf::Vector2f pos = entity.getPosition();
-    float mapWidth = levelData[0].size() * TILE;
-    float mapHeight = levelData.size() * TILE;
-    
-    sf::FloatRect bounds = getEntityBounds(entity);
-    
-    return (bounds.left >= 0 && bounds.top >= 0 && 
-            bounds.left + bounds.width <= mapWidth && 
+bool SafetyChecker::isWithinMapBounds(const sf::FloatRect& bounds, const TileGrid& grid) {
+    float mapWidth = grid.getWidth() * TILE;
+    float mapHeight = grid.getHeight() * TILE;
+
+    return (bounds.left >= 0 && bounds.top >= 0 &&
+            bounds.left + bounds.width <= mapWidth &&
             bounds.top + bounds.height <= mapHeight);
 }
 
-bool SafetyChecker::isNearMapEdge(const Entity& entity, 
-                                const std::vector<std::string>& levelData) const {
-    sf::Vector2f pos = entity.getPosition();
-    float mapWidth = levelData[0].size() * TILE;
-    float mapHeight = levelData.size() * TILE;
-    
-    sf::FloatRect bounds = getEntityBounds(entity);
+bool SafetyChecker::isNearMapEdge(const sf::FloatRect& bounds, const TileGrid& grid) {
+    float mapWidth = grid.getWidth() * TILE;
+    float mapHeight = grid.getHeight() * TILE;
     float edgeThreshold = TILE * EDGE_THRESHOLD;
-    
-    return (bounds.left < edgeThreshold || 
+
+    return (bounds.left < edgeThreshold ||
             bounds.left + bounds.width > mapWidth - edgeThreshold ||
-            bounds.top < edgeThreshold || 
+            bounds.top < edgeThreshold ||
             bounds.top + bounds.height > mapHeight - edgeThreshold);
 }
 
-bool SafetyChecker::isCollidingWithWall(const Entity& entity, 
-                                      const std::vector<sf::RectangleShape>& tiles) const {
-    sf::FloatRect entityBounds = getEntityBounds(entity);
-    
-    for (const auto& tile : tiles) {
-        // 只检测黑色墙壁方块
-        if (tile.getFillColor() == sf::Color::Black) {
-            sf::FloatRect tileBounds = tile.getGlobalBounds();
-            if (entityBounds.intersects(tileBounds)) {
+bool SafetyChecker::isCollidingWithWall(const sf::FloatRect& bounds, const TileGrid& grid) {
+    if (bounds.width <= 0 || bounds.height <= 0) {
+        return false;
+    }
+
+    // 只检测与包围盒严格相交的格子（与FloatRect::intersects一致，边缘接触不算）
+    int leftGridX = std::max(0, static_cast<int>(std::floor(bounds.left / TILE)));
+    int topGridY = std::max(0, static_cast<int>(std::floor(bounds.top / TILE)));
+    int rightGridX = std::min(grid.getWidth() - 1,
+                              static_cast<int>(std::ceil((bounds.left + bounds.width) / TILE)) - 1);
+    int bottomGridY = std::min(grid.getHeight() - 1,
+                               static_cast<int>(std::ceil((bounds.top + bounds.height) / TILE)) - 1);
+
+    for (int gridY = topGridY; gridY <= bottomGridY; ++gridY) {
+        for (int gridX = leftGridX; gridX <= rightGridX; ++gridX) {
+            // 只检测墙壁方块（'1' 'W' '3' '4'），被标记的方块不算
+            if (grid.isSolid(gridX, gridY) && grid.kindAt(gridX, gridY) != TileKind::Marked) {
                 return true;
             }
         }
     }
-    
+
     return false;
 }
 
-bool SafetyChecker::isOnValidGround(const Entity& entity, 
-                                  const std::vector<std::string>& levelData) const {
-    sf::FloatRect bounds = getEntityBounds(entity);
-    
+bool SafetyChecker::isOnValidGround(const sf::FloatRect& bounds, const TileGrid& grid) {
     // 检查实体所在网格位置
     int leftGridX = static_cast<int>(bounds.left / TILE);
     int rightGridX = static_cast<int>((bounds.left + bounds.width - 1) / TILE);
     int bottomGridY = static_cast<int>((bounds.top + bounds.height - 1) / TILE);
-    
-    int actualWidth = static_cast<int>(levelData[0].size());
-        int actualHeight = static_cast<int>(levelData.size());
-    
+
     // 检查实体覆盖的所有网格位置
     for (int gridX = leftGridX; gridX <= rightGridX; ++gridX) {
-        if (gridX >= 0 && gridX < actualWidth && bottomGridY >= 0 && bottomGridY < actualHeight) {
-            char groundChar = levelData[bottomGridY][gridX];
-            if (groundChar == '0' || groundChar == 'P' || groundChar == 'E' || groundChar == 'I') {
-                return true;
-            }
+        if (grid.inBounds(gridX, bottomGridY) && TileGrid::isGroundKind(grid.kindAt(gridX, bottomGridY))) {
+            return true;
         }
     }
-    
-    return false;
-}
 
-sf::Vector2f SafetyChecker::getEntityCenter(const Entity& entity) const {
-    sf::FloatRect bounds = getEntityBounds(entity);
-    return sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+    return false;
 }
-
-sf::FloatRect SafetyChecker::getEntityBounds(const Entity& entity) const {
-    return entity.getBounds();
-}
\ No newline at end of file
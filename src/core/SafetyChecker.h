@@ -1,24 +1,38 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
-#include <string>
-#include <unordered_map>
-#include <functional>
 #include "../core/Constants.h"
+#include "../world/TileGrid.h"
 
 class Entity;
 
 /**
  * @brief 安全检测器类
  * 负责检测实体位置的安全性，防止出现卡住或掉出地图的情况
- * 通过实体接口获取位置、形状、尺寸等信息，避免手动计算
+ * 实体注册后得到一个句柄（稠密数组下标），之后的查询和更新都按下标直接访问，
+ * 不做字符串哈希，也不经过std::function回调
+ * 越界、边缘和卡墙检测都只做网格坐标运算，卡墙检测只查询包围盒覆盖的格子
  */
 class SafetyChecker {
 public:
+    /** @brief 实体句柄（registerEntity返回的稠密数组下标） */
+    using Handle = int;
+    static constexpr Handle INVALID_HANDLE = -1;
+
+    /** @brief 不安全的原因 */
+    enum class Issue : uint8_t {
+        None = 0,       // 安全
+        OutOfBounds,    // 在地图外
+        NearEdge,       // 在地图边缘
+        StuckInWall     // 卡在墙中
+    };
+
     struct SafetyResult {
         bool isSafe = true;
-        std::string reason = "";
+        Issue issue = Issue::None;
+        const char* reason = "";
     };
 
     struct EntitySafety {
@@ -28,79 +42,115 @@ public:
     };
 
     SafetyChecker() = default;
-    
+
     /**
-     * @brief 注册实体获取函数
-     * @param entityId 实体ID
-     * @param getter 获取实体对象的函数
+     * @brief 注册实体
+     * @param entity 实体对象（须在检测器使用期间保持有效）
+     * @return 实体句柄，之后的查询和更新都使用该句柄
      */
-    void registerEntity(const std::string& entityId, std::function<Entity*()> getter);
+    Handle registerEntity(const Entity* entity);
 
     /**
      * @brief 验证生成位置是否有效
-     * @param entityId 实体ID
-     * @param levelData 关卡数据
-     * @param tiles 瓦片集合
+     * @param handle 实体句柄
+     * @param grid 关卡瓦片网格
      * @return 位置是否有效
      */
-    bool validateSpawnPosition(const std::string& entityId,
-                              const std::vector<std::string>& levelData,
-                              const std::vector<sf::RectangleShape>& tiles);
+    bool validateSpawnPosition(Handle handle, const TileGrid& grid) const;
 
     /**
      * @brief 检查位置安全性
-     * @param entityId 实体ID
-     * @param levelData 关卡数据
-     * @param tiles 瓦片集合
+     * @param handle 实体句柄
+     * @param grid 关卡瓦片网格
      * @return 安全检查结果
      */
-    SafetyResult checkPositionSafety(const std::string& entityId,
-                                   const std::vector<std::string>& levelData,
-                                   const std::vector<sf::RectangleShape>& tiles);
+    SafetyResult checkPositionSafety(Handle handle, const TileGrid& grid) const;
+
+    /**
+     * @brief 检查包围盒安全性（不需要注册实体）
+     * @param bounds 包围盒（像素）
+     * @param grid 关卡瓦片网格
+     * @return 安全检查结果，依次检查越界、边缘和卡墙
+     */
+    static SafetyResult checkBounds(const sf::FloatRect& bounds, const TileGrid& grid);
+
+    /**
+     * @brief 批量检查位置安全性（结构体数组布局）
+     * @param x 包围盒左上角X坐标数组
+     * @param y 包围盒左上角Y坐标数组
+     * @param width 包围盒宽度（所有实体相同）
+     * @param height 包围盒高度（所有实体相同）
+     * @param count 实体数量
+     * @param grid 关卡瓦片网格
+     * @param issues 输出：每个实体的检查结果（Issue），长度为count
+     * @note 适用于批量模拟等共享同一关卡的大量实体
+     */
+    static void checkBatch(const float* x, const float* y, float width, float height, int count,
+                           const TileGrid& grid, Issue* issues);
 
     /**
      * @brief 更新实体安全状态
-     * @param entityId 实体ID
-     * @param levelData 关卡数据
-     * @param tiles 瓦片集合
+     * @param handle 实体句柄
+     * @param grid 关卡瓦片网格
      * @param dt 时间增量
      * @return 是否需要重置位置
      */
-    bool updateEntitySafety(const std::string& entityId,
-                          const std::vector<std::string>& levelData,
-                          const std::vector<sf::RectangleShape>& tiles,
-                          float dt);
+    bool updateEntitySafety(Handle handle, const TileGrid& grid, float dt);
+
+    /**
+     * @brief 更新所有已注册实体的安全状态
+     * @param grid 关卡瓦片网格
+     * @param dt 时间增量
+     * @param needsReset 可选输出：每个实体是否需要重置位置（0/1），长度为entityCount()
+     * @return 需要重置位置的实体数量
+     */
+    int updateAll(const TileGrid& grid, float dt, uint8_t* needsReset = nullptr);
+
+    /**
+     * @brief 根据本帧检查结果推进危险计时
+     * @param safety 实体安全状态
+     * @param isSafe 本帧是否安全
+     * @param position 实体当前位置（安全时记录为最后安全位置）
+     * @param dt 时间增量
+     * @return 危险状态持续超过DANGER_RESET_TIME时返回true
+     */
+    static bool advanceDangerTimer(EntitySafety& safety, bool isSafe, const sf::Vector2f& position, float dt);
 
     /**
      * @brief 获取实体安全状态
-     * @param entityId 实体ID
+     * @param handle 实体句柄
      * @return 安全状态信息
      */
-    EntitySafety getEntitySafety(const std::string& entityId) const;
+    const EntitySafety& getEntitySafety(Handle handle) const;
 
     /**
      * @brief 重置实体安全状态
-     * @param entityId 实体ID
+     * @param handle 实体句柄
      */
-    void resetEntitySafety(const std::string& entityId);
+    void resetEntitySafety(Handle handle);
 
     /**
-     * @brief 清除所有实体安全记录
+     * @brief 清除所有实体（之前返回的句柄全部失效）
      */
     void clearAllEntities();
 
-private:
-    std::unordered_map<std::string, EntitySafety> entitySafetyMap;
-    std::unordered_map<std::string, std::function<Entity*()>> entityGetters;
-    
+    /** @brief 已注册实体数量 */
+    int entityCount() const { return static_cast<int>(entities.size()); }
+
     static constexpr float EDGE_THRESHOLD = 2.0f;   // 边缘安全距离（瓦片数）
     static constexpr float DANGER_RESET_TIME = 2.0f;  // 2秒后重置位置
 
-    Entity* getEntity(const std::string& entityId) const;
-    bool isWithinMapBounds(const Entity& entity, const std::vector<std::string>& levelData) const;
-    bool isNearMapEdge(const Entity& entity, const std::vector<std::string>& levelData) const;
-    bool isCollidingWithWall(const Entity& entity, const std::vector<sf::RectangleShape>& tiles) const;
-    bool isOnValidGround(const Entity& entity, const std::vector<std::string>& levelData) const;
-    sf::Vector2f getEntityCenter(const Entity& entity) const;
-    sf::FloatRect getEntityBounds(const Entity& entity) const;
-};
\ No newline at end of file
+private:
+    // 按句柄下标对应的稠密数组
+    std::vector<const Entity*> entities;
+    std::vector<EntitySafety> safetyStates;
+
+    bool isValidHandle(Handle handle) const {
+        return handle >= 0 && handle < static_cast<Handle>(entities.size());
+    }
+
+    static bool isWithinMapBounds(const sf::FloatRect& bounds, const TileGrid& grid);
+    static bool isNearMapEdge(const sf::FloatRect& bounds, const TileGrid& grid);
+    static bool isCollidingWithWall(const sf::FloatRect& bounds, const TileGrid& grid);
+    static bool isOnValidGround(const sf::FloatRect& bounds, const TileGrid& grid);
+};
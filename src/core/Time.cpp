@@ -9,6 +9,7 @@
  * - 暂停时间初始化为0
  * - 时间增量初始化为0
  * - 固定时间步长设置为1/60秒（60FPS）
+ * - 倍速为1（实时），单帧最多1000个模拟步
  * - FPS初始化为0
  * - 帧计数器初始化为0
  * - 暂停状态设置为false
@@ -18,6 +19,11 @@ TimeManager::TimeManager()
     , totalPausedTime(0.0f)
     , deltaTime(0.0f)
     , fixedTimeStep(1.0f / 60.0f)  // 默认60FPS
+    , accumulator(0.0f)
+    , timeScale(1.0f)
+    , uncapped(false)
+    , maxStepsPerFrame(1000)
+    , simSteps(0)
     , fps(0)
     , frameCount(0)
     , paused(false) {
@@ -31,21 +37,15 @@ TimeManager::TimeManager()
  * @brief 更新时间管理器
  * 
  * 每帧调用一次，更新所有时间相关的计算：
- * 1. 计算上一帧的时间增量
- * 2. 应用固定时间步长限制
- * 3. 更新游戏时间（排除暂停时间）
- * 4. 更新FPS计算
- * 5. 递增帧计数器
+ * 1. 计算上一帧的时间增量（真实时间，由consumeFixedSteps换算为模拟步）
+ * 2. 更新游戏时间（排除暂停时间）
+ * 3. 更新FPS计算
+ * 4. 递增帧计数器
  */
 void TimeManager::update() {
     // 计算上一帧的时间增量
     deltaTime = deltaClock.restart().asSeconds();
     
-    // 应用固定时间步长限制
-    if (deltaTime > fixedTimeStep) {
-        deltaTime = fixedTimeStep;
-    }
-    
     // 更新游戏时间（排除暂停时间）
     if (!paused) {
         gameTime = gameClock.getElapsedTime().asSeconds() - totalPausedTime;
@@ -63,6 +63,7 @@ void TimeManager::update() {
  * - 重置所有时钟
  * - 重置游戏时间为0
  * - 重置暂停时间为0
+ * - 重置累加器和模拟时间
  * - 重置FPS和帧计数器
  */
 void TimeManager::reset() {
@@ -75,6 +76,8 @@ void TimeManager::reset() {
     gameTime = 0.0f;
     totalPausedTime = 0.0f;
     deltaTime = 0.0f;
+    accumulator = 0.0f;
+    simSteps = 0;
     fps = 0;
     frameCount = 0;
 }
@@ -141,14 +144,115 @@ bool TimeManager::isPaused() const {
 /**
  * @brief 设置固定时间步长
  * 
- * @param step 最大允许的时间步长（秒）
+ * @param step 每个模拟步的时长（秒）
  * 
- * 用于限制最大帧时间，防止在帧率过低时出现大的时间跳跃。
+ * 物理更新始终使用该步长，与渲染帧率无关。
  */
 void TimeManager::setFixedTimeStep(float step) {
     fixedTimeStep = std::max(0.001f, step);  // 确保最小值为1毫秒
 }
 
+/**
+ * @brief 获取固定时间步长
+ * 
+ * @return 每个模拟步的时长（秒）
+ */
+float TimeManager::getFixedTimeStep() const {
+    return fixedTimeStep;
+}
+
+/**
+ * @brief 计算本帧应执行的模拟步数
+ * 
+ * @return 本帧模拟步数，-1表示不限速
+ */
+int TimeManager::consumeFixedSteps() {
+    if (paused) {
+        accumulator = 0.0f;
+        return 0;
+    }
+    
+    if (uncapped) {
+        accumulator = 0.0f;
+        return -1;
+    }
+    
+    accumulator += deltaTime * timeScale;
+    int steps = static_cast<int>(accumulator / fixedTimeStep);
+    
+    // 单帧步数上限：跟不上时丢弃积压的时间，避免越积越多
+    if (steps > maxStepsPerFrame) {
+        steps = maxStepsPerFrame;
+        accumulator = 0.0f;
+    } else {
+        accumulator -= steps * fixedTimeStep;
+    }
+    
+    return steps;
+}
+
+/**
+ * @brief 记录一个已执行的模拟步
+ */
+void TimeManager::advanceSimStep() {
+    simSteps++;
+}
+
+/**
+ * @brief 获取累计模拟时间
+ * 
+ * @return 已执行模拟步数 × 固定时间步长（秒）
+ */
+float TimeManager::getSimTime() const {
+    return static_cast<float>(simSteps * static_cast<double>(fixedTimeStep));
+}
+
+/**
+ * @brief 设置模拟倍速
+ * 
+ * @param scale 模拟时间与真实时间之比，限制在[0.1, 1000]
+ */
+void TimeManager::setTimeScale(float scale) {
+    timeScale = std::clamp(scale, 0.1f, 1000.0f);
+}
+
+/**
+ * @brief 获取模拟倍速
+ * 
+ * @return 模拟时间与真实时间之比
+ */
+float TimeManager::getTimeScale() const {
+    return timeScale;
+}
+
+/**
+ * @brief 设置不限速模式
+ * 
+ * @param enabled true时每帧在帧时间预算内尽可能多地执行模拟步
+ */
+void TimeManager::setUncapped(bool enabled) {
+    uncapped = enabled;
+    accumulator = 0.0f;
+}
+
+/**
+ * @brief 检查是否为不限速模式
+ * 
+ * @return true不限速，false按倍速运行
+ */
+bool TimeManager::isUncapped() const {
+    return uncapped;
+}
+
+/**
+ * @brief 设置单帧最大模拟步数
+ * 
+ * @param steps 单帧最多执行的模拟步数（至少为1）
+ */
+void TimeManager::setMaxStepsPerFrame(int steps) {
+    maxStepsPerFrame = std::max(1, steps);
+}
+
 /**
  * @brief 更新FPS计算
  * 
@@ -7,6 +7,10 @@
  * 
  * 该类负责管理游戏运行时间、FPS计算、暂停状态等时间相关功能。
  * 提供统一的时间接口，避免在多个地方重复实现时间逻辑。
+ * 
+ * 模拟采用固定时间步长：每帧把真实时间增量乘以倍速累加到累加器，
+ * 按固定步长取出整数个模拟步（见consumeFixedSteps）。物理只看到固定步长，
+ * 与渲染帧率无关，相同输入下回合可复现。
  */
 class TimeManager {
 public:
@@ -77,9 +81,80 @@ public:
     /**
      * @brief 设置固定时间步长
      * 
-     * @param step 最大允许的时间步长（秒）
+     * @param step 每个模拟步的时长（秒）
      */
     void setFixedTimeStep(float step);
+    
+    /**
+     * @brief 获取固定时间步长
+     * 
+     * @return 每个模拟步的时长（秒）
+     */
+    float getFixedTimeStep() const;
+    
+    /**
+     * @brief 计算本帧应执行的模拟步数
+     * 
+     * 每帧在update()之后调用一次。暂停时返回0并清空累加器。
+     * - 普通模式：累加器 += 帧时间增量 × 倍速，取出整数个固定步长
+     * - 不限速模式：返回-1，由调用方在帧时间预算内尽可能多地执行模拟步
+     * 单帧步数不超过maxStepsPerFrame，超出部分直接丢弃（模拟变慢而不是越积越多）
+     * 
+     * @return 本帧模拟步数，-1表示不限速
+     */
+    int consumeFixedSteps();
+    
+    /**
+     * @brief 记录一个已执行的模拟步
+     * 
+     * 每执行一次固定步长的逻辑更新调用一次，用于累计模拟时间。
+     */
+    void advanceSimStep();
+    
+    /**
+     * @brief 获取累计模拟时间（秒）
+     * 
+     * @return 已执行模拟步数 × 固定时间步长
+     */
+    float getSimTime() const;
+    
+    /**
+     * @brief 设置模拟倍速
+     * 
+     * @param scale 模拟时间与真实时间之比（1为实时，10为十倍速）
+     */
+    void setTimeScale(float scale);
+    
+    /**
+     * @brief 获取模拟倍速
+     * 
+     * @return 模拟时间与真实时间之比
+     */
+    float getTimeScale() const;
+    
+    /**
+     * @brief 设置不限速模式
+     * 
+     * @param enabled true时每帧在帧时间预算内尽可能多地执行模拟步
+     */
+    void setUncapped(bool enabled);
+    
+    /**
+     * @brief 检查是否为不限速模式
+     * 
+     * @return true不限速，false按倍速运行
+     */
+    bool isUncapped() const;
+    
+    /**
+     * @brief 设置单帧最大模拟步数
+     * 
+     * @param steps 单帧最多执行的模拟步数（至少为1）
+     */
+    void setMaxStepsPerFrame(int steps);
+    
+    /** @brief 不限速模式下每帧用于模拟的真实时间预算（秒），超出后渲染一帧 */
+    static constexpr float UNCAPPED_FRAME_BUDGET = 1.0f / 30.0f;
 
 private:
     sf::Clock gameClock;        ///< 游戏主时钟
@@ -89,7 +164,12 @@ private:
     float gameTime;           ///< 当前游戏时间（秒）
     float totalPausedTime;    ///< 总暂停时间（秒）
     float deltaTime;          ///< 上一帧时间增量（秒）
-    float fixedTimeStep;      ///< 固定时间步长限制
+    float fixedTimeStep;      ///< 固定时间步长（秒）
+    float accumulator;        ///< 尚未消耗的模拟时间（秒）
+    float timeScale;          ///< 模拟倍速
+    bool uncapped;            ///< 不限速模式
+    int maxStepsPerFrame;     ///< 单帧最大模拟步数
+    long long simSteps;       ///< 已执行模拟步数
     
     int fps;                  ///< 当前FPS值
     int frameCount;           ///< 帧计数器
@@ -22,7 +22,7 @@ protected:
     float jumpCooldown = 0.0f;
 
     /** @brief 最大下落速度（像素/秒） */
-    float maxFallSpeed = 500.0f;
+    float maxFallSpeed = MAX_FALL_SPEED;
 
     /** @brief 实体是否在地面上 */
     bool onGround = false;
@@ -106,6 +106,14 @@ public:
      */
     float getHeight() const { return height; }
 
+    /**
+     * @brief 获取实体包围盒中心
+     * @return 位置加半个尺寸（射线观测的统一起点）
+     */
+    sf::Vector2f getCenter() const {
+        return shape.getPosition() + sf::Vector2f(width / 2.0f, height / 2.0f);
+    }
+
     /**
      * @brief 实体跳跃
      * @details 应用向上的速度，受跳跃冷却时间限制
@@ -2,14 +2,14 @@
 #include <SFML/Graphics.hpp>
 
 // 构造函数: 初始化玩家位置和外观
-Player::Player(sf::Vector2f pos) : Entity("player", pos, TILE * 0.8f, TILE * 0.8f) {
+Player::Player(sf::Vector2f pos) : Entity("player", pos, PLAYER_SIZE, PLAYER_SIZE) {
     shape.setFillColor(sf::Color(128, 0, 128)); // 紫色填充 (RGB)
     shape.setOutlineColor(sf::Color(128, 0, 128)); // 紫色轮廓 (RGB)
     
-    maxEnergy = 150.0f;
+    maxEnergy = PLAYER_MAX_ENERGY;
     currentEnergy = maxEnergy;
-    energyConsumptionRate = 100.0f; // 每秒消耗能量
-    energyRegenRate = 500.0f; // 每秒恢复能量
+    energyConsumptionRate = ENERGY_CONSUMPTION_RATE; // 每秒消耗能量
+    energyRegenRate = ENERGY_REGEN_RATE; // 每秒恢复能量
     isFlying = false;
 
 }
@@ -17,6 +17,15 @@ Player::Player(sf::Vector2f pos) : Entity("player", pos, TILE * 0.8f, TILE * 0.8
 // 更新函数: 应用重力并移动玩家
 // 参数: dt - 时间增量(秒)
 void Player::update(float dt){
+    applyForces(dt);
+    integrate(dt);
+
+    // 调用父类的更新函数
+    // Entity::update(dt);
+}
+
+// 施加能量变化和重力，只更新速度
+void Player::applyForces(float dt){
 
     // 飞行能量管理
     // 检查是否在飞行（不在地面上且向上移动）
@@ -37,14 +46,14 @@ void Player::update(float dt){
         velocity.y += GRAVITY * dt;  // 应用重力加速度
 
     }
+}
 
+// 按速度积分位置
+void Player::integrate(float dt){
     // 计算新位置
     sf::Vector2f newPos = shape.getPosition() + velocity * dt;
 
     shape.setPosition(newPos);   // 设置最终位置
-
-    // 调用父类的更新函数
-    // Entity::update(dt);
 }
 
 void Player::handleInput(float dt, bool aiMode, float aiMoveX, bool aiUseEnergy) {
@@ -55,7 +64,7 @@ void Player::handleInput(float dt, bool aiMode, float aiMoveX, bool aiUseEnergy)
         newVelocity.x = aiMoveX * MOVE_SPEED;
         
         if (aiUseEnergy && getCurrentEnergy() > 0) {
-            newVelocity.y = -JUMP_VELOCITY * 0.45f;
+            newVelocity.y = -JUMP_VELOCITY * FLY_VELOCITY_FACTOR;
         }
     } else {
         // 键盘控制模式
@@ -69,7 +78,7 @@ void Player::handleInput(float dt, bool aiMode, float aiMoveX, bool aiUseEnergy)
         
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
             if (getCurrentEnergy() > 0) {
-                newVelocity.y = -JUMP_VELOCITY * 0.45f;
+                newVelocity.y = -JUMP_VELOCITY * FLY_VELOCITY_FACTOR;
             }
         }
     }
@@ -78,3 +87,10 @@ void Player::handleInput(float dt, bool aiMode, float aiMoveX, bool aiUseEnergy)
 }
  
 
+void Player::respawn(sf::Vector2f pos) {
+    setPosition(pos);
+    velocity = sf::Vector2f(0.0f, 0.0f);
+    onGround = false;
+    currentEnergy = maxEnergy;
+    isFlying = false;
+}
@@ -39,8 +39,28 @@ public:
      */
     void update(float dt) override;
     
+    /**
+     * @brief 施加能量消耗/恢复和重力，只更新速度不移动位置
+     * @param dt 时间增量（秒）
+     * @details 与integrate()合起来等价于update()；连续碰撞检测在两者之间按速度扫掠位移
+     */
+    void applyForces(float dt);
+    
+    /**
+     * @brief 按当前速度积分位置（不做碰撞检测）
+     * @param dt 时间增量（秒）
+     */
+    void integrate(float dt);
+    
     void handleInput(float dt, bool aiMode = false, float aiMoveX = 0.0f, bool aiUseEnergy = false);
     
+    /**
+     * @brief 重置玩家到出生状态
+     * @param pos 出生位置
+     * @details 清空速度和地面状态，能量回满
+     */
+    void respawn(sf::Vector2f pos);
+    
     // Getters
     /** @brief 获取当前能量值 */
     float getCurrentEnergy() const { return currentEnergy; }
@@ -1,17 +1,194 @@
 ﻿// =============================================================================
 // 文件名: main.cpp
 // 描述: 程序入口点 - 初始化并启动游戏
-// 功能: 创建游戏实例并运行主循环
+// 功能: 创建游戏实例并运行主循环；传入 --headless <回合数> 时以无窗口模式批量运行回合
+//       传入 --speed <倍速|max> 时以指定模拟倍速运行窗口模式
+//       传入 --bank <关卡库路径> 时从预生成关卡库按顺序取关卡（各模式均可用）
+//       传入 --collect <回合数> 时多线程并行运行回合并导出训练数据，--eval <回合数> 时只统计结果
+//       并行模式可用 --policy <random|scripted|model> 选择策略，--threads <线程数> 指定线程数
+//       无窗口和并行模式可用 --dt <秒> 指定模拟步长（0到1/15秒之间，如0.0667），单回合模拟时间上限不变
+//       窗口和并行模式可用 --ray-layout <uniform|uniform:每象限射线数|adaptive> 选择射线布局，
+//       --ray-recast <k> 让方向固定的射线每k帧轮流重投一次
+//       （模型输入固定为默认布局的特征，非默认布局只用于采集数据，不能与model策略或AI模式同时使用）
 // =============================================================================
 
 #include "core/Game.h"
+#include "core/HeadlessSim.h"
+#include "ai/controller/EpisodeRunner.h"
+#include "ai/controller/FeatureSchema.h"
+#include "ai/pathfinding/RayObserver.h"
+#include "world/LevelBank.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+// 无窗口模式: 使用随机策略运行指定数量的回合并统计吞吐量
+static int runHeadless(int episodes, const std::string& bankPath, float fixedDt) {
+    const int maxEpisodeSteps = static_cast<int>(60.0f / fixedDt);  // 单回合上限：1分钟模拟时间
+
+    HeadlessSim sim(fixedDt);
+    LevelBank bank;
+    if (!bankPath.empty()) {
+        if (!bank.open(bankPath)) {
+            return 1;
+        }
+        sim.setLevelBank(&bank);
+    }
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int> moveDist(-1, 1);
+    std::uniform_int_distribution<int> energyDist(0, 1);
+    HeadlessSim::Policy randomPolicy = [&](const HeadlessSim&) {
+        return HeadlessSim::Action{static_cast<float>(moveDist(rng)), energyDist(rng) == 1};
+    };
+
+    int successes = 0;
+    long long totalSteps = 0;
+    float totalSimTime = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < episodes; ++i) {
+        sim.reset();
+        HeadlessSim::EpisodeResult result = sim.runEpisode(randomPolicy, maxEpisodeSteps);
+        successes += result.success ? 1 : 0;
+        totalSteps += result.steps;
+        totalSimTime += result.simTime;
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[HEADLESS] Episodes: " << episodes
+              << ", Success: " << successes
+              << ", Steps: " << totalSteps << std::endl;
+    std::cout << "[HEADLESS] Wall time: " << wallSeconds << "s, Sim time: " << totalSimTime
+              << "s, Speedup: " << (wallSeconds > 0.0 ? totalSimTime / wallSeconds : 0.0) << "x" << std::endl;
+    return 0;
+}
+
+// 并行模式: 多线程运行回合，collect为true时采集数据并导出训练数据集
+static int runParallel(int episodes, bool collect, const std::string& policyName,
+                       int threads, const std::string& bankPath, float fixedDt,
+                       const RayLayout& rayLayout) {
+    EpisodeRunner::PolicyFactory factory;
+    if (policyName == "random") {
+        uint32_t baseSeed = std::random_device{}();
+        factory = [baseSeed](int) { return std::make_unique<RandomPolicy>(baseSeed); };
+    } else if (policyName == "scripted") {
+        factory = [](int) { return std::make_unique<ScriptedPolicy>(); };
+    } else if (policyName == "model") {
+        if (!rayLayout.matchesModelInput()) {
+            std::cerr << "Policy model needs the default ray layout (the model input has "
+                      << FeatureSchema::FEATURE_COUNT << " features), got " << rayLayout.describe() << std::endl;
+            return 1;
+        }
+        factory = [](int) { return std::make_unique<ModelPolicy>(AI_MODEL_PATH); };
+    } else {
+        std::cerr << "Unknown policy: " << policyName << " (expected random, scripted or model)" << std::endl;
+        return 1;
+    }
+
+    LevelBank bank;
+    EpisodeRunner::Config config;
+    config.threads = threads;
+    config.fixedDt = fixedDt;
+    config.maxSteps = static_cast<int>(60.0f / fixedDt);
+    config.recordFrames = collect;
+    config.rayLayout = rayLayout;
+    if (!bankPath.empty()) {
+        if (!bank.open(bankPath)) {
+            return 1;
+        }
+        config.levelBank = &bank;
+    }
+
+    EpisodeRunner runner(factory, config);
+    DataCollector collector;
+    collector.setEpisodeLimit(0);
+    collector.setRayLayout(rayLayout);
+    std::cout << "[RUNNER] Ray layout: " << rayLayout.describe() << std::endl;
+    EpisodeRunner::Summary summary = runner.run(episodes, collect ? &collector : nullptr);
+
+    std::cout << "[RUNNER] Policy: " << policyName << ", Success rate: "
+              << (summary.episodes > 0 ? 100.0 * summary.successes / summary.episodes : 0.0) << "%"
+              << ", Speedup: " << (summary.wallSeconds > 0.0 ? summary.simSeconds / summary.wallSeconds : 0.0)
+              << "x" << std::endl;
+    if (collect) {
+        collector.exportTrainingDataset("training_dataset.csv");
+    }
+    return 0;
+}
 
 // 主函数: 程序入口
-int main() {
+int main(int argc, char** argv) {
+    int headlessEpisodes = -1;
+    std::string speed;
+    std::string bankPath;
+    int parallelEpisodes = -1;
+    bool collect = false;
+    std::string policyName = "random";
+    int threads = 0;
+    float fixedDt = 1.0f / 60.0f;
+    RayLayout rayLayout;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headlessEpisodes = (i + 1 < argc && argv[i + 1][0] != '-') ? std::stoi(argv[++i]) : 100;
+        } else if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            speed = argv[++i];
+        } else if (std::strcmp(argv[i], "--bank") == 0 && i + 1 < argc) {
+            bankPath = argv[++i];
+        } else if ((std::strcmp(argv[i], "--collect") == 0 || std::strcmp(argv[i], "--eval") == 0) && i + 1 < argc) {
+            collect = std::strcmp(argv[i], "--collect") == 0;
+            parallelEpisodes = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--policy") == 0 && i + 1 < argc) {
+            policyName = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) {
+            fixedDt = std::stof(argv[++i]);
+            // 步长为0或负数时单回合步数上限无意义，超过验证过的粗步长时碰撞不再可靠；
+            // 上限留出1e-4秒，接受四舍五入的写法（1/15秒写作0.0667）
+            if (!(fixedDt > 0.0f && fixedDt <= MAX_FIXED_DT + 1e-4f)) {
+                std::cerr << "Invalid time step: " << argv[i]
+                          << " (expected seconds in (0, " << MAX_FIXED_DT << "], e.g. 0.0667 for 1/15 s)" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--ray-layout") == 0 && i + 1 < argc) {
+            if (!RayLayout::parse(argv[++i], rayLayout)) {
+                std::cerr << "Unknown ray layout: " << argv[i]
+                          << " (expected uniform, uniform:<rays per quadrant, at most " << RayLayout::MAX_RAYS / 4 << "> or adaptive)" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--ray-recast") == 0 && i + 1 < argc) {
+            rayLayout.recastInterval = std::max(1, std::stoi(argv[++i]));
+        }
+    }
+
+    if (parallelEpisodes >= 0) {
+        return runParallel(parallelEpisodes, collect, policyName, threads, bankPath, fixedDt, rayLayout);
+    }
+
+    if (headlessEpisodes >= 0) {
+        return runHeadless(headlessEpisodes, bankPath, fixedDt);
+    }
+
     Game game;  // 创建游戏实例
+    if (!speed.empty()) {
+        if (speed == "max") {
+            game.setSimulationSpeed(1.0f, true);
+        } else {
+            game.setSimulationSpeed(std::stof(speed));
+        }
+    }
+    if (!rayLayout.isDefault()) {
+        game.setRayLayout(rayLayout);
+    }
+    if (!bankPath.empty() && !game.useLevelBank(bankPath)) {
+        return 1;
+    }
     game.run(); // 启动游戏主循环
     return 0;
 }
 
 // 编译指令
-// cmake --build build --config Release
\ No newline at end of file
+// cmake --build build --config Release
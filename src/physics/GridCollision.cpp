@@ -0,0 +1,179 @@
+// src/physics/GridCollision.cpp
+// 基于关卡网格的碰撞响应：只读取玩家覆盖的瓦片，以及按时间步扫掠的连续碰撞检测
+#include "GridCollision.h"
+#include "../core/Constants.h"
+#include <algorithm>
+#include <cmath>
+
+void resolveGridCollision(float& x, float& y, float width, float height,
+                          float& vx, float& vy, bool& onGround,
+                          const TileGrid& grid) {
+    onGround = false;
+    if (grid.empty()) return;
+
+    const int gridWidth = grid.getWidth();
+    const int gridHeight = grid.getHeight();
+
+    // 候选范围：当前包围盒覆盖的格子向外扩展一格
+    // 单次推出距离不超过碰撞盒尺寸，推出后可能接触的瓦片都在该范围内，
+    // 因此按行优先顺序扫描该范围与遍历全部瓦片的结果相同
+    int x0 = std::max(0, static_cast<int>(std::floor(x / TILE)) - 1);
+    int y0 = std::max(0, static_cast<int>(std::floor(y / TILE)) - 1);
+    int x1 = std::min(gridWidth - 1, static_cast<int>(std::floor((x + width) / TILE)) + 1);
+    int y1 = std::min(gridHeight - 1, static_cast<int>(std::floor((y + height) / TILE)) + 1);
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            if (!grid.isSolid(cx, cy)) continue;
+
+            float tl = static_cast<float>(cx * TILE);
+            float tt = static_cast<float>(cy * TILE);
+
+            // 计算X轴和Y轴上的重叠量
+            float overlapX = std::min(x + width, tl + TILE) - std::max(x, tl);
+            float overlapY = std::min(y + height, tt + TILE) - std::max(y, tt);
+            if (overlapX <= 0 || overlapY <= 0) continue;
+
+            if (overlapX < overlapY) {
+                // 水平碰撞
+                vx = 0.0f;
+                x += (x < tl) ? -overlapX : overlapX;
+            } else {
+                // 墙中段不参与垂直碰撞
+                TileKind kind = grid.kindAt(cx, cy);
+                if (kind == TileKind::Wall) continue;
+
+                if (y < tt && vy >= 0 && kind != TileKind::WallBottom) {
+                    // 从上方碰撞（站在平台上）
+                    y += tt - (y + height);
+                    vy = 0.0f;
+                    onGround = true;
+                } else if (y > tt && vy <= 0 && kind != TileKind::WallTop) {
+                    // 从下方碰撞（撞到天花板）
+                    y += (tt + TILE) - y;
+                    vy = 0.0f;
+                }
+            }
+        }
+    }
+}
+
+namespace {
+
+// 边界容差：前沿与格子边界的距离小于该值时视为刚好接触，该格仍需检查
+constexpr float SWEEP_EPSILON = 1e-3f;
+
+// 与区间[lo, hi)相交的首个/末个格子下标
+inline int firstCell(float lo) { return static_cast<int>(std::floor(lo / TILE)); }
+inline int lastCell(float hi) { return static_cast<int>(std::ceil(hi / TILE)) - 1; }
+
+// 向下运动的阻挡瓦片：墙中段和墙底可以穿过
+inline bool blocksDownward(TileKind kind) {
+    return kind != TileKind::Wall && kind != TileKind::WallBottom;
+}
+
+// 向上运动的阻挡瓦片：墙中段和墙顶可以穿过
+inline bool blocksUpward(TileKind kind) {
+    return kind != TileKind::Wall && kind != TileKind::WallTop;
+}
+
+}  // namespace
+
+void sweepGridCollision(float& x, float& y, float width, float height,
+                        float& vx, float& vy, bool& onGround, float dt,
+                        const TileGrid& grid) {
+    onGround = false;
+    if (grid.empty()) {
+        x += vx * dt;
+        y += vy * dt;
+        return;
+    }
+
+    const int gridWidth = grid.getWidth();
+    const int gridHeight = grid.getHeight();
+    bool landed = false;
+
+    // X轴：逐列检查碰撞盒前沿扫过的格子，碰到第一列碰撞瓦片即停在其边缘
+    float dx = vx * dt;
+    if (dx != 0.0f) {
+        int row0 = std::max(0, firstCell(y + SWEEP_EPSILON));
+        int row1 = std::min(gridHeight - 1, lastCell(y + height - SWEEP_EPSILON));
+        float targetX = x + dx;
+
+        if (dx > 0.0f) {
+            int col0 = std::max(0, lastCell(x + width - SWEEP_EPSILON) + 1);
+            int col1 = std::min(gridWidth - 1, lastCell(targetX + width));
+            for (int col = col0; col <= col1; ++col) {
+                bool blocked = false;
+                for (int row = row0; row <= row1 && !blocked; ++row) {
+                    blocked = grid.isSolid(col, row);
+                }
+                if (blocked) {
+                    targetX = static_cast<float>(col * TILE) - width;
+                    vx = 0.0f;
+                    break;
+                }
+            }
+        } else {
+            int col0 = std::min(gridWidth - 1, firstCell(x + SWEEP_EPSILON) - 1);
+            int col1 = std::max(0, firstCell(targetX));
+            for (int col = col0; col >= col1; --col) {
+                bool blocked = false;
+                for (int row = row0; row <= row1 && !blocked; ++row) {
+                    blocked = grid.isSolid(col, row);
+                }
+                if (blocked) {
+                    targetX = static_cast<float>((col + 1) * TILE);
+                    vx = 0.0f;
+                    break;
+                }
+            }
+        }
+        x = targetX;
+    }
+
+    // Y轴：使用移动后的X，逐行检查；竖直方向按瓦片类型区分是否阻挡
+    float dy = vy * dt;
+    if (dy != 0.0f) {
+        int colA = std::max(0, firstCell(x + SWEEP_EPSILON));
+        int colB = std::min(gridWidth - 1, lastCell(x + width - SWEEP_EPSILON));
+        float targetY = y + dy;
+
+        if (dy > 0.0f) {
+            int row0 = std::max(0, lastCell(y + height - SWEEP_EPSILON) + 1);
+            int row1 = std::min(gridHeight - 1, lastCell(targetY + height));
+            for (int row = row0; row <= row1; ++row) {
+                bool blocked = false;
+                for (int col = colA; col <= colB && !blocked; ++col) {
+                    blocked = grid.isSolid(col, row) && blocksDownward(grid.kindAt(col, row));
+                }
+                if (blocked) {
+                    targetY = static_cast<float>(row * TILE) - height;
+                    vy = 0.0f;
+                    landed = true;
+                    break;
+                }
+            }
+        } else {
+            int row0 = std::min(gridHeight - 1, firstCell(y + SWEEP_EPSILON) - 1);
+            int row1 = std::max(0, firstCell(targetY));
+            for (int row = row0; row >= row1; --row) {
+                bool blocked = false;
+                for (int col = colA; col <= colB && !blocked; ++col) {
+                    blocked = grid.isSolid(col, row) && blocksUpward(grid.kindAt(col, row));
+                }
+                if (blocked) {
+                    targetY = static_cast<float>((row + 1) * TILE);
+                    vy = 0.0f;
+                    break;
+                }
+            }
+        }
+        y = targetY;
+    }
+
+    // 残余重叠（出生点、穿行瓦片）仍按离散规则解析
+    bool resolvedOnGround = false;
+    resolveGridCollision(x, y, width, height, vx, vy, resolvedOnGround, grid);
+    onGround = landed || resolvedOnGround;
+}
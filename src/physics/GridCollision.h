@@ -0,0 +1,46 @@
+#ifndef GRID_COLLISION_H
+#define GRID_COLLISION_H
+
+#include "../world/TileGrid.h"
+
+/**
+ * @brief 基于关卡网格的AABB碰撞响应（不依赖SFML）
+ * @param x 碰撞盒左上角X坐标（像素），解析后写回
+ * @param y 碰撞盒左上角Y坐标（像素），解析后写回
+ * @param width 碰撞盒宽度（像素）
+ * @param height 碰撞盒高度（像素）
+ * @param vx X方向速度，发生水平碰撞时置0
+ * @param vy Y方向速度，发生垂直碰撞时置0
+ * @param onGround 输出：是否站在平台上
+ * @param grid 关卡瓦片网格
+ * @note 只读取碰撞盒向外扩展一格范围内的瓦片（12×12玩家最多16格），不再遍历整张地图
+ * 先查询碰撞位图，只有碰撞瓦片才读取类型
+ * 规则与原瓦片遍历实现一致：按行优先顺序逐格解析重叠，'W'不参与垂直碰撞，
+ * '3'（墙顶）不阻挡向上运动，'4'（墙底）不能站立
+ */
+void resolveGridCollision(float& x, float& y, float width, float height,
+                          float& vx, float& vy, bool& onGround,
+                          const TileGrid& grid);
+
+/**
+ * @brief 连续碰撞检测：沿速度方向扫掠碰撞盒并在首个阻挡瓦片前停下
+ * @param x 碰撞盒左上角X坐标（像素，移动前），移动并解析后写回
+ * @param y 碰撞盒左上角Y坐标（像素，移动前），移动并解析后写回
+ * @param width 碰撞盒宽度（像素）
+ * @param height 碰撞盒高度（像素）
+ * @param vx X方向速度，被阻挡时置0
+ * @param vy Y方向速度，被阻挡时置0
+ * @param onGround 输出：是否站在平台上
+ * @param dt 时间增量（秒），本步位移为速度乘以dt
+ * @param grid 关卡瓦片网格
+ * @details 先沿X轴、再沿Y轴逐列/逐行推进，计算与瓦片的碰撞时刻（首个相交的列或行），
+ * 因此任意大的位移都不会穿过瓦片，可以使用1/15秒等较粗的时间步长
+ * 阻挡规则与resolveGridCollision一致：水平方向所有碰撞瓦片都阻挡，
+ * 向下运动不被'W'和'4'阻挡，向上运动不被'W'和'3'阻挡
+ * 扫掠结束后再调用一次resolveGridCollision，处理出生点或穿行瓦片造成的残余重叠
+ */
+void sweepGridCollision(float& x, float& y, float width, float height,
+                        float& vx, float& vy, bool& onGround, float dt,
+                        const TileGrid& grid);
+
+#endif
@@ -0,0 +1,64 @@
+// =============================================================================
+// 文件名: LevelBankGen.cpp
+// 描述: 关卡库生成工具 - 多线程预生成关卡并写入关卡库文件
+// 用法: level_bank_gen <输出路径> [关卡数=1000] [起始种子=1] [线程数=硬件线程数] [难度=当前难度]
+// 说明: 第i个关卡的种子为 起始种子 + i，相同参数总是生成完全相同的关卡库
+// =============================================================================
+
+#include "../world/LevelBank.h"
+#include "../world/Parser.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: level_bank_gen <output> [count=1000] [baseSeed=1] [threads=auto] [difficulty]" << std::endl;
+        return 1;
+    }
+
+    const std::string outputPath = argv[1];
+    const int count = argc >= 3 ? std::stoi(argv[2]) : 1000;
+    const uint32_t baseSeed = argc >= 4 ? static_cast<uint32_t>(std::stoul(argv[3])) : 1u;
+    int threadCount = argc >= 5 ? std::stoi(argv[4]) : static_cast<int>(std::thread::hardware_concurrency());
+    const float difficulty = argc >= 6 ? std::stof(argv[5]) : Parser::getDifficulty();
+    threadCount = std::max(1, std::min(threadCount, count));
+
+    std::vector<uint32_t> seeds(count);
+    std::vector<std::vector<std::string>> levels(count);
+    for (int i = 0; i < count; ++i) {
+        seeds[i] = baseSeed + static_cast<uint32_t>(i);
+    }
+
+    // 各线程从共享计数器领取关卡下标，结果写入各自的槽位，与线程数和调度顺序无关
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int i = next++; i < count; i = next++) {
+            levels[i] = Parser::parseLevel(seeds[i], difficulty);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!LevelBank::write(outputPath, difficulty, seeds, levels)) {
+        return 1;
+    }
+
+    std::cout << "[LEVELBANK] Generated " << count << " levels with " << threadCount << " threads in "
+              << seconds << "s (" << (seconds > 0.0 ? count / seconds : 0.0) << " levels/s)" << std::endl;
+    std::cout << "[LEVELBANK] Seeds " << baseSeed << ".." << (baseSeed + count - 1)
+              << ", difficulty " << difficulty << " -> " << outputPath << std::endl;
+    return 0;
+}
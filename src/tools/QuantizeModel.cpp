@@ -0,0 +1,185 @@
+// =============================================================================
+// 文件名: QuantizeModel.cpp
+// 描述: 训练后量化工具 - 用DataCollector导出的帧校准fp32策略网络，写入INT8或FP16量化模型
+// 用法: quantize_model <fp32模型> <训练数据集CSV> <输出路径> [精度=int8|fp16] [最低一致率=0.97] [最多帧数=200000]
+// 说明: 前80%的帧用于校准，后20%的帧用于测量与fp32的决策一致率；一致率低于阈值时不写出文件
+// =============================================================================
+
+#include "../ai/controller/FeatureSchema.h"
+#include "../ai/controller/Int8PolicyNetwork.h"
+#include "../ai/controller/PolicyNetwork.h"
+#include "../ai/controller/QuantizedModel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 读取数据集中的状态列并标准化（与训练程序相同）；表头必须与特征布局一致
+static bool loadFrames(const std::string& path, int maxFrames, std::vector<float>& frames) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[QUANT] Cannot open dataset " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    std::getline(file, line);
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    if (line != FeatureSchema::datasetHeader()) {
+        std::cerr << "[QUANT] Dataset columns do not match the feature layout (expected "
+                  << FeatureSchema::DATASET_COLUMNS << " columns)" << std::endl;
+        return false;
+    }
+
+    std::vector<float> row;
+    int count = 0;
+    while (count < maxFrames && std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string value;
+        row.clear();
+        while (std::getline(ss, value, ',')) {
+            row.push_back(std::stof(value));
+        }
+        if (row.size() != static_cast<size_t>(FeatureSchema::DATASET_COLUMNS)) {
+            continue;
+        }
+        FeatureSchema::normalize(row.data());
+        frames.insert(frames.end(), row.begin(), row.begin() + FeatureSchema::FEATURE_COUNT);
+        count++;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Usage: quantize_model <model.bin> <dataset.csv> <output> [int8|fp16] [minAgreement=0.97] [maxFrames=200000]"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string modelPath = argv[1];
+    const std::string datasetPath = argv[2];
+    const std::string outputPath = argv[3];
+    const std::string precisionName = argc >= 5 ? argv[4] : "int8";
+    const float minAgreement = argc >= 6 ? std::stof(argv[5]) : 0.97f;
+    const int maxFrames = argc >= 7 ? std::stoi(argv[6]) : 200000;
+    if (precisionName != "int8" && precisionName != "fp16") {
+        std::cerr << "[QUANT] Unknown precision: " << precisionName << " (expected int8 or fp16)" << std::endl;
+        return 1;
+    }
+    const QuantizedModel::Precision precision =
+        precisionName == "int8" ? QuantizedModel::Precision::Int8 : QuantizedModel::Precision::Fp16;
+
+    std::vector<std::vector<float>> weights, biases;
+    if (!PolicyNetwork::readModel(modelPath, weights, biases)) {
+        return 1;
+    }
+    std::vector<float> frames;
+    if (!loadFrames(datasetPath, maxFrames, frames)) {
+        return 1;
+    }
+    const int count = static_cast<int>(frames.size() / FeatureSchema::FEATURE_COUNT);
+    if (count == 0) {
+        std::cerr << "[QUANT] No frames in " << datasetPath << std::endl;
+        return 1;
+    }
+
+    // 前80%校准，后20%评估；帧太少时两者都用全部帧
+    const int calibrationFrames = count >= 10 ? count * 4 / 5 : count;
+    const int evaluationBegin = count >= 10 ? calibrationFrames : 0;
+    const size_t stride = FeatureSchema::FEATURE_COUNT;
+
+    QuantizedModel model;
+    if (!model.quantize(weights, biases, frames.data(), calibrationFrames, stride, precision)) {
+        std::cerr << "[QUANT] Quantization failed" << std::endl;
+        return 1;
+    }
+
+    PolicyNetwork fp32;
+    fp32.load(weights, biases);
+    Int8PolicyNetwork int8;
+    PolicyNetwork half;
+    if (precision == QuantizedModel::Precision::Int8) {
+        int8.load(model);
+    } else {
+        std::vector<std::vector<float>> halfWeights, halfBiases;
+        model.toFloat(halfWeights, halfBiases);
+        half.load(halfWeights, halfBiases);
+    }
+    auto quantizedForward = [&](const float* input, float* output) {
+        if (precision == QuantizedModel::Precision::Int8) {
+            int8.forward(input, output);
+        } else {
+            half.forward(input, output);
+        }
+    };
+
+    // 与fp32比较离散化后的动作
+    int moveMatches = 0, energyMatches = 0, matches = 0;
+    float maxError = 0.0f;
+    float expected[PolicyNetwork::OUTPUT_DIM], actual[PolicyNetwork::OUTPUT_DIM];
+    for (int i = evaluationBegin; i < count; ++i) {
+        const float* frame = frames.data() + static_cast<size_t>(i) * stride;
+        fp32.forward(frame, expected);
+        quantizedForward(frame, actual);
+        const bool sameMove = PolicyNetwork::discreteMoveX(expected[0]) == PolicyNetwork::discreteMoveX(actual[0]);
+        const bool sameEnergy = PolicyNetwork::discreteUseEnergy(expected[1]) == PolicyNetwork::discreteUseEnergy(actual[1]);
+        moveMatches += sameMove ? 1 : 0;
+        energyMatches += sameEnergy ? 1 : 0;
+        matches += sameMove && sameEnergy ? 1 : 0;
+        for (int o = 0; o < PolicyNetwork::OUTPUT_DIM; ++o) {
+            maxError = std::max(maxError, std::fabs(expected[o] - actual[o]));
+        }
+    }
+    const int evaluated = count - evaluationBegin;
+    const float agreement = static_cast<float>(matches) / evaluated;
+
+    // 单次前向耗时
+    using Clock = std::chrono::steady_clock;
+    const int runs = 20000;
+    float checksum = 0.0f;
+    auto t0 = Clock::now();
+    for (int r = 0; r < runs; ++r) {
+        fp32.forward(frames.data() + static_cast<size_t>(r % count) * stride, expected);
+        checksum += expected[0];
+    }
+    auto t1 = Clock::now();
+    for (int r = 0; r < runs; ++r) {
+        quantizedForward(frames.data() + static_cast<size_t>(r % count) * stride, actual);
+        checksum += actual[0];
+    }
+    auto t2 = Clock::now();
+    const double fp32Us = std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+    const double quantizedUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / runs;
+
+    size_t fp32Bytes = 2 * PolicyNetwork::LAYERS * sizeof(size_t);
+    for (int l = 0; l < PolicyNetwork::LAYERS; ++l) {
+        fp32Bytes += (weights[l].size() + biases[l].size()) * sizeof(float);
+    }
+    std::cout << "[QUANT] " << precisionName << ": calibrated on " << calibrationFrames << " frames, evaluated on "
+              << evaluated << " frames" << std::endl;
+    std::cout << "[QUANT] Decision agreement " << agreement * 100.0f << "% (moveX " << 100.0f * moveMatches / evaluated
+              << "%, useEnergy " << 100.0f * energyMatches / evaluated << "%), max output error " << maxError << std::endl;
+    std::cout << "[QUANT] Size " << fp32Bytes << " -> " << model.fileSize() << " bytes, forward " << fp32Us << " -> "
+              << quantizedUs << " us ("
+              << (precision == QuantizedModel::Precision::Int8 ? Int8PolicyNetwork::instructionSet()
+                                                               : PolicyNetwork::instructionSet())
+              << ", checksum " << checksum << ")" << std::endl;
+
+    if (agreement < minAgreement) {
+        std::cerr << "[QUANT] Agreement below " << minAgreement * 100.0f << "%, keep using the fp32 model ("
+                  << outputPath << " not written)" << std::endl;
+        return 1;
+    }
+    model.setAgreement(agreement);
+    if (!model.save(outputPath)) {
+        return 1;
+    }
+    std::cout << "[QUANT] Wrote " << outputPath << std::endl;
+    return 0;
+}
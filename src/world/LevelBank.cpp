@@ -0,0 +1,204 @@
+// src/world/LevelBank.cpp
+// 预生成关卡库：文件格式读写与内存映射
+#include "LevelBank.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(LevelBank::Header) == 32, "LevelBank header layout changed");
+static_assert(sizeof(LevelBank::RecordHeader) == 12, "LevelBank record layout changed");
+
+LevelBank::~LevelBank() {
+    close();
+}
+
+size_t LevelBank::recordSizeFor(int width, int height) {
+    size_t packed = (static_cast<size_t>(width) * height + 1) / 2;
+    return (sizeof(RecordHeader) + packed + 3) & ~static_cast<size_t>(3);
+}
+
+bool LevelBank::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "[LEVELBANK] Cannot open " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        std::cerr << "[LEVELBANK] Cannot map " << path << std::endl;
+        return false;
+    }
+    data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        std::cerr << "[LEVELBANK] Cannot map " << path << std::endl;
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "[LEVELBANK] Cannot open " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        std::cerr << "[LEVELBANK] Cannot read " << path << std::endl;
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // 映射建立后即可关闭文件描述符
+    if (mapped == MAP_FAILED) {
+        std::cerr << "[LEVELBANK] Cannot map " << path << std::endl;
+        return false;
+    }
+    data = static_cast<const uint8_t*>(mapped);
+    mappedSize = static_cast<size_t>(st.st_size);
+#endif
+
+    // 校验文件头
+    if (mappedSize < sizeof(Header) || std::memcmp(header().magic, "NLVB", 4) != 0) {
+        std::cerr << "[LEVELBANK] " << path << " is not a level bank" << std::endl;
+        close();
+        return false;
+    }
+    if (header().version != VERSION) {
+        std::cerr << "[LEVELBANK] " << path << " has version " << header().version
+                  << ", expected " << VERSION << std::endl;
+        close();
+        return false;
+    }
+    if (header().generatorVersion != Parser::GENERATOR_VERSION) {
+        std::cerr << "[LEVELBANK] " << path << " was generated by level generator version "
+                  << header().generatorVersion << ", expected " << Parser::GENERATOR_VERSION
+                  << " (its seeds no longer reproduce the stored levels; regenerate it with level_bank_gen)" << std::endl;
+        close();
+        return false;
+    }
+    const Header& h = header();
+    if (h.recordSize != recordSizeFor(h.width, h.height) ||
+        mappedSize < sizeof(Header) + static_cast<size_t>(h.count) * h.recordSize) {
+        std::cerr << "[LEVELBANK] " << path << " is truncated or corrupted" << std::endl;
+        close();
+        return false;
+    }
+
+    std::cout << "[LEVELBANK] Opened " << path << ": " << h.count << " levels ("
+              << h.width << "x" << h.height << ")" << std::endl;
+    return true;
+}
+
+void LevelBank::close() {
+    if (!data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(data), mappedSize);
+#endif
+    data = nullptr;
+    mappedSize = 0;
+}
+
+const LevelBank::RecordHeader& LevelBank::getRecord(size_t index) const {
+    return *reinterpret_cast<const RecordHeader*>(record(index));
+}
+
+void LevelBank::loadLevel(size_t index, TileGrid& grid) const {
+    // 打包的瓦片直接解码到网格的存储中，不经过中间数组
+    grid.assignPacked(getWidth(), getHeight(), record(index) + sizeof(RecordHeader));
+}
+
+bool LevelBank::write(const std::string& path, float difficulty,
+                      const std::vector<uint32_t>& seeds,
+                      const std::vector<std::vector<std::string>>& levels) {
+    if (levels.empty() || seeds.size() != levels.size()) {
+        std::cerr << "[LEVELBANK] Nothing to write or seed count mismatch" << std::endl;
+        return false;
+    }
+
+    const int width = static_cast<int>(levels[0][0].size());
+    const int height = static_cast<int>(levels[0].size());
+    const size_t recordSize = recordSizeFor(width, height);
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "[LEVELBANK] Cannot create " << path << std::endl;
+        return false;
+    }
+
+    Header h{};
+    std::memcpy(h.magic, "NLVB", 4);
+    h.version = VERSION;
+    h.width = static_cast<uint32_t>(width);
+    h.height = static_cast<uint32_t>(height);
+    h.count = static_cast<uint32_t>(levels.size());
+    h.recordSize = static_cast<uint32_t>(recordSize);
+    h.difficulty = difficulty;
+    h.generatorVersion = Parser::GENERATOR_VERSION;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    std::vector<uint8_t> buffer(recordSize);
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const auto& level = levels[i];
+        if (static_cast<int>(level.size()) != height || static_cast<int>(level[0].size()) != width) {
+            std::cerr << "[LEVELBANK] Level " << i << " has a different size" << std::endl;
+            return false;
+        }
+
+        std::fill(buffer.begin(), buffer.end(), 0);
+        RecordHeader rec{};
+        rec.seed = seeds[i];
+        uint8_t* packed = buffer.data() + sizeof(RecordHeader);
+
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                TileKind kind = TileGrid::charToKind(level[y][x]);
+                if (kind == TileKind::Player) {
+                    rec.playerX = static_cast<uint16_t>(x);
+                    rec.playerY = static_cast<uint16_t>(y);
+                } else if (kind == TileKind::Target) {
+                    rec.targetX = static_cast<uint16_t>(x);
+                    rec.targetY = static_cast<uint16_t>(y);
+                }
+                size_t cell = static_cast<size_t>(y) * width + x;
+                packed[cell >> 1] |= static_cast<uint8_t>(kind) << ((cell & 1) * 4);
+            }
+        }
+
+        std::memcpy(buffer.data(), &rec, sizeof(rec));
+        out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    }
+
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,111 @@
+// src/world/LevelBank.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Parser.h"
+#include "TileGrid.h"
+
+/**
+ * @file LevelBank.h
+ * @brief 预生成关卡库
+ * @details 把按种子预先生成的关卡保存在一个文件中，运行时以内存映射方式打开，
+ * 按下标O(1)定位任意关卡，重置关卡时不再走随机游走和墙检测
+ * 基准测试和模型A/B评估使用同一个关卡库即可得到完全相同的关卡序列
+ *
+ * 文件格式（小端序）：
+ * - 文件头（32字节）：magic "NLVB"、版本号、宽、高、关卡数、单条记录字节数、难度、生成算法版本
+ * - 记录（recordSize字节，4字节对齐）：
+ *   种子(uint32) + 出生点X/Y、终点X/Y(各uint16，网格坐标) + 瓦片类型
+ *   瓦片类型为行优先的TileKind，每格4位，两格一个字节（低4位在前）
+ */
+class LevelBank {
+public:
+    /** @brief 文件头 */
+    struct Header {
+        char magic[4];          // "NLVB"
+        uint32_t version;       // 格式版本
+        uint32_t width;         // 关卡宽度（瓦片）
+        uint32_t height;        // 关卡高度（瓦片）
+        uint32_t count;         // 关卡数量
+        uint32_t recordSize;    // 单条记录字节数
+        float difficulty;       // 生成时使用的难度
+        uint32_t generatorVersion;  // 生成关卡时的Parser::GENERATOR_VERSION
+    };
+
+    /** @brief 记录头（紧跟其后为打包的瓦片类型） */
+    struct RecordHeader {
+        uint32_t seed;
+        uint16_t playerX, playerY;
+        uint16_t targetX, targetY;
+    };
+
+    /** @brief 格式版本（2起文件头记录生成算法版本，版本1的文件无法确认种子是否仍能重新生成原关卡） */
+    static constexpr uint32_t VERSION = 2;
+
+    LevelBank() = default;
+    ~LevelBank();
+
+    LevelBank(const LevelBank&) = delete;
+    LevelBank& operator=(const LevelBank&) = delete;
+
+    /**
+     * @brief 以内存映射方式打开关卡库
+     * @param path 关卡库文件路径
+     * @return 打开成功返回true；文件不存在、格式版本或生成算法版本不符时返回false并输出原因
+     */
+    bool open(const std::string& path);
+
+    /** @brief 关闭关卡库并解除映射 */
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    size_t size() const { return isOpen() ? header().count : 0; }
+    int getWidth() const { return isOpen() ? static_cast<int>(header().width) : 0; }
+    int getHeight() const { return isOpen() ? static_cast<int>(header().height) : 0; }
+    float getDifficulty() const { return isOpen() ? header().difficulty : 0.0f; }
+
+    /**
+     * @brief 获取关卡记录头（出生点、终点和种子）
+     * @param index 关卡下标（须小于size()）
+     */
+    const RecordHeader& getRecord(size_t index) const;
+
+    /**
+     * @brief 把指定关卡解码到瓦片网格
+     * @param index 关卡下标（须小于size()）
+     * @param grid 输出网格（尺寸不变时复用其存储，连续取关卡不分配内存）
+     */
+    void loadLevel(size_t index, TileGrid& grid) const;
+
+    /**
+     * @brief 把关卡写入关卡库文件
+     * @param path 输出路径
+     * @param difficulty 生成难度（写入文件头）
+     * @param seeds 每个关卡的种子
+     * @param levels 关卡字符数据，尺寸须一致且包含'P'和'T'
+     * @return 写入成功返回true
+     */
+    static bool write(const std::string& path, float difficulty,
+                      const std::vector<uint32_t>& seeds,
+                      const std::vector<std::vector<std::string>>& levels);
+
+private:
+    const uint8_t* data = nullptr;  // 映射起始地址
+    size_t mappedSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+    const Header& header() const { return *reinterpret_cast<const Header*>(data); }
+    const uint8_t* record(size_t index) const {
+        return data + sizeof(Header) + index * header().recordSize;
+    }
+
+    /** @brief 单条记录字节数（记录头 + 打包瓦片，4字节对齐） */
+    static size_t recordSizeFor(int width, int height);
+};
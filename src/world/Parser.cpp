@@ -9,9 +9,10 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
-#include <SFML/Graphics.hpp>
-#include <SFML/System/Vector2.hpp>
+#include <mutex>
 
 using namespace std;
 namespace Parser {
@@ -23,7 +24,8 @@ constexpr char PLAYER = 'P';                      // 玩家出生点标记
 constexpr char TARGET = 'T';                      // 目标点标记
 constexpr int MIN_WALL_NEIGHBORS = 2;             // 墙体平滑阈值
 constexpr int CLEAR_RADIUS = 1;                   // 玩家/目标周围清空半径
-static std::mt19937 rng(std::random_device{}());  // 全局随机引擎
+static std::mt19937 seedRng(std::random_device{}());  // 种子生成引擎（仅用于产生关卡种子）
+static std::mutex seedRngMutex;                       // 多个模拟线程可能同时取种子
 
 /*================ 辅助工具函数 ================*/
 // 判断坐标 (x, y) 是否在宽为 w、高为 h 的区域范围内（包含边界）
@@ -31,70 +33,123 @@ bool isInBounds(int x, int y, int w, int h)   { return x >= 0 && x < w && y >= 0
 // 判断坐标 (x, y) 是否在宽为 w、高为 h 的区域有效范围内（不包含边界）
 bool isValid(int x, int y, int w, int h)      { return x > 0 && x < w-1 && y > 0 && y < h-1; }
 
-// 统计 8 邻域内的墙数量
-int countWallNeighbors(const std::vector<std::string>& m, int x, int y) {
-    int cnt = 0;
-    for (int dy = -1; dy <= 1; ++dy)
-        for (int dx = -1; dx <= 1; ++dx)
-            if (dx || dy) cnt += (m[y+dy][x+dx] == WALL);
-    return cnt;
+/*================ 行位棋盘 ================*/
+// 生成流程全程在位棋盘上进行：每行按64位对齐（与TileGrid的碰撞位图相同），
+// 第y行第x格对应 bits[y * words + x / 64] 的第 x % 64 位，位为1表示墙('1')
+// 90列的关卡每行2个64位字，邻居统计、平滑和墙段检测都按整行的位运算完成
+struct Bitboard {
+    int width = 0;
+    int height = 0;
+    int words = 0;
+    std::vector<uint64_t> bits;
+
+    Bitboard(int w, int h, bool filled) : width(w), height(h), words((w + 63) / 64) {
+        bits.assign(static_cast<size_t>(words) * h, 0);
+        if (filled) {
+            const std::vector<uint64_t> mask = columnMask();
+            for (int y = 0; y < h; ++y) {
+                std::copy(mask.begin(), mask.end(), row(y));
+            }
+        }
+    }
+
+    uint64_t* row(int y) { return bits.data() + static_cast<size_t>(y) * words; }
+    const uint64_t* row(int y) const { return bits.data() + static_cast<size_t>(y) * words; }
+    bool test(int x, int y) const { return (row(y)[x >> 6] >> (x & 63)) & 1u; }
+    void set(int x, int y) { row(y)[x >> 6] |= uint64_t{1} << (x & 63); }
+    void reset(int x, int y) { row(y)[x >> 6] &= ~(uint64_t{1} << (x & 63)); }
+
+    // [first, last]列为1的行掩码
+    std::vector<uint64_t> rangeMask(int first, int last) const {
+        std::vector<uint64_t> mask(words, 0);
+        for (int x = std::max(first, 0); x <= std::min(last, width - 1); ++x) {
+            mask[x >> 6] |= uint64_t{1} << (x & 63);
+        }
+        return mask;
+    }
+    std::vector<uint64_t> columnMask() const { return rangeMask(0, width - 1); }
+};
+
+// 整行左移一格（第x位移到第x+1位，即每格的左邻居对齐到该格）
+inline void shiftUp(const uint64_t* in, uint64_t* out, int words) {
+    for (int i = words - 1; i >= 0; --i) {
+        out[i] = (in[i] << 1) | (i > 0 ? in[i - 1] >> 63 : 0);
+    }
+}
+
+// 整行右移一格（每格的右邻居对齐到该格）
+inline void shiftDown(const uint64_t* in, uint64_t* out, int words) {
+    for (int i = 0; i < words; ++i) {
+        out[i] = (in[i] >> 1) | (i + 1 < words ? in[i + 1] << 63 : 0);
+    }
+}
+
+// 饱和计数器：按位累加一个邻居位向量，ones为计数≥1，twos为计数≥2
+inline void accumulate(uint64_t v, uint64_t& ones, uint64_t& twos) {
+    twos |= ones & v;
+    ones |= v;
+}
+
+// 以 (cx, cy) 为中心、半径 r 的方形区域清空（坐标夹到地图内）
+void clearArea(Bitboard& m, int cx, int cy, int r) {
+    for (int dy = -r; dy <= r; ++dy)
+        for (int dx = -r; dx <= r; ++dx)
+            m.reset(std::clamp(cx + dx, 0, m.width - 1), std::clamp(cy + dy, 0, m.height - 1));
 }
 
 /*================ 地形生成函数 ================*/
 
 // 随机游走生成洞穴状基础地形，并记录玩家和目标位置
 struct WalkResult {
-    std::vector<std::string> map;
+    Bitboard map;
     std::pair<int, int> playerPos;
     std::pair<int, int> targetPos;
 };
 
-WalkResult drunkardsWalkWithPositions(int w, int h, int steps) {
-    std::vector<std::string> m(h, std::string(w, WALL));
+// 随机游走的同时用蓄水池抽样（容量2）从走过的不同格子中选出玩家和目标位置：
+// 格子第一次被走到时（位棋盘上该位仍为墙）计入候选，第n个候选以2/n的概率替换两个槽位之一，
+// 结束时两个槽位是均匀抽取的两个不同格子，再随机决定哪个给玩家。不记录路径，游走过程中不分配内存
+// 方向每步取随机数的2位，一次32位随机数供16步使用
+WalkResult drunkardsWalkWithPositions(int w, int h, int steps, std::mt19937& rng) {
+    Bitboard m(w, h, true);
     int x = w / 2, y = h / 2;
     
-    // 记录随机位置用于玩家和目标
-    std::vector<std::pair<int, int>> pathPositions;
+    std::pair<int, int> slots[2] = {{0, 0}, {0, 0}};
+    uint32_t distinct = 0;
+    uint32_t directionBits = 0;
     
     for (int i = 0; i < steps; ++i) {
-        m[y][x] = PATH;
-        pathPositions.push_back(std::make_pair(static_cast<int>(x), static_cast<int>(y)));
-        
-        int dir = std::uniform_int_distribution<int>(0, 3)(rng);
-        switch (dir) {
-            case 0: y = std::max(1, y - 1); break;
-            case 1: x = std::min(w-2, x + 1); break;
-            case 2: y = std::min(h-2, y + 1); break;
-            case 3: x = std::max(1, x - 1); break;
+        if (m.test(x, y)) {
+            m.reset(x, y);
+            if (distinct < 2) {
+                slots[distinct] = {x, y};
+            } else {
+                uint32_t j = std::uniform_int_distribution<uint32_t>(0, distinct)(rng);
+                if (j < 2) slots[j] = {x, y};
+            }
+            ++distinct;
         }
+        
+        // 方向0上、1右、2下、3左，走到内部范围边缘时停在原地（查表代替分支，方向随机时分支无法预测）
+        if ((i & 15) == 0) directionBits = static_cast<uint32_t>(rng());
+        const int dir = directionBits & 3;
+        directionBits >>= 2;
+        static constexpr int STEP_X[4] = {0, 1, 0, -1};
+        static constexpr int STEP_Y[4] = {-1, 0, 1, 0};
+        x = std::clamp(x + STEP_X[dir], 1, w-2);
+        y = std::clamp(y + STEP_Y[dir], 1, h-2);
     }
     
-    // 从随机路径中随机选择玩家和目标位置
     std::pair<int, int> playerPos{0, 0}, targetPos{0, 0};
-    
-    if (!pathPositions.empty()) {
-        // 随机选择玩家位置
-        int playerIndex = std::uniform_int_distribution<int>(0, static_cast<int>(pathPositions.size())-1)(rng);
-        playerPos = pathPositions[playerIndex];
-        // cout << "Parser : Player: (" << playerPos.first << ", " << playerPos.second << ")" << endl;
-        
-        // 随机选择目标位置，排除玩家位置
-        std::vector<std::pair<int, int>> availableTargets;
-        for (const auto& pos : pathPositions) {
-            if (pos != playerPos) {
-                availableTargets.push_back(std::make_pair(static_cast<int>(pos.first), static_cast<int>(pos.second)));
-            }
-        }
-        
-        if (!availableTargets.empty()) {
-            int targetIndex = std::uniform_int_distribution<int>(0, static_cast<int>(availableTargets.size())-1)(rng);
-            targetPos = availableTargets[targetIndex];
-        } else {
-            // 如果所有位置都被玩家位置占用，使用备用位置
-            targetPos = {playerPos.first + 1, playerPos.second + 1};
-        }
-        // cout << "Parser : Target: (" << targetPos.first << ", " << targetPos.second << ")" << endl;
-
+    if (distinct >= 2) {
+        // 蓄水池中的顺序与走到的先后有关，随机交换后两个角色对称
+        bool swap = std::uniform_int_distribution<int>(0, 1)(rng) != 0;
+        playerPos = slots[swap ? 1 : 0];
+        targetPos = slots[swap ? 0 : 1];
+    } else if (distinct == 1) {
+        // 只走过一个格子，使用备用位置
+        playerPos = slots[0];
+        targetPos = {playerPos.first + 1, playerPos.second + 1};
     } else {
         // 如果没有路径位置，使用中心附近的安全位置
         cout << "Parser : No path positions found. Using center." << endl;
@@ -102,41 +157,160 @@ WalkResult drunkardsWalkWithPositions(int w, int h, int steps) {
         targetPos = {x + 1, y + 1};
     }
     
-    return {m, playerPos, targetPos};
+    return {std::move(m), playerPos, targetPos};
 }
 
-// 平滑处理：减少孤立墙体
-void smoothMap(std::vector<std::string>& m) {
-    int w = m[0].size(), h = m.size();
-    for (int y = 1; y < h-1; ++y)
-        for (int x = 1; x < w-1; ++x)
-            if (m[y][x] == WALL && countWallNeighbors(m, x, y) < MIN_WALL_NEIGHBORS)
-                m[y][x] = PATH;
+// 平滑处理：减少孤立墙体（8邻域墙数少于MIN_WALL_NEIGHBORS的内部墙块变为通路）
+// 与逐格原地修改的结果一致：逐行处理，上一行使用已平滑的结果，下一行和右邻居使用原值，
+// 左邻居是本行已处理的结果。不含左邻居的7个邻居用饱和计数器按位统计：
+// - 计数≥2的墙块保留，计数为0的墙块移除
+// - 计数为1的墙块仅在左邻居保留时保留，连续的这类墙块从左侧第一个保留的墙块开始整段保留，
+//   用一次整行加法的进位完成传递
+void smoothMap(Bitboard& m) {
+    static_assert(MIN_WALL_NEIGHBORS == 2, "按位平滑只区分邻居数0、1和≥2");
+    const int words = m.words;
+    if (m.width < 3 || m.height < 3) return;
+    const std::vector<uint64_t> interior = m.rangeMask(1, m.width - 2);
+    std::vector<uint64_t> scratch(static_cast<size_t>(words) * 8);
+    uint64_t* upL = scratch.data();
+    uint64_t* upR = upL + words;
+    uint64_t* right = upR + words;
+    uint64_t* downL = right + words;
+    uint64_t* downR = downL + words;
+    uint64_t* kept = downR + words;      // 确定保留的墙块（含不参与平滑的首尾列）
+    uint64_t* single = kept + words;     // 不含左邻居时邻居数恰为1的内部墙块
+    uint64_t* seedShift = single + words;
+
+    for (int y = 1; y < m.height - 1; ++y) {
+        const uint64_t* up = m.row(y - 1);
+        uint64_t* cur = m.row(y);
+        const uint64_t* down = m.row(y + 1);
+        shiftUp(up, upL, words);
+        shiftDown(up, upR, words);
+        shiftDown(cur, right, words);
+        shiftUp(down, downL, words);
+        shiftDown(down, downR, words);
+
+        for (int i = 0; i < words; ++i) {
+            uint64_t ones = 0, twos = 0;
+            accumulate(upL[i], ones, twos);
+            accumulate(up[i], ones, twos);
+            accumulate(upR[i], ones, twos);
+            accumulate(right[i], ones, twos);
+            accumulate(downL[i], ones, twos);
+            accumulate(down[i], ones, twos);
+            accumulate(downR[i], ones, twos);
+            kept[i] = cur[i] & (twos | ~interior[i]);
+            single[i] = cur[i] & ones & ~twos & interior[i];
+        }
+
+        // 保留墙块右侧紧邻的计数为1的墙段：段首加1后进位穿过整段，异或得到整段
+        shiftUp(kept, seedShift, words);
+        uint64_t carry = 0;
+        for (int i = 0; i < words; ++i) {
+            const uint64_t seed = seedShift[i] & single[i];
+            const uint64_t partial = single[i] + seed;
+            const uint64_t sum = partial + carry;
+            carry = (partial < single[i]) | (sum < partial);
+            cur[i] = kept[i] | ((sum ^ single[i]) & single[i]);
+        }
+    }
 }
 
-// 以(cx,cy)为中心，半径r的圆形区域清空
-void clearArea(std::vector<std::string>& m, int cx, int cy, int r) {
-    int w = m[0].size(), h = m.size();
-    for (int dy = -r; dy <= r; ++dy)
-        for (int dx = -r; dx <= r; ++dx) {
-            int nx = std::clamp(cx + dx, 0, w-1);
-            int ny = std::clamp(cy + dy, 0, h-1);
-            // 避免覆盖玩家或目标标记
-            if (m[ny][nx] != PLAYER && m[ny][nx] != TARGET) {
-                m[ny][nx] = PATH;
+// 按位检测墙段，写出首块('3')、中段('W')、尾块('4')三张位图
+// 逐行向下推进，每列的状态为"正在跟踪左侧/右侧开放面"两位，所有列同时更新：
+// - 延续：本格是墙，且跟踪的一侧仍开放（两侧都跟踪时任一侧开放即可，之后只跟踪仍开放的一侧）
+// - 新段：本格是墙、未延续上一段，且至少一侧开放
+// 上一行的格子在本行确定是否延续后分类：段首且延续为'3'，段中且延续为'W'，段中且不延续为'4'
+// 只有一格的段不标记
+void detectWallRuns(const Bitboard& m, Bitboard& tops, Bitboard& mids, Bitboard& bottoms) {
+    const int words = m.words;
+    const std::vector<uint64_t> columns = m.columnMask();
+    const std::vector<uint64_t> leftEdge = m.rangeMask(0, 0);
+    const std::vector<uint64_t> rightEdge = m.rangeMask(m.width - 1, m.width - 1);
+    std::vector<uint64_t> scratch(static_cast<size_t>(words) * 6, 0);
+    uint64_t* leftWall = scratch.data();
+    uint64_t* rightWall = leftWall + words;
+    uint64_t* trackL = rightWall + words;
+    uint64_t* trackR = trackL + words;
+    uint64_t* prevStart = trackR + words;
+    uint64_t* prevCont = prevStart + words;
+
+    for (int y = 0; y <= m.height; ++y) {
+        const bool inside = y < m.height;
+        if (inside) {
+            shiftUp(m.row(y), leftWall, words);
+            shiftDown(m.row(y), rightWall, words);
+        }
+        for (int i = 0; i < words; ++i) {
+            uint64_t cont = 0, start = 0;
+            if (inside) {
+                const uint64_t wall = m.row(y)[i];
+                // 左侧开放：不在最左列且左邻居不是墙；右侧同理
+                const uint64_t leftOpen = ~(leftWall[i] | leftEdge[i]) & columns[i];
+                const uint64_t rightOpen = ~(rightWall[i] | rightEdge[i]) & columns[i];
+                cont = wall & ((trackL[i] & leftOpen) | (trackR[i] & rightOpen));
+                start = wall & ~cont & (leftOpen | rightOpen);
+                trackL[i] = (cont & trackL[i] & leftOpen) | (start & leftOpen);
+                trackR[i] = (cont & trackR[i] & rightOpen) | (start & rightOpen);
             }
+            if (y > 0) {
+                tops.row(y - 1)[i] = prevStart[i] & cont;
+                mids.row(y - 1)[i] = prevCont[i] & cont;
+                bottoms.row(y - 1)[i] = prevCont[i] & ~cont;
+            }
+            prevStart[i] = start;
+            prevCont[i] = cont;
         }
+    }
+}
+
+// 8位 -> 8字节展开表：第k位为1时第k个字节为1
+const std::array<uint64_t, 256>& byteExpandTable() {
+    static const std::array<uint64_t, 256> table = [] {
+        std::array<uint64_t, 256> t{};
+        for (int v = 0; v < 256; ++v)
+            for (int k = 0; k < 8; ++k)
+                if (v >> k & 1) t[v] |= uint64_t{1} << (8 * k);
+        return t;
+    }();
+    return table;
+}
+
+// 把一行墙位图和三张墙段位图写成字符（墙段位图互不相交且都是墙位图的子集）
+// 每次处理8列：各位图展开成每字节0/1，字符 = empty + 墙*(wall-empty) + 首块*('3'-wall) + ...，
+// 各项系数非负且结果不超过一个字节，字节之间不会进位
+void emitRow(const Bitboard& walls, const Bitboard& tops, const Bitboard& mids, const Bitboard& bottoms,
+             int y, char empty, char wall, char* dst) {
+    const std::array<uint64_t, 256>& expand = byteExpandTable();
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t base = ones * static_cast<uint8_t>(empty);
+    const uint64_t wallDelta = static_cast<uint8_t>(wall - empty);
+    const uint64_t topDelta = static_cast<uint8_t>('3' - wall);
+    const uint64_t midDelta = static_cast<uint8_t>('W' - wall);
+    const uint64_t bottomDelta = static_cast<uint8_t>('4' - wall);
+    for (int x = 0; x < walls.width; x += 8) {
+        const int word = x >> 6, shift = x & 63;
+        const uint64_t chars = base +
+            expand[walls.row(y)[word] >> shift & 0xFF] * wallDelta +
+            expand[tops.row(y)[word] >> shift & 0xFF] * topDelta +
+            expand[mids.row(y)[word] >> shift & 0xFF] * midDelta +
+            expand[bottoms.row(y)[word] >> shift & 0xFF] * bottomDelta;
+        std::memcpy(dst + x, &chars, std::min(8, walls.width - x));  // 小端序：第x列为最低字节
+    }
 }
 
 /*================ 主生成函数 ================*/
-std::vector<std::string> generateRandomMap(float difficulty) {
+// 关卡完全由rng决定：相同种子得到相同关卡；不访问全局状态，可在多个线程中并行调用
+// 地形、平滑、边界和墙段检测都在位棋盘上完成，玩家/目标标记单独记录，最后一次性写出字符
+std::vector<std::string> generateRandomMap(float difficulty, std::mt19937& rng) {
     // 确保有足够的步数生成可通行区域
     int minSteps = W * H * 0.0001f;  // 最小的地图应该是可通行的
     int steps = std::max(minSteps, static_cast<int>(W * H * difficulty));
     
     // 使用随机游走算法生成基础地图
-    auto result = drunkardsWalkWithPositions(W, H, steps);
-    auto map = result.map;
+    auto result = drunkardsWalkWithPositions(W, H, steps, rng);
+    Bitboard& map = result.map;
     
     smoothMap(map);
     
@@ -147,128 +321,75 @@ std::vector<std::string> generateRandomMap(float difficulty) {
     // 使用随机游走算法生成的位置作为基础
     auto playerPos = result.playerPos;
     auto targetPos = result.targetPos;
+    bool hasPlayer = false, hasTarget = false;
     
-    // 统一处理玩家和目标位置
-    auto placeEntity = [&](std::pair<int, int>& pos, char marker) {
-        // 保存原始位置用于调试
-        int originalX = pos.first;
-        int originalY = pos.second;
-        
-        // 约束坐标到有效范围内
+    // 在指定格子放置标记：该格变为通路，原有的另一个标记被覆盖
+    auto putMarker = [&](int x, int y, char marker) {
+        map.reset(x, y);
+        if (marker == PLAYER) {
+            if (hasTarget && targetPos == std::make_pair(x, y)) hasTarget = false;
+            playerPos = {x, y};
+            hasPlayer = true;
+        } else {
+            if (hasPlayer && playerPos == std::make_pair(x, y)) hasPlayer = false;
+            targetPos = {x, y};
+            hasTarget = true;
+        }
+    };
+    
+    // 统一处理玩家和目标位置：约束到有效范围，清空周围区域（不影响另一个标记），放置标记
+    auto placeEntity = [&](std::pair<int, int> pos, char marker) {
         pos.first = std::clamp(pos.first, 1, W-2);
         pos.second = std::clamp(pos.second, 1, H-2);
-        
-        // 确保位置是可通行的
-        if (map[pos.second][pos.first] != PATH) {
-            map[pos.second][pos.first] = PATH;
-        }
-
-        // 清空周围区域，但避免覆盖其他实体
         clearArea(map, pos.first, pos.second, CLEAR_RADIUS);
-        
-        // 放置实体标记
-        map[pos.second][pos.first] = marker;
-        
-            // std::cout << "[DEBUG] " << (marker == PLAYER ? "Player" : "Target") 
-        //           << " original: (" << originalX << ", " << originalY 
-        //           << ") final: (" << pos.first << ", " << pos.second << ")\n";
+        putMarker(pos.first, pos.second, marker);
     };
     
     placeEntity(playerPos, PLAYER);
     placeEntity(targetPos, TARGET);
     
-        // std::cout << "[DEBUG] After placeEntity - Player at (" << playerPos.first << "," << playerPos.second 
-        //           << ") Target at (" << targetPos.first << "," << targetPos.second << ")" << std::endl;
-    
-    // 验证P和T是否正确放置
-    bool hasPlayer = false, hasTarget = false;
-    int playerX = -1, playerY = -1, targetX = -1, targetY = -1;
-    for (int y = 0; y < H; ++y) {
-        for (int x = 0; x < W; ++x) {
-            if (map[y][x] == PLAYER) {
-                hasPlayer = true;
-                playerX = x;
-                playerY = y;
-            }
-            if (map[y][x] == TARGET) {
-                hasTarget = true;
-                targetX = x;
-                targetY = y;
-            }
-        }
-    }
-    std::cout << "[DEBUG] Pre-validation - P found at (" << playerX << "," << playerY 
-              << ") T found at (" << targetX << "," << targetY << ")" << std::endl;
-    
+    // 验证P和T是否正确放置（目标与玩家重合时玩家标记被覆盖），缺失时强制在中心放置
     if (!hasPlayer || !hasTarget) {
-            // std::cout << "\033[31m[ERROR] Parser : Map validation failed - P:" << hasPlayer << " T:" << hasTarget << "\033[0m" << std::endl;
-        // 强制在中心放置
-        if (!hasPlayer) {
-            map[H/2][W/2] = PLAYER;
-            playerPos = {W/2, H/2};
-        }
-        if (!hasTarget) {
-            map[H/2 + 2][W/2 + 2] = TARGET;
-            targetPos = {W/2 + 2, H/2 + 2};
-        }
+        const bool missingTarget = !hasTarget;
+        if (!hasPlayer) putMarker(W/2, H/2, PLAYER);
+        if (missingTarget) putMarker(W/2 + 2, H/2 + 2, TARGET);
     }
-    
-        // std::cout << "\033[34m[DEBUG] Parser : Final map validation - P:" << playerPos.first << "," << playerPos.second 
-        //           << " T:" << targetPos.first << "," << targetPos.second << "\033[0m" << std::endl;
-
-    // 统一设置边界墙
-    auto setBoundaryWalls = [&](std::vector<std::string>& m) {
-        for (int x = 0; x < W; ++x) {
-            m[0][x]   = (m[0][x]   == PLAYER || m[0][x]   == TARGET) ? m[0][x]   : WALL;
-            m[H-1][x] = (m[H-1][x] == PLAYER || m[H-1][x] == TARGET) ? m[H-1][x] : WALL;
-        }
-        for (int y = 0; y < H; ++y) {
-            m[y][0]   = (m[y][0]   == PLAYER || m[y][0]   == TARGET) ? m[y][0]   : WALL;
-            m[y][W-1] = (m[y][W-1] == PLAYER || m[y][W-1] == TARGET) ? m[y][W-1] : WALL;
-        }
+
+    // 统一设置边界墙（不覆盖标记）
+    for (int x = 0; x < W; ++x) {
+        map.set(x, 0);
+        map.set(x, H-1);
+    }
+    for (int y = 0; y < H; ++y) {
+        map.set(0, y);
+        map.set(W-1, y);
+    }
+    auto onBorder = [](const std::pair<int, int>& p) {
+        return p.first == 0 || p.first == W-1 || p.second == 0 || p.second == H-1;
     };
-    
-    setBoundaryWalls(map);
+    if (hasPlayer && onBorder(playerPos)) map.reset(playerPos.first, playerPos.second);
+    if (hasTarget && onBorder(targetPos)) map.reset(targetPos.first, targetPos.second);
     
     // 最终验证：确保P和T在返回前仍然存在
-    bool finalHasPlayer = false, finalHasTarget = false;
-    for (const auto& row : map) {
-        if (row.find(PLAYER) != std::string::npos) finalHasPlayer = true;
-        if (row.find(TARGET) != std::string::npos) finalHasTarget = true;
-    }
-    
-    if (!finalHasPlayer || !finalHasTarget) {
-        std::cout << "\033[33m[WARNING] Parser(Final) : Final validation failed - P:" << finalHasPlayer 
-                  << " T:" << finalHasTarget << " - Forcing placement\033[0m" << std::endl;
-        // 边界墙设置后强制放置
-        if (!finalHasPlayer) {
-            int safeX = std::clamp(W/2, 1, W-2);
-            int safeY = std::clamp(H/2, 1, H-2);
-            map[safeY][safeX] = PLAYER;
-        }
-        if (!finalHasTarget) {
-            int safeX = std::clamp(W/2 + 2, 1, W-2);
-            int safeY = std::clamp(H/2 + 2, 1, H-2);
-            map[safeY][safeX] = TARGET;
-        }
+    if (!hasPlayer || !hasTarget) {
+        std::cout << "\033[33m[WARNING] Parser(Final) : Final validation failed - P:" << hasPlayer 
+                  << " T:" << hasTarget << " - Forcing placement\033[0m" << std::endl;
+        const bool missingTarget = !hasTarget;
+        if (!hasPlayer) putMarker(std::clamp(W/2, 1, W-2), std::clamp(H/2, 1, H-2), PLAYER);
+        if (missingTarget) putMarker(std::clamp(W/2 + 2, 1, W-2), std::clamp(H/2 + 2, 1, H-2), TARGET);
     }
-    
-        // std::cout << "\033[33m[INFO] Parser(Final) : Map generation complete - P:" << (finalHasPlayer||true) 
-        //           << " T:" << (finalHasTarget||true) << "\033[0m" << std::endl;
 
-    // 检测并标记墙结构
-    auto wallMap = detectWalls(map);
-    
-    // 将墙标记合并到原始地图中
+    // 检测墙结构并写出字符地图：墙段标记'3'/'W'/'4'，其余墙为'1'
+    Bitboard tops(W, H, false), mids(W, H, false), bottoms(W, H, false);
+    detectWallRuns(map, tops, mids, bottoms);
+
+    std::vector<std::string> out(H, std::string(W, PATH));
     for (int y = 0; y < H; ++y) {
-        for (int x = 0; x < W; ++x) {
-            if (wallMap[y][x] == 'W' || wallMap[y][x] == '3' || wallMap[y][x] == '4') {
-                map[y][x] = wallMap[y][x];  // 用'W', '3', '4'标记墙结构
-            }
-        }
+        emitRow(map, tops, mids, bottoms, y, PATH, WALL, &out[y][0]);
     }
-
-    return map;
+    if (hasPlayer) out[playerPos.second][playerPos.first] = PLAYER;
+    if (hasTarget) out[targetPos.second][targetPos.first] = TARGET;
+    return out;
 }
 
 /*================ 墙检测函数 ================*/
@@ -276,6 +397,7 @@ std::vector<std::string> generateRandomMap(float difficulty) {
 /**
  * 检测地图中的墙结构
  * 墙的定义：竖直方向上堆叠的连续方块，具有至少一面无阻挡的垂直面
+ * 字符地图转成位棋盘后按位检测（见detectWallRuns）
  */
 std::vector<std::string> detectWalls(const std::vector<std::string>& map) {
     if (map.empty()) return {};
@@ -283,95 +405,18 @@ std::vector<std::string> detectWalls(const std::vector<std::string>& map) {
     int width = map[0].size();
     int height = map.size();
     
-    // 创建结果数组，初始化为空
-    std::vector<std::string> wallMap(height, std::string(width, ' '));
+    Bitboard walls(width, height, false);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            if (map[y][x] == WALL) walls.set(x, y);
     
-    // 遍历每一列
-    for (int x = 0; x < width; ++x) {
-        int startY = 0;
-        
-        while (startY < height) {
-            // 寻找下一个墙方块（'1'）
-            while (startY < height && map[startY][x] != WALL) {
-                ++startY;
-            }
-            
-            if (startY >= height) break;
-            
-            // 找到了墙方块，检查是否可以作为墙的起始点
-            bool leftBlocked = (x == 0) || (x > 0 && map[startY][x-1] == WALL);
-            bool rightBlocked = (x == width-1) || (x < width-1 && map[startY][x+1] == WALL);
-            
-            // 如果两面都被阻挡，跳过这个方块
-            if (leftBlocked && rightBlocked) {
-                ++startY;
-                continue;
-            }
-            
-            // 至少有一面是开放的，开始寻找连续的墙
-            int wallStart = startY;
-            int wallEnd = startY;
-            
-            // 确定墙的方向（左开放还是右开放）
-            bool leftOpen = !leftBlocked;
-            bool rightOpen = !rightBlocked;
-            
-            // 向下寻找连续的墙方块
-            while (wallEnd + 1 < height) {
-                if (map[wallEnd + 1][x] != WALL) {
-                    break;  // 不再是墙方块
-                }
-                
-                // 检查下一层是否符合相同的开放条件
-                bool nextLeftBlocked = (x == 0) || (x > 0 && map[wallEnd + 1][x-1] == WALL);
-                bool nextRightBlocked = (x == width-1) || (x < width-1 && map[wallEnd + 1][x+1] == WALL);
-                
-                bool nextLeftOpen = !nextLeftBlocked;
-                bool nextRightOpen = !nextRightBlocked;
-                
-                // 如果原来两边都开放，检查是否变成单边开放
-                if (leftOpen && rightOpen) {
-                    // 两边原来都开放
-                    if (!nextLeftOpen && !nextRightOpen) {
-                        // 两边都变成阻挡，停止
-                        break;
-                    } else if (nextLeftOpen && !nextRightOpen) {
-                        // 右边变成阻挡，只关注左边
-                        rightOpen = false;
-                    } else if (!nextLeftOpen && nextRightOpen) {
-                        // 左边变成阻挡，只关注右边
-                        leftOpen = false;
-                    }
-                    // 如果两边都还开放，继续两边都关注
-                } else {
-                    // 原来只有一边开放，检查是否保持开放
-                    if (leftOpen && !nextLeftOpen) {
-                        break;  // 左边不再开放
-                    }
-                    if (rightOpen && !nextRightOpen) {
-                        break;  // 右边不再开放
-                    }
-                }
-                
-                ++wallEnd;
-            }
-            
-            // 只有当连续方块数量大于1时才标记为墙
-            if (wallEnd - wallStart + 1 > 1) {
-                // 标记墙的首方块为'3'，尾方块为'4'，中间为'W'
-                wallMap[wallStart][x] = '3';  // 首方块
-                wallMap[wallEnd][x] = '4';    // 尾方块
-                
-                // 中间方块标记为'W'（如果有中间方块的话）
-                for (int y = wallStart + 1; y < wallEnd; ++y) {
-                    wallMap[y][x] = 'W';
-                }
-            }
-            
-            // 继续搜索下一部分
-            startY = wallEnd + 1;
-        }
-    }
+    Bitboard tops(width, height, false), mids(width, height, false), bottoms(width, height, false);
+    detectWallRuns(walls, tops, mids, bottoms);
+    
+    // 创建结果数组，未标记的位置为空格
+    std::vector<std::string> wallMap(height, std::string(width, ' '));
+    for (int y = 0; y < height; ++y)
+        emitRow(walls, tops, mids, bottoms, y, ' ', ' ', &wallMap[y][0]);
     
     return wallMap;
 }
@@ -381,7 +426,25 @@ std::vector<std::string> detectWalls(const std::vector<std::string>& map) {
 static float currentDifficulty = 0.005f;
 
 std::vector<std::string> parseLevel() {
-    return generateRandomMap(currentDifficulty);
+    return parseLevel(randomSeed());
+}
+
+std::vector<std::string> parseLevel(uint32_t seed) {
+    return parseLevel(seed, currentDifficulty);
+}
+
+std::vector<std::string> parseLevel(uint32_t seed, float difficulty) {
+    std::mt19937 rng(seed);
+    return generateRandomMap(difficulty, rng);
+}
+
+uint32_t randomSeed() {
+    std::lock_guard<std::mutex> lock(seedRngMutex);
+    return static_cast<uint32_t>(seedRng());
+}
+
+float getDifficulty() {
+    return currentDifficulty;
 }
 
 void nextLevel() {
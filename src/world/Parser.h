@@ -1,6 +1,7 @@
 // src/world/Parser.h
 
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <utility>
@@ -18,6 +19,15 @@
  */
 namespace Parser {
 
+    /**
+     * @brief 生成算法版本
+     * @details 同一种子生成的关卡只在同一版本内保持不变；修改随机数的消耗顺序或生成规则时递增
+     * - 1: 随机游走结束后从路径格子中选取出生点和终点
+     * - 2: 随机游走过程中用蓄水池抽样选取出生点和终点（不保存路径）
+     * 关卡库在文件头中记录该版本，版本不一致的关卡库中的种子无法重新生成原关卡，打开时拒绝
+     */
+    constexpr uint32_t GENERATOR_VERSION = 2;
+
     /**
      * @brief 解析当前关卡数据
      * @return 地图瓦片数组，每行是一个字符串，每个字符代表一个瓦片类型
@@ -37,8 +47,37 @@ namespace Parser {
      * 3. 在随机游走过程中动态生成实体，使用概率系统控制实体密度
      * 4. 返回的向量中，每个字符串代表地图的一行，行高和列宽由具体关卡决定
      * 5. 如果解析失败，返回空向量
+     * 等价于 parseLevel(randomSeed())，每次调用得到不同的关卡
      */
     std::vector<std::string> parseLevel();
+
+    /**
+     * @brief 按指定种子生成关卡（使用当前难度）
+     * @param seed 关卡种子，相同种子和难度总是得到相同的关卡
+     * @return 地图瓦片数组，格式同parseLevel()
+     */
+    std::vector<std::string> parseLevel(uint32_t seed);
+
+    /**
+     * @brief 按指定种子和难度生成关卡
+     * @param seed 关卡种子
+     * @param difficulty 难度（随机游走步数占地图面积的比例）
+     * @return 地图瓦片数组，格式同parseLevel()
+     * @note 不读写全局状态，可在多个线程中并行调用
+     */
+    std::vector<std::string> parseLevel(uint32_t seed, float difficulty);
+
+    /**
+     * @brief 生成一个新的随机关卡种子
+     * @return 由random_device初始化的引擎产生的种子（线程安全）
+     */
+    uint32_t randomSeed();
+
+    /**
+     * @brief 获取当前关卡难度
+     * @return parseLevel()/parseLevel(seed)使用的难度
+     */
+    float getDifficulty();
     
     /**
      * @brief 检测地图中的墙结构
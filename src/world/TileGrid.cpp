@@ -0,0 +1,91 @@
+// src/world/TileGrid.cpp
+// 扁平瓦片网格：关卡字符数据到类型数组和碰撞位图的转换
+#include "TileGrid.h"
+#include <algorithm>
+
+void TileGrid::build(const std::vector<std::string>& levelData) {
+    height = static_cast<int>(levelData.size());
+    width = height > 0 ? static_cast<int>(levelData[0].size()) : 0;
+    wordsPerRow = (width + 63) / 64;
+
+    kinds.assign(static_cast<size_t>(width) * height, static_cast<uint8_t>(TileKind::Other));
+    solidBits.assign(static_cast<size_t>(wordsPerRow) * height, 0);
+
+    for (int y = 0; y < height; ++y) {
+        const std::string& row = levelData[y];
+        int rowWidth = std::min(width, static_cast<int>(row.size()));
+        uint64_t* bits = solidBits.data() + y * wordsPerRow;
+
+        for (int x = 0; x < rowWidth; ++x) {
+            TileKind kind = charToKind(row[x]);
+            kinds[y * width + x] = static_cast<uint8_t>(kind);
+            if (isSolidKind(kind)) {
+                bits[x >> 6] |= uint64_t(1) << (x & 63);
+            }
+        }
+    }
+}
+
+void TileGrid::assignPacked(int gridWidth, int gridHeight, const uint8_t* packed) {
+    width = gridWidth;
+    height = gridHeight;
+    wordsPerRow = (width + 63) / 64;
+
+    // resize/assign在容量足够时复用已有存储
+    const size_t cells = static_cast<size_t>(width) * height;
+    kinds.resize(cells);
+    solidBits.assign(static_cast<size_t>(wordsPerRow) * height, 0);
+
+    // 解包：每字节两格，低4位在前
+    for (size_t i = 0; i < cells; ++i) {
+        const uint8_t byte = packed[i >> 1];
+        kinds[i] = (i & 1) ? static_cast<uint8_t>(byte >> 4) : static_cast<uint8_t>(byte & 0x0F);
+    }
+
+    for (int y = 0; y < height; ++y) {
+        uint64_t* bits = solidBits.data() + y * wordsPerRow;
+        for (int x = 0; x < width; ++x) {
+            if (isSolidKind(kindAt(x, y))) {
+                bits[x >> 6] |= uint64_t(1) << (x & 63);
+            }
+        }
+    }
+}
+
+void TileGrid::clear() {
+    width = height = wordsPerRow = 0;
+    kinds.clear();
+    solidBits.clear();
+}
+
+TileKind TileGrid::charToKind(char c) {
+    switch (c) {
+        case '0': return TileKind::Empty;
+        case '1': return TileKind::Solid;
+        case 'W': return TileKind::Wall;
+        case '3': return TileKind::WallTop;
+        case '4': return TileKind::WallBottom;
+        case 'M': return TileKind::Marked;
+        case 'P': return TileKind::Player;
+        case 'T': return TileKind::Target;
+        case 'E': return TileKind::Enemy;
+        case 'I': return TileKind::Item;
+        default:  return TileKind::Other;
+    }
+}
+
+char TileGrid::kindToChar(TileKind kind) {
+    switch (kind) {
+        case TileKind::Empty:      return '0';
+        case TileKind::Solid:      return '1';
+        case TileKind::Wall:       return 'W';
+        case TileKind::WallTop:    return '3';
+        case TileKind::WallBottom: return '4';
+        case TileKind::Marked:     return 'M';
+        case TileKind::Player:     return 'P';
+        case TileKind::Target:     return 'T';
+        case TileKind::Enemy:      return 'E';
+        case TileKind::Item:       return 'I';
+        default:                   return '?';
+    }
+}
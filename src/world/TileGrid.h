@@ -0,0 +1,119 @@
+// src/world/TileGrid.h
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 瓦片类型
+ * @details 与关卡字符一一对应，用一个字节存储
+ */
+enum class TileKind : uint8_t {
+    Empty = 0,    // '0' 空白/可通行路径
+    Solid,        // '1' 固体方块
+    Wall,         // 'W' 墙中段
+    WallTop,      // '3' 墙顶
+    WallBottom,   // '4' 墙底
+    Marked,       // 'M' 被标记的方块
+    Player,       // 'P' 玩家出生点
+    Target,       // 'T' 终点
+    Enemy,        // 'E' 敌人位置
+    Item,         // 'I' 物品位置
+    Other         // 其他未定义字符（不渲染、不参与碰撞）
+};
+
+/**
+ * @file TileGrid.h
+ * @brief 紧凑的扁平瓦片网格
+ * @details 关卡数据的运行时表示，由Map持有，碰撞、射线检测、安全检测和渲染共同查询
+ * 存储布局（均为行优先）：
+ * - kinds: 每格一个字节的TileKind
+ * - solidBits: 碰撞位图，每行按64位对齐（wordsPerRow = (width + 63) / 64），
+ *   第y行第x格对应 solidBits[y * wordsPerRow + x / 64] 的第 x % 64 位
+ * 90×90的关卡共约9.5KB（8100字节类型 + 1440字节位图），不依赖SFML
+ */
+class TileGrid {
+public:
+    TileGrid() = default;
+
+    /**
+     * @brief 从关卡字符数据构建网格
+     * @param levelData 关卡数据，以第一行长度作为网格宽度
+     */
+    explicit TileGrid(const std::vector<std::string>& levelData) { build(levelData); }
+
+    /**
+     * @brief 重建网格
+     * @param levelData 关卡数据，以第一行长度作为网格宽度（较短的行按Other补齐）
+     */
+    void build(const std::vector<std::string>& levelData);
+
+    /**
+     * @brief 从4位打包的类型数组重建网格（用于关卡库解码）
+     * @param gridWidth 网格宽度
+     * @param gridHeight 网格高度
+     * @param packed 行优先的TileKind，每格4位，两格一个字节（低4位在前），长度为(gridWidth × gridHeight + 1) / 2
+     * @note 直接解包到已有存储，尺寸不变时不分配内存
+     */
+    void assignPacked(int gridWidth, int gridHeight, const uint8_t* packed);
+
+    /** @brief 清空网格 */
+    void clear();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getWordsPerRow() const { return wordsPerRow; }
+    bool empty() const { return width == 0 || height == 0; }
+
+    /** @brief 网格坐标是否在关卡范围内 */
+    bool inBounds(int x, int y) const {
+        return static_cast<unsigned>(x) < static_cast<unsigned>(width) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(height);
+    }
+
+    /** @brief 获取瓦片类型（调用方保证坐标在范围内） */
+    TileKind kindAt(int x, int y) const { return static_cast<TileKind>(kinds[y * width + x]); }
+
+    /**
+     * @brief 是否为碰撞瓦片（'1' 'W' '3' '4' 'M'）
+     * @note 调用方保证坐标在范围内；只读取位图，不访问类型数组
+     */
+    bool isSolid(int x, int y) const {
+        return (solidBits[y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1u;
+    }
+
+    /** @brief 第y行碰撞位图的起始地址（共getWordsPerRow()个64位字） */
+    const uint64_t* solidRow(int y) const { return solidBits.data() + y * wordsPerRow; }
+
+    /** @brief 类型数组起始地址（width × height字节，行优先） */
+    const uint8_t* kindData() const { return kinds.data(); }
+
+    /** @brief 还原为关卡字符 */
+    char charAt(int x, int y) const { return kindToChar(kindAt(x, y)); }
+
+    /** @brief 关卡字符转瓦片类型 */
+    static TileKind charToKind(char c);
+
+    /** @brief 瓦片类型转关卡字符（Other还原为'?'） */
+    static char kindToChar(TileKind kind);
+
+    /** @brief 是否为碰撞类型 */
+    static bool isSolidKind(TileKind kind) {
+        return kind == TileKind::Solid || kind == TileKind::Wall || kind == TileKind::WallTop ||
+               kind == TileKind::WallBottom || kind == TileKind::Marked;
+    }
+
+    /** @brief 是否为可站立的空地类型（'0' 'P' 'E' 'I'） */
+    static bool isGroundKind(TileKind kind) {
+        return kind == TileKind::Empty || kind == TileKind::Player ||
+               kind == TileKind::Enemy || kind == TileKind::Item;
+    }
+
+private:
+    int width = 0;
+    int height = 0;
+    int wordsPerRow = 0;
+    std::vector<uint8_t> kinds;
+    std::vector<uint64_t> solidBits;
+};
@@ -0,0 +1,162 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <cstdint>
+
+#include "../src/core/Constants.h"
+#include "../src/core/BatchSim.h"
+#include "../src/core/HeadlessSim.h"
+#include "../src/core/Map.h"
+#include "../src/entity/Player.h"
+#include "../src/world/Parser.h"
+
+// 批量模拟器测试：BatchSim与逐对象路径（Player::handleInput + HeadlessSim::stepPlayerPhysics）逐步一致，
+// 并对比两者推进同样数量智能体的每智能体耗时
+class BatchSimTest {
+public:
+    static void runAllTests() {
+        std::cout << "=== 批量模拟器测试 ===" << std::endl;
+
+        // 少量关卡由所有智能体轮流使用（Map每次随机生成关卡时都会打印日志）
+        std::vector<std::unique_ptr<Map>> maps;
+        for (int i = 0; i < LEVELS; ++i) {
+            maps.emplace_back(std::make_unique<Map>());
+            maps.back()->loadLevel();
+        }
+
+        testEquivalence(maps, 1.0f / 60.0f);
+        testEquivalence(maps, MAX_FIXED_DT);
+        benchmark(maps, 256);
+        benchmark(maps, 1024);
+
+        std::cout << "测试完成!" << std::endl;
+    }
+
+private:
+    static constexpr int LEVELS = 8;
+    static constexpr int STEPS = 1200;
+
+    // 逐对象参考路径：每个智能体一个Player，共用所在关卡的Map
+    struct Reference {
+        std::vector<Player> players;
+        std::vector<const Map*> maps;
+    };
+
+    // 为count个智能体准备两条路径的相同初始状态（第i个智能体使用第i % LEVELS个关卡）
+    static void setup(const std::vector<std::unique_ptr<Map>>& maps, int count, BatchSim& batch, Reference& ref) {
+        std::vector<std::vector<std::string>> levels;
+        for (const auto& map : maps) {
+            levels.push_back(Parser::parseLevel(map->getLevelSeed()));
+        }
+        ref.players.clear();
+        ref.maps.clear();
+        for (int i = 0; i < count; ++i) {
+            const Map& map = *maps[i % LEVELS];
+            batch.loadLevel(i, levels[i % LEVELS]);
+            ref.players.emplace_back(map.getPlayerPos());
+            ref.players.back().respawn(map.getPlayerPos());
+            ref.maps.push_back(&map);
+        }
+    }
+
+    // 随机动作：水平输入每步重新抽取，飞行输入按段保持，智能体能飞离地面并撞到天花板
+    static void randomActions(std::mt19937& rng, std::vector<float>& moveX, std::vector<uint8_t>& useEnergy) {
+        std::uniform_int_distribution<int> move(-1, 1);
+        std::bernoulli_distribution toggle(0.1);
+        for (size_t i = 0; i < moveX.size(); ++i) {
+            moveX[i] = static_cast<float>(move(rng));
+            if (toggle(rng)) useEnergy[i] ^= 1;
+        }
+    }
+
+    static void stepReference(Reference& ref, const std::vector<float>& moveX, const std::vector<uint8_t>& useEnergy,
+                              float dt) {
+        for (size_t i = 0; i < ref.players.size(); ++i) {
+            Player& player = ref.players[i];
+            player.handleInput(dt, true, moveX[i], useEnergy[i] != 0);
+            HeadlessSim::stepPlayerPhysics(player, *ref.maps[i], dt);
+        }
+    }
+
+    // 逐步比较位置、速度、能量、地面状态和终点检测，要求逐位一致
+    static void testEquivalence(const std::vector<std::unique_ptr<Map>>& maps, float dt) {
+        const int count = 64;
+        BatchSim batch(count, dt);
+        Reference ref;
+        setup(maps, count, batch, ref);
+
+        std::mt19937 rng(11);
+        std::vector<float> moveX(count);
+        std::vector<uint8_t> useEnergy(count, 0);
+        long long mismatches = 0, targetMismatches = 0, grounded = 0;
+        for (int step = 0; step < STEPS; ++step) {
+            randomActions(rng, moveX, useEnergy);
+            stepReference(ref, moveX, useEnergy, dt);
+            batch.step(moveX.data(), useEnergy.data());
+
+            for (int i = 0; i < count; ++i) {
+                const Player& p = ref.players[i];
+                bool same = p.getPosition().x == batch.positionsX()[i] && p.getPosition().y == batch.positionsY()[i] &&
+                            p.getVelocity().x == batch.velocitiesX()[i] && p.getVelocity().y == batch.velocitiesY()[i] &&
+                            p.getCurrentEnergy() == batch.energies()[i] &&
+                            p.isOnGround() == (batch.groundFlags()[i] != 0);
+                mismatches += same ? 0 : 1;
+                bool reached = HeadlessSim::isTargetReached(p, *ref.maps[i]);
+                targetMismatches += reached == (batch.reachedTarget()[i] != 0) ? 0 : 1;
+                grounded += p.isOnGround() ? 1 : 0;
+            }
+        }
+
+        const long long total = static_cast<long long>(count) * STEPS;
+        std::cout << "Equivalence test (dt=" << dt << "s): " << (mismatches == 0 && targetMismatches == 0 ? "true" : "false")
+                  << " (" << mismatches << "/" << total << " agent steps differ, " << targetMismatches
+                  << " target checks differ, " << grounded << " grounded)" << std::endl;
+    }
+
+    static void benchmark(const std::vector<std::unique_ptr<Map>>& maps, int count) {
+        using Clock = std::chrono::steady_clock;
+        const float dt = 1.0f / 60.0f;
+        const int steps = 600;
+        BatchSim batch(count, dt);
+        Reference ref;
+        setup(maps, count, batch, ref);
+
+        // 动作预先生成，两条路径使用同一组输入，计时不含随机数
+        std::mt19937 rng(5);
+        std::vector<std::vector<float>> moveX(steps, std::vector<float>(count));
+        std::vector<std::vector<uint8_t>> useEnergy(steps, std::vector<uint8_t>(count, 0));
+        for (int s = 0; s < steps; ++s) {
+            if (s > 0) useEnergy[s] = useEnergy[s - 1];
+            randomActions(rng, moveX[s], useEnergy[s]);
+        }
+
+        auto t0 = Clock::now();
+        for (int s = 0; s < steps; ++s) {
+            stepReference(ref, moveX[s], useEnergy[s], dt);
+        }
+        auto t1 = Clock::now();
+        for (int s = 0; s < steps; ++s) {
+            batch.step(moveX[s].data(), useEnergy[s].data());
+        }
+        auto t2 = Clock::now();
+
+        float checksum = 0.0f;
+        for (int i = 0; i < count; ++i) {
+            checksum += ref.players[i].getPosition().y + batch.positionsY()[i];
+        }
+        const double agentSteps = static_cast<double>(count) * steps;
+        const double refNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / agentSteps;
+        const double batchNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / agentSteps;
+        std::cout << count << " agents: per-object " << refNs << " ns/agent-step, batch " << batchNs
+                  << " ns/agent-step, speedup " << (batchNs > 0.0 ? refNs / batchNs : 0.0) << "x"
+                  << " (checksum " << checksum << ")" << std::endl;
+    }
+};
+
+int main() {
+    BatchSimTest::runAllTests();
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#include "../src/core/Constants.h"
+#include "../src/physics/GridCollision.h"
+
+// 简化的旧版瓦片（对应Map::tiles中的sf::RectangleShape）
+struct LegacyTile {
+    float left, top, width, height;
+    bool transparent;
+};
+
+// 碰撞状态
+struct BodyState {
+    float x, y, vx, vy;
+    bool onGround;
+};
+
+// 碰撞检测基准测试：全量瓦片遍历 vs 网格索引
+class CollisionBenchmark {
+public:
+    static void runAllTests() {
+        std::cout << "=== 碰撞检测基准测试 ===" << std::endl;
+
+        std::vector<std::string> level = buildLevel(W, H, 42);
+        std::vector<LegacyTile> tiles = buildTiles(level);
+        std::vector<BodyState> samples = buildSamples(level, 20000, 7);
+        TileGrid grid(level);
+
+        testEquivalence(level, tiles, grid, samples);
+        testTunneling(level, grid);
+        benchmark(level, tiles, grid, samples);
+
+        std::cout << "测试完成!" << std::endl;
+    }
+
+private:
+    // 生成带边界墙、随机平台和竖直墙结构的测试关卡
+    static std::vector<std::string> buildLevel(int w, int h, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::string> m(h, std::string(w, '0'));
+        for (int x = 0; x < w; ++x) { m[0][x] = '1'; m[h-1][x] = '1'; }
+        for (int y = 0; y < h; ++y) { m[y][0] = '1'; m[y][w-1] = '1'; }
+
+        std::uniform_int_distribution<int> xs(2, w - 10), ys(2, h - 10), len(2, 8);
+        for (int i = 0; i < 300; ++i) {
+            int px = xs(rng), py = ys(rng), l = len(rng);
+            for (int k = 0; k < l; ++k) m[py][px + k] = '1';
+        }
+        for (int i = 0; i < 60; ++i) {
+            int px = xs(rng), py = ys(rng), l = len(rng);
+            m[py][px] = '3';
+            for (int k = 1; k < l - 1; ++k) m[py + k][px] = 'W';
+            m[py + l - 1][px] = '4';
+        }
+        return m;
+    }
+
+    // 与旧版Map::draw一致：每个格子一个瓦片，非碰撞格子为透明
+    static std::vector<LegacyTile> buildTiles(const std::vector<std::string>& level) {
+        std::vector<LegacyTile> tiles;
+        for (size_t y = 0; y < level.size(); ++y) {
+            for (size_t x = 0; x < level[y].size(); ++x) {
+                tiles.push_back({static_cast<float>(x * TILE), static_cast<float>(y * TILE),
+                                 static_cast<float>(TILE), static_cast<float>(TILE),
+                                 !TileGrid::isSolidKind(TileGrid::charToKind(level[y][x]))});
+            }
+        }
+        return tiles;
+    }
+
+    // 在关卡内随机采样玩家位置和速度（包括与瓦片重叠的情况）
+    static std::vector<BodyState> buildSamples(const std::vector<std::string>& level, int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> px(TILE, (level[0].size() - 2) * TILE);
+        std::uniform_real_distribution<float> py(TILE, (level.size() - 2) * TILE);
+        std::uniform_real_distribution<float> v(-300.0f, 300.0f);
+        std::vector<BodyState> samples;
+        for (int i = 0; i < count; ++i) {
+            samples.push_back({px(rng), py(rng), v(rng), v(rng), false});
+        }
+        return samples;
+    }
+
+    // 旧版handlePlayerPlatformCollision的简化复刻：遍历全部瓦片
+    static void legacyCollision(BodyState& s, const std::vector<LegacyTile>& tiles,
+                                const std::vector<std::string>& level) {
+        const float size = PLAYER_SIZE;
+        s.onGround = false;
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            const LegacyTile& t = tiles[i];
+            if (t.transparent) continue;
+            if (!(s.x < t.left + t.width && s.x + size > t.left &&
+                  s.y < t.top + t.height && s.y + size > t.top)) continue;
+
+            char c = level[i / level[0].size()][i % level[0].size()];
+            float overlapX = std::max(0.0f, std::min(s.x + size, t.left + t.width) - std::max(s.x, t.left));
+            float overlapY = std::max(0.0f, std::min(s.y + size, t.top + t.height) - std::max(s.y, t.top));
+            if (overlapX <= 0 || overlapY <= 0) continue;
+
+            if (overlapX < overlapY) {
+                s.vx = 0;
+                s.x += s.x < t.left ? -overlapX : overlapX;
+            } else {
+                if (c == 'W') continue;
+                if (s.y < t.top && s.vy >= 0 && c != '4') {
+                    s.y += t.top - (s.y + size);
+                    s.vy = 0.0f;
+                    s.onGround = true;
+                } else if (s.y > t.top && s.vy <= 0 && c != '3') {
+                    s.y += (t.top + t.height) - s.y;
+                    s.vy = 0.0f;
+                }
+            }
+        }
+    }
+
+    static void gridCollision(BodyState& s, const TileGrid& grid) {
+        resolveGridCollision(s.x, s.y, PLAYER_SIZE, PLAYER_SIZE, s.vx, s.vy, s.onGround, grid);
+    }
+
+    static void testEquivalence(const std::vector<std::string>& level,
+                                const std::vector<LegacyTile>& tiles,
+                                const TileGrid& grid,
+                                const std::vector<BodyState>& samples) {
+        int mismatches = 0;
+        for (const auto& sample : samples) {
+            BodyState a = sample, b = sample;
+            legacyCollision(a, tiles, level);
+            gridCollision(b, grid);
+            if (a.x != b.x || a.y != b.y || a.vx != b.vx || a.vy != b.vy || a.onGround != b.onGround) {
+                mismatches++;
+            }
+        }
+        std::cout << "Equivalence test: " << (mismatches == 0 ? "true" : "false")
+                  << " (" << mismatches << "/" << samples.size() << " mismatches)" << std::endl;
+    }
+
+    // 穿透测试：以最大下落速度、1/15秒步长落向单格厚的平台，统计落地成功的比例
+    static void testTunneling(const std::vector<std::string>& level, const TileGrid& grid) {
+        const float dt = 1.0f / 15.0f;
+        int drops = 0, discreteLanded = 0, sweptLanded = 0;
+
+        for (int row = 4; row < grid.getHeight() - 1; ++row) {
+            for (int col = 1; col < grid.getWidth() - 1; ++col) {
+                // 只选上方三格为空、下方为空的'1'平台
+                if (level[row][col] != '1' || level[row + 1][col] != '0') continue;
+                if (level[row - 1][col] != '0' || level[row - 2][col] != '0' || level[row - 3][col] != '0') continue;
+                drops++;
+
+                const float startX = col * TILE + (TILE - PLAYER_SIZE) / 2.0f;
+                const float startY = (row - 3) * TILE;
+                const float landedY = row * TILE - PLAYER_SIZE;
+
+                BodyState a{startX, startY, 0.0f, MAX_FALL_SPEED, false};
+                BodyState b = a;
+                for (int step = 0; step < 4; ++step) {
+                    // 离散：先积分位置再解析重叠
+                    a.vy = MAX_FALL_SPEED;
+                    a.x += a.vx * dt;
+                    a.y += a.vy * dt;
+                    gridCollision(a, grid);
+
+                    // 连续：沿速度扫掠
+                    b.vy = MAX_FALL_SPEED;
+                    sweepGridCollision(b.x, b.y, PLAYER_SIZE, PLAYER_SIZE, b.vx, b.vy, b.onGround, dt, grid);
+                }
+                discreteLanded += (a.y == landedY && a.onGround) ? 1 : 0;
+                sweptLanded += (b.y == landedY && b.onGround) ? 1 : 0;
+            }
+        }
+
+        std::cout << "Tunneling test (dt=1/15s, " << drops << " drops): discrete landed " << discreteLanded
+                  << ", swept landed " << sweptLanded << " -> " << (sweptLanded == drops ? "true" : "false")
+                  << std::endl;
+    }
+
+    static void benchmark(const std::vector<std::string>& level,
+                          const std::vector<LegacyTile>& tiles,
+                          const TileGrid& grid,
+                          const std::vector<BodyState>& samples) {
+        using Clock = std::chrono::steady_clock;
+        float checksum = 0.0f;
+
+        auto t0 = Clock::now();
+        for (const auto& sample : samples) {
+            BodyState s = sample;
+            legacyCollision(s, tiles, level);
+            checksum += s.x + s.y;
+        }
+        auto t1 = Clock::now();
+        for (const auto& sample : samples) {
+            BodyState s = sample;
+            gridCollision(s, grid);
+            checksum += s.x + s.y;
+        }
+        auto t2 = Clock::now();
+
+        double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / samples.size();
+        double gridNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / samples.size();
+
+        std::cout << "Full tile scan: " << legacyNs << " ns/frame" << std::endl;
+        std::cout << "Grid indexed:   " << gridNs << " ns/frame" << std::endl;
+        std::cout << "Speedup: " << (gridNs > 0.0 ? legacyNs / gridNs : 0.0) << "x"
+                  << " (checksum " << checksum << ")" << std::endl;
+    }
+};
+
+int main() {
+    CollisionBenchmark::runAllTests();
+    return 0;
+}
@@ -0,0 +1,288 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+#include "../src/core/Constants.h"
+#include "../src/world/Parser.h"
+
+// 逐格处理字符地图的参考生成器：平滑、清空、放置P/T、边界墙和墙段检测保持位棋盘改写之前的实现，
+// 随机游走与Parser相同（每步取随机数的2位，蓄水池抽样选P/T），随机数的消耗顺序一致
+// Parser改用位运算后的输出必须与它逐字节相同，否则已保存的种子无法重新生成原关卡
+namespace Reference {
+
+constexpr char WALL = '1';
+constexpr char PATH = '0';
+constexpr char PLAYER = 'P';
+constexpr char TARGET = 'T';
+
+int countWallNeighbors(const std::vector<std::string>& m, int x, int y) {
+    int cnt = 0;
+    for (int dy = -1; dy <= 1; ++dy)
+        for (int dx = -1; dx <= 1; ++dx)
+            if (dx || dy) cnt += (m[y + dy][x + dx] == WALL);
+    return cnt;
+}
+
+std::vector<std::string> walk(int w, int h, int steps, std::mt19937& rng,
+                              std::pair<int, int>& playerPos, std::pair<int, int>& targetPos) {
+    std::vector<std::string> m(h, std::string(w, WALL));
+    int x = w / 2, y = h / 2;
+    std::pair<int, int> slots[2] = {{0, 0}, {0, 0}};
+    uint32_t distinct = 0;
+    uint32_t directionBits = 0;
+    for (int i = 0; i < steps; ++i) {
+        if (m[y][x] == WALL) {
+            m[y][x] = PATH;
+            if (distinct < 2) {
+                slots[distinct] = {x, y};
+            } else {
+                uint32_t j = std::uniform_int_distribution<uint32_t>(0, distinct)(rng);
+                if (j < 2) slots[j] = {x, y};
+            }
+            ++distinct;
+        }
+        if ((i & 15) == 0) directionBits = static_cast<uint32_t>(rng());
+        const int dir = directionBits & 3;
+        directionBits >>= 2;
+        switch (dir) {
+            case 0: y = std::max(1, y - 1); break;
+            case 1: x = std::min(w - 2, x + 1); break;
+            case 2: y = std::min(h - 2, y + 1); break;
+            case 3: x = std::max(1, x - 1); break;
+        }
+    }
+    if (distinct >= 2) {
+        bool swap = std::uniform_int_distribution<int>(0, 1)(rng) != 0;
+        playerPos = slots[swap ? 1 : 0];
+        targetPos = slots[swap ? 0 : 1];
+    } else if (distinct == 1) {
+        playerPos = slots[0];
+        targetPos = {playerPos.first + 1, playerPos.second + 1};
+    } else {
+        playerPos = {x, y};
+        targetPos = {x + 1, y + 1};
+    }
+    return m;
+}
+
+// 逐格原地修改：每格看到的左邻居和上一行是已平滑的结果
+void smoothMap(std::vector<std::string>& m) {
+    int w = m[0].size(), h = m.size();
+    for (int y = 1; y < h - 1; ++y)
+        for (int x = 1; x < w - 1; ++x)
+            if (m[y][x] == WALL && countWallNeighbors(m, x, y) < 2)
+                m[y][x] = PATH;
+}
+
+void clearArea(std::vector<std::string>& m, int cx, int cy, int r) {
+    int w = m[0].size(), h = m.size();
+    for (int dy = -r; dy <= r; ++dy)
+        for (int dx = -r; dx <= r; ++dx) {
+            int nx = std::clamp(cx + dx, 0, w - 1);
+            int ny = std::clamp(cy + dy, 0, h - 1);
+            if (m[ny][nx] != PLAYER && m[ny][nx] != TARGET) m[ny][nx] = PATH;
+        }
+}
+
+// 逐列向下扫描墙段
+std::vector<std::string> detectWalls(const std::vector<std::string>& map) {
+    if (map.empty()) return {};
+    int width = map[0].size();
+    int height = map.size();
+    std::vector<std::string> wallMap(height, std::string(width, ' '));
+    auto blockedLeft = [&](int x, int y) { return x == 0 || map[y][x - 1] == WALL; };
+    auto blockedRight = [&](int x, int y) { return x == width - 1 || map[y][x + 1] == WALL; };
+    for (int x = 0; x < width; ++x) {
+        int startY = 0;
+        while (startY < height) {
+            while (startY < height && map[startY][x] != WALL) ++startY;
+            if (startY >= height) break;
+            bool leftOpen = !blockedLeft(x, startY);
+            bool rightOpen = !blockedRight(x, startY);
+            if (!leftOpen && !rightOpen) {
+                ++startY;
+                continue;
+            }
+            int wallStart = startY, wallEnd = startY;
+            while (wallEnd + 1 < height && map[wallEnd + 1][x] == WALL) {
+                bool nextLeftOpen = !blockedLeft(x, wallEnd + 1);
+                bool nextRightOpen = !blockedRight(x, wallEnd + 1);
+                if (leftOpen && rightOpen) {
+                    if (!nextLeftOpen && !nextRightOpen) break;
+                    if (nextLeftOpen && !nextRightOpen) rightOpen = false;
+                    else if (!nextLeftOpen && nextRightOpen) leftOpen = false;
+                } else {
+                    if (leftOpen && !nextLeftOpen) break;
+                    if (rightOpen && !nextRightOpen) break;
+                }
+                ++wallEnd;
+            }
+            if (wallEnd > wallStart) {
+                wallMap[wallStart][x] = '3';
+                wallMap[wallEnd][x] = '4';
+                for (int y = wallStart + 1; y < wallEnd; ++y) wallMap[y][x] = 'W';
+            }
+            startY = wallEnd + 1;
+        }
+    }
+    return wallMap;
+}
+
+bool contains(const std::vector<std::string>& m, char c) {
+    for (const auto& row : m)
+        if (row.find(c) != std::string::npos) return true;
+    return false;
+}
+
+std::vector<std::string> parseLevel(uint32_t seed, float difficulty) {
+    std::mt19937 rng(seed);
+    int minSteps = W * H * 0.0001f;
+    int steps = std::max(minSteps, static_cast<int>(W * H * difficulty));
+    std::pair<int, int> playerPos, targetPos;
+    std::vector<std::string> map = walk(W, H, steps, rng, playerPos, targetPos);
+    smoothMap(map);
+    clearArea(map, W / 2, H / 2, 1);
+
+    auto placeEntity = [&](std::pair<int, int> pos, char marker) {
+        pos.first = std::clamp(pos.first, 1, W - 2);
+        pos.second = std::clamp(pos.second, 1, H - 2);
+        map[pos.second][pos.first] = PATH;
+        clearArea(map, pos.first, pos.second, 1);
+        map[pos.second][pos.first] = marker;
+    };
+    placeEntity(playerPos, PLAYER);
+    placeEntity(targetPos, TARGET);
+
+    bool hasPlayer = contains(map, PLAYER), hasTarget = contains(map, TARGET);
+    if (!hasPlayer) map[H / 2][W / 2] = PLAYER;
+    if (!hasTarget) map[H / 2 + 2][W / 2 + 2] = TARGET;
+
+    for (int x = 0; x < W; ++x) {
+        if (map[0][x] != PLAYER && map[0][x] != TARGET) map[0][x] = WALL;
+        if (map[H - 1][x] != PLAYER && map[H - 1][x] != TARGET) map[H - 1][x] = WALL;
+    }
+    for (int y = 0; y < H; ++y) {
+        if (map[y][0] != PLAYER && map[y][0] != TARGET) map[y][0] = WALL;
+        if (map[y][W - 1] != PLAYER && map[y][W - 1] != TARGET) map[y][W - 1] = WALL;
+    }
+
+    if (!contains(map, PLAYER)) map[H / 2][W / 2] = PLAYER;
+    if (!contains(map, TARGET)) map[H / 2 + 2][W / 2 + 2] = TARGET;
+
+    std::vector<std::string> wallMap = detectWalls(map);
+    for (int y = 0; y < H; ++y)
+        for (int x = 0; x < W; ++x)
+            if (wallMap[y][x] != ' ') map[y][x] = wallMap[y][x];
+    return map;
+}
+
+}  // namespace Reference
+
+// 关卡生成基准测试：位棋盘生成器与逐格参考实现逐字节一致、各难度下的生成吞吐量，并检查生成结果的基本约束
+class LevelGenBenchmark {
+public:
+    static void runAllTests() {
+        std::cout << "=== 关卡生成基准测试 ===" << std::endl;
+
+        testDeterminism();
+        testMatchesReference();
+        testValidity();
+        benchmark();
+
+        std::cout << "测试完成!" << std::endl;
+    }
+
+private:
+    static constexpr float DIFFICULTIES[] = {0.005f, 0.05f, 0.25f, 0.5f, 1.0f, 2.0f, 4.0f};
+
+    // 相同种子和难度得到相同关卡
+    static void testDeterminism() {
+        bool same = true;
+        for (float difficulty : DIFFICULTIES) {
+            for (uint32_t seed = 1; seed <= 50; ++seed) {
+                same = same && Parser::parseLevel(seed, difficulty) == Parser::parseLevel(seed, difficulty);
+            }
+        }
+        std::cout << "Determinism test: " << (same ? "true" : "false") << std::endl;
+    }
+
+    // 位棋盘生成器与参考实现逐字节一致：各难度的一段种子，以及随机字符地图上的墙段检测
+    static void testMatchesReference() {
+        int mismatches = 0, total = 0;
+        for (float difficulty : DIFFICULTIES) {
+            const uint32_t seeds = difficulty >= 1.0f ? 200 : 1000;
+            for (uint32_t seed = 0; seed < seeds; ++seed) {
+                if (Parser::parseLevel(seed, difficulty) != Reference::parseLevel(seed, difficulty)) mismatches++;
+                total++;
+            }
+        }
+        std::cout << "Reference level test: " << (mismatches == 0 ? "true" : "false")
+                  << " (" << mismatches << "/" << total << " levels differ)" << std::endl;
+
+        // 任意墙分布（包括不经过平滑的孤立墙和贴边的墙）
+        std::mt19937 rng(5);
+        int wallMismatches = 0;
+        const int maps = 2000;
+        for (int i = 0; i < maps; ++i) {
+            std::bernoulli_distribution wall(0.1 + 0.8 * (i % 9) / 8.0);
+            const int w = 1 + i % 130, h = 1 + (i * 7) % 97;
+            std::vector<std::string> map(h, std::string(w, '0'));
+            for (auto& row : map)
+                for (char& c : row)
+                    if (wall(rng)) c = '1';
+            if (Parser::detectWalls(map) != Reference::detectWalls(map)) wallMismatches++;
+        }
+        std::cout << "Reference wall test: " << (wallMismatches == 0 ? "true" : "false")
+                  << " (" << wallMismatches << "/" << maps << " maps differ)" << std::endl;
+    }
+
+    // 每个关卡恰好一个P和一个T，位置不同，四周为边界墙
+    static void testValidity() {
+        int invalid = 0, total = 0;
+        for (float difficulty : DIFFICULTIES) {
+            for (uint32_t seed = 0; seed < 500; ++seed) {
+                std::vector<std::string> level = Parser::parseLevel(seed, difficulty);
+                int players = 0, targets = 0;
+                bool border = static_cast<int>(level.size()) == H;
+                for (int y = 0; y < H && border; ++y) {
+                    border = static_cast<int>(level[y].size()) == W;
+                    for (int x = 0; x < W && border; ++x) {
+                        char c = level[y][x];
+                        players += c == 'P';
+                        targets += c == 'T';
+                        bool edge = x == 0 || y == 0 || x == W - 1 || y == H - 1;
+                        if (edge && c == '0') border = false;
+                    }
+                }
+                if (players != 1 || targets != 1 || !border) invalid++;
+                total++;
+            }
+        }
+        std::cout << "Validity test: " << (invalid == 0 ? "true" : "false")
+                  << " (" << invalid << "/" << total << " invalid)" << std::endl;
+    }
+
+    static void benchmark() {
+        using Clock = std::chrono::steady_clock;
+        for (float difficulty : DIFFICULTIES) {
+            const int count = difficulty >= 1.0f ? 2000 : 10000;
+            size_t checksum = 0;
+            auto t0 = Clock::now();
+            for (int i = 0; i < count; ++i) {
+                checksum += Parser::parseLevel(static_cast<uint32_t>(i), difficulty)[H / 2][W / 2];
+            }
+            double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / count;
+            std::cout << "Difficulty " << difficulty << " (" << static_cast<int>(W * H * difficulty)
+                      << " steps): " << us << " us/level, " << (us > 0.0 ? 1e6 / us : 0.0)
+                      << " levels/s (checksum " << checksum << ")" << std::endl;
+        }
+    }
+};
+
+int main() {
+    LevelGenBenchmark::runAllTests();
+    return 0;
+}
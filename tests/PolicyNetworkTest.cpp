@@ -0,0 +1,202 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <thread>
+
+#include "../src/ai/controller/PolicyNetwork.h"
+
+// 策略网络推理测试：面板格式的SIMD前向与按模型文件布局逐项计算的参考实现一致，
+// 批量前向与逐个前向逐位一致，并测量单次前向耗时和不同批量下每个智能体的耗时
+class PolicyNetworkTest {
+public:
+    static void runAllTests() {
+        std::cout << "=== 策略网络推理测试 ===" << std::endl;
+        std::cout << "Instruction set: " << PolicyNetwork::instructionSet() << std::endl;
+
+        std::vector<std::vector<float>> weights, biases;
+        randomModel(weights, biases, 11);
+
+        testLoadRejectsWrongShape(weights, biases);
+        testEquivalence(weights, biases);
+        testBatchMatchesSingle(weights, biases);
+        benchmark(weights, biases);
+        benchmarkBatch(weights, biases);
+
+        std::cout << "测试完成!" << std::endl;
+    }
+
+private:
+    static constexpr int LAYERS = PolicyNetwork::LAYERS;
+
+    // He初始化的随机模型，偏置取小的正值以保留一部分激活
+    static void randomModel(std::vector<std::vector<float>>& weights, std::vector<std::vector<float>>& biases,
+                            unsigned seed) {
+        std::mt19937 rng(seed);
+        weights.assign(LAYERS, {});
+        biases.assign(LAYERS, {});
+        for (int l = 0; l < LAYERS; ++l) {
+            const int in = PolicyNetwork::DIMS[l], out = PolicyNetwork::DIMS[l + 1];
+            std::normal_distribution<float> w(0.0f, std::sqrt(2.0f / in));
+            std::uniform_real_distribution<float> b(-0.05f, 0.1f);
+            for (int i = 0; i < in * out; ++i) weights[l].push_back(w(rng));
+            for (int i = 0; i < out; ++i) biases[l].push_back(b(rng));
+        }
+    }
+
+    // 参考实现：与旧版AIController相同的逐输出循环（权重按[输入][输出]跨步读取）
+    static void reference(const std::vector<std::vector<float>>& weights, const std::vector<std::vector<float>>& biases,
+                          const float* input, float* output) {
+        std::vector<float> x(input, input + PolicyNetwork::INPUT_DIM);
+        for (int l = 0; l < LAYERS; ++l) {
+            const int in = PolicyNetwork::DIMS[l], out = PolicyNetwork::DIMS[l + 1];
+            std::vector<float> y(out);
+            for (int i = 0; i < out; ++i) {
+                y[i] = biases[l][i];
+                for (int j = 0; j < in; ++j) {
+                    y[i] += x[j] * weights[l][j * out + i];
+                }
+                if (l + 1 < LAYERS) y[i] = std::max(0.0f, y[i]);
+            }
+            x.swap(y);
+        }
+        std::copy(x.begin(), x.end(), output);
+    }
+
+    static void randomInput(std::mt19937& rng, float* input) {
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+        for (int i = 0; i < PolicyNetwork::INPUT_DIM; ++i) input[i] = value(rng);
+    }
+
+    static void testLoadRejectsWrongShape(const std::vector<std::vector<float>>& weights,
+                                          const std::vector<std::vector<float>>& biases) {
+        PolicyNetwork network;
+        std::vector<std::vector<float>> wrong = weights;
+        wrong[0].pop_back();
+        bool ok = !network.load(wrong, biases) && !network.isLoaded() && network.load(weights, biases);
+        std::cout << "Shape check test: " << (ok ? "true" : "false") << std::endl;
+    }
+
+    // 输出差异只来自求和顺序和融合乘加，相对误差应在1e-4以内
+    static void testEquivalence(const std::vector<std::vector<float>>& weights,
+                                const std::vector<std::vector<float>>& biases) {
+        PolicyNetwork network;
+        network.load(weights, biases);
+        std::mt19937 rng(5);
+        float input[PolicyNetwork::INPUT_DIM];
+        float expected[PolicyNetwork::OUTPUT_DIM], actual[PolicyNetwork::OUTPUT_DIM];
+        float maxError = 0.0f;
+        int failures = 0;
+        const int samples = 2000;
+        for (int s = 0; s < samples; ++s) {
+            randomInput(rng, input);
+            reference(weights, biases, input, expected);
+            network.forward(input, actual);
+            for (int i = 0; i < PolicyNetwork::OUTPUT_DIM; ++i) {
+                float error = std::fabs(expected[i] - actual[i]) / std::max(1.0f, std::fabs(expected[i]));
+                maxError = std::max(maxError, error);
+                if (error > 1e-4f) failures++;
+            }
+        }
+        std::cout << "Equivalence test: " << (failures == 0 ? "true" : "false")
+                  << " (max relative error " << maxError << " over " << samples << " inputs)" << std::endl;
+    }
+
+    // 批量与逐个前向的求和顺序相同，输出应逐位相等；行数覆盖微块和分块的余数，输入行带额外跨度
+    static void testBatchMatchesSingle(const std::vector<std::vector<float>>& weights,
+                                       const std::vector<std::vector<float>>& biases) {
+        PolicyNetwork network;
+        network.load(weights, biases);
+        std::mt19937 rng(9);
+        const size_t stride = PolicyNetwork::INPUT_DIM + 3;
+        bool ok = true;
+        for (int count : {1, 3, 4, 31, 33, 130}) {
+            for (int threads : {1, 2}) {
+                std::vector<float> inputs(count * stride, 0.0f);
+                for (int i = 0; i < count; ++i) randomInput(rng, inputs.data() + i * stride);
+                std::vector<float> outputs(count * PolicyNetwork::OUTPUT_DIM);
+                ok = ok && network.forwardBatch(inputs.data(), count, stride, outputs.data(), threads);
+                float expected[PolicyNetwork::OUTPUT_DIM];
+                for (int i = 0; i < count; ++i) {
+                    network.forward(inputs.data() + i * stride, expected);
+                    for (int o = 0; o < PolicyNetwork::OUTPUT_DIM; ++o) {
+                        ok = ok && expected[o] == outputs[i * PolicyNetwork::OUTPUT_DIM + o];
+                    }
+                }
+            }
+        }
+        float unused[PolicyNetwork::OUTPUT_DIM];
+        ok = ok && !network.forwardBatch(unused, 1, PolicyNetwork::INPUT_DIM - 1, unused);
+        std::cout << "Batch equivalence test: " << (ok ? "true" : "false") << std::endl;
+    }
+
+    static void benchmark(const std::vector<std::vector<float>>& weights,
+                          const std::vector<std::vector<float>>& biases) {
+        using Clock = std::chrono::steady_clock;
+        PolicyNetwork network;
+        network.load(weights, biases);
+        std::mt19937 rng(7);
+        const int inputs = 64;
+        std::vector<float> batch(static_cast<size_t>(inputs) * PolicyNetwork::INPUT_DIM);
+        for (int s = 0; s < inputs; ++s) randomInput(rng, batch.data() + s * PolicyNetwork::INPUT_DIM);
+
+        float output[PolicyNetwork::OUTPUT_DIM];
+        float checksum = 0.0f;
+        const int referenceRuns = 2000, engineRuns = 50000;
+
+        auto t0 = Clock::now();
+        for (int r = 0; r < referenceRuns; ++r) {
+            reference(weights, biases, batch.data() + (r % inputs) * PolicyNetwork::INPUT_DIM, output);
+            checksum += output[0];
+        }
+        auto t1 = Clock::now();
+        for (int r = 0; r < engineRuns; ++r) {
+            network.forward(batch.data() + (r % inputs) * PolicyNetwork::INPUT_DIM, output);
+            checksum += output[0];
+        }
+        auto t2 = Clock::now();
+
+        double referenceUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / referenceRuns;
+        double engineUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / engineRuns;
+        std::cout << "Reference: " << referenceUs << " us/forward, engine: " << engineUs
+                  << " us/forward, speedup " << referenceUs / engineUs << "x (checksum " << checksum << ")" << std::endl;
+    }
+
+    // 每个智能体的耗时随批量变化：批量越大，同一份权重被越多行复用
+    static void benchmarkBatch(const std::vector<std::vector<float>>& weights,
+                               const std::vector<std::vector<float>>& biases) {
+        using Clock = std::chrono::steady_clock;
+        PolicyNetwork network;
+        network.load(weights, biases);
+        std::mt19937 rng(13);
+        const int maxBatch = 1024;
+        std::vector<float> inputs(static_cast<size_t>(maxBatch) * PolicyNetwork::INPUT_DIM);
+        for (int i = 0; i < maxBatch; ++i) randomInput(rng, inputs.data() + i * PolicyNetwork::INPUT_DIM);
+        std::vector<float> outputs(static_cast<size_t>(maxBatch) * PolicyNetwork::OUTPUT_DIM);
+        std::vector<int> threadCounts = {1};
+        if (std::thread::hardware_concurrency() > 1) threadCounts.push_back(std::thread::hardware_concurrency());
+
+        for (int batch : {1, 4, 16, 32, 64, 256, 1024}) {
+            for (int t : threadCounts) {
+                const int runs = std::max(20, 50000 / batch);
+                float checksum = 0.0f;
+                auto t0 = Clock::now();
+                for (int r = 0; r < runs; ++r) {
+                    network.forwardBatch(inputs.data(), batch, PolicyNetwork::INPUT_DIM, outputs.data(), t);
+                    checksum += outputs[0];
+                }
+                auto t1 = Clock::now();
+                double perAgentUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / runs / batch;
+                std::cout << "Batch " << batch << " x " << t << " thread(s): " << perAgentUs
+                          << " us/agent (checksum " << checksum << ")" << std::endl;
+            }
+        }
+    }
+};
+
+int main() {
+    PolicyNetworkTest::runAllTests();
+    return 0;
+}
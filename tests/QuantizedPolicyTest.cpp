@@ -0,0 +1,262 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <algorithm>
+
+#include "../src/ai/controller/PolicyNetwork.h"
+#include "../src/ai/controller/QuantizedModel.h"
+#include "../src/ai/controller/Int8PolicyNetwork.h"
+
+// 量化推理测试：半精度转换、INT8引擎与按量化参数逐项计算的参考实现一致、
+// 量化模型文件读写、INT8/FP16与fp32的决策一致率，以及INT8单次前向耗时
+class QuantizedPolicyTest {
+public:
+    static void runAllTests() {
+        std::cout << "=== 量化推理测试 ===" << std::endl;
+        std::cout << "Instruction set: fp32 " << PolicyNetwork::instructionSet()
+                  << ", int8 " << Int8PolicyNetwork::instructionSet() << std::endl;
+
+        std::vector<std::vector<float>> weights, biases;
+        randomModel(weights, biases, 21);
+        std::vector<float> frames = randomFrames(4000, 3);
+
+        testHalfConversion();
+        testInt8MatchesReference(weights, biases, frames);
+        testSaveLoad(weights, biases, frames);
+        testAgreement(weights, biases, frames);
+        benchmark(weights, biases, frames);
+
+        std::cout << "测试完成!" << std::endl;
+    }
+
+private:
+    static constexpr int LAYERS = PolicyNetwork::LAYERS;
+    static constexpr int INPUT_DIM = PolicyNetwork::INPUT_DIM;
+    static constexpr int OUTPUT_DIM = PolicyNetwork::OUTPUT_DIM;
+
+    // He初始化的随机模型，偏置取小的正值以保留一部分激活
+    static void randomModel(std::vector<std::vector<float>>& weights, std::vector<std::vector<float>>& biases,
+                            unsigned seed) {
+        std::mt19937 rng(seed);
+        weights.assign(LAYERS, {});
+        biases.assign(LAYERS, {});
+        for (int l = 0; l < LAYERS; ++l) {
+            const int in = PolicyNetwork::DIMS[l], out = PolicyNetwork::DIMS[l + 1];
+            std::normal_distribution<float> w(0.0f, std::sqrt(2.0f / in));
+            std::uniform_real_distribution<float> b(-0.05f, 0.1f);
+            for (int i = 0; i < in * out; ++i) weights[l].push_back(w(rng));
+            for (int i = 0; i < out; ++i) biases[l].push_back(b(rng));
+        }
+    }
+
+    // 与标准化特征取值范围相近的帧：基础特征在[-1,1]，射线距离在[0,1]，命中标志为0/1
+    static std::vector<float> randomFrames(int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> signedValue(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> unitValue(0.0f, 1.0f);
+        std::vector<float> frames(static_cast<size_t>(count) * INPUT_DIM);
+        for (int i = 0; i < count; ++i) {
+            float* frame = frames.data() + static_cast<size_t>(i) * INPUT_DIM;
+            for (int j = 0; j < INPUT_DIM; ++j) {
+                if (j < FeatureSchema::BASE_FEATURES) {
+                    frame[j] = signedValue(rng);
+                } else if (j < FeatureSchema::rayHitBegin(FeatureSchema::MAX_RAYS)) {
+                    frame[j] = unitValue(rng);
+                } else {
+                    frame[j] = unitValue(rng) < 0.3f ? 1.0f : 0.0f;
+                }
+            }
+        }
+        return frames;
+    }
+
+    // 参考实现：直接按量化参数逐项计算（输入量化、整数点积、逐通道还原和重新量化）
+    static void reference(const QuantizedModel& model, const float* input, float* output) {
+        const QuantizedModel::Layer& first = model.getLayer(0);
+        std::vector<int> q(first.in);
+        for (int j = 0; j < first.in; ++j) {
+            q[j] = std::clamp<int>(static_cast<int>(std::lrint(input[j] / first.inputScale[j])) + first.inputZero[j],
+                                   0, QuantizedModel::ACTIVATION_MAX);
+        }
+        for (int l = 0; l < LAYERS; ++l) {
+            const QuantizedModel::Layer& layer = model.getLayer(l);
+            std::vector<int> next(layer.out);
+            for (int o = 0; o < layer.out; ++o) {
+                long long acc = 0;
+                for (int j = 0; j < layer.in; ++j) {
+                    acc += static_cast<long long>(q[j] - layer.inputZero[j]) * layer.weights[static_cast<size_t>(j) * layer.out + o];
+                }
+                const float y = static_cast<float>(acc) * layer.weightScale[o] + layer.bias[o];
+                if (l + 1 == LAYERS) {
+                    output[o] = y;
+                } else {
+                    const QuantizedModel::Layer& following = model.getLayer(l + 1);
+                    next[o] = std::clamp<int>(static_cast<int>(std::lrint(std::max(y, 0.0f) / following.inputScale[o])) +
+                                              following.inputZero[o], 0, QuantizedModel::ACTIVATION_MAX);
+                }
+            }
+            q.swap(next);
+        }
+    }
+
+    static bool sameDecision(const float* a, const float* b) {
+        return PolicyNetwork::discreteMoveX(a[0]) == PolicyNetwork::discreteMoveX(b[0]) &&
+               PolicyNetwork::discreteUseEnergy(a[1]) == PolicyNetwork::discreteUseEnergy(b[1]);
+    }
+
+    static void testHalfConversion() {
+        // 依次为：零、规格化数、溢出为无穷、最小规格化数、最小非规格化数、恰好一半时舍入到偶数
+        struct Case { float value; uint16_t bits; float decoded; };
+        const Case cases[] = {
+            {0.0f, 0x0000, 0.0f}, {1.0f, 0x3c00, 1.0f}, {-2.5f, 0xc100, -2.5f}, {65504.0f, 0x7bff, 65504.0f},
+            {70000.0f, 0x7c00, INFINITY}, {6.103515625e-05f, 0x0400, 6.103515625e-05f},
+            {5.9604644775390625e-08f, 0x0001, 5.9604644775390625e-08f},
+            {1.00048828125f, 0x3c00, 1.0f}, {1.00146484375f, 0x3c02, 1.001953125f},
+        };
+        bool ok = true;
+        for (const Case& c : cases) {
+            ok = ok && QuantizedModel::floatToHalf(c.value) == c.bits && QuantizedModel::halfToFloat(c.bits) == c.decoded;
+        }
+        // 规格化范围内相对误差不超过2^-11
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+        for (int i = 0; i < 10000; ++i) {
+            const float x = value(rng);
+            const float y = QuantizedModel::halfToFloat(QuantizedModel::floatToHalf(x));
+            ok = ok && std::fabs(x - y) <= std::fabs(x) / 2048.0f + 1e-7f;
+        }
+        std::cout << "Half conversion test: " << (ok ? "true" : "false") << std::endl;
+    }
+
+    // 整数部分完全相同，差异只来自还原fp32时的融合乘加和重新量化时恰好落在.5附近的舍入
+    static void testInt8MatchesReference(const std::vector<std::vector<float>>& weights,
+                                         const std::vector<std::vector<float>>& biases,
+                                         const std::vector<float>& frames) {
+        QuantizedModel model;
+        const int count = static_cast<int>(frames.size() / INPUT_DIM);
+        bool ok = model.quantize(weights, biases, frames.data(), count, INPUT_DIM, QuantizedModel::Precision::Int8);
+        Int8PolicyNetwork network;
+        ok = ok && network.load(model);
+
+        float expected[OUTPUT_DIM], actual[OUTPUT_DIM];
+        float maxError = 0.0f;
+        int samples = 0;
+        for (int i = 0; i < count; i += 4, ++samples) {
+            const float* frame = frames.data() + static_cast<size_t>(i) * INPUT_DIM;
+            reference(model, frame, expected);
+            network.forward(frame, actual);
+            for (int o = 0; o < OUTPUT_DIM; ++o) {
+                maxError = std::max(maxError, std::fabs(expected[o] - actual[o]));
+            }
+        }
+        ok = ok && maxError < 1e-2f;
+        std::cout << "Int8 reference test: " << (ok ? "true" : "false")
+                  << " (max abs error " << maxError << " over " << samples << " inputs)" << std::endl;
+    }
+
+    static void testSaveLoad(const std::vector<std::vector<float>>& weights,
+                             const std::vector<std::vector<float>>& biases,
+                             const std::vector<float>& frames) {
+        const int count = static_cast<int>(frames.size() / INPUT_DIM);
+        const std::string path = "quantized_policy_test.qpm";
+        bool ok = true;
+        for (QuantizedModel::Precision precision : {QuantizedModel::Precision::Int8, QuantizedModel::Precision::Fp16}) {
+            QuantizedModel saved, loaded;
+            ok = ok && saved.quantize(weights, biases, frames.data(), count, INPUT_DIM, precision);
+            saved.setAgreement(0.99f);
+            ok = ok && saved.save(path) && loaded.load(path);
+            ok = ok && loaded.getPrecision() == precision && loaded.getAgreement() == 0.99f;
+            for (int l = 0; l < LAYERS; ++l) {
+                const QuantizedModel::Layer& a = saved.getLayer(l);
+                const QuantizedModel::Layer& b = loaded.getLayer(l);
+                ok = ok && a.inputScale == b.inputScale && a.inputZero == b.inputZero && a.weightScale == b.weightScale &&
+                     a.weights == b.weights && a.halfWeights == b.halfWeights && a.bias == b.bias;
+            }
+        }
+        // 截断的文件必须被拒绝
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        QuantizedModel truncated;
+        ok = ok && !truncated.load(path) && !truncated.isLoaded();
+        std::filesystem::remove(path);
+        std::cout << "Save/load test: " << (ok ? "true" : "false") << std::endl;
+    }
+
+    // 前80%的帧校准，后20%的帧评估（与quantize_model工具相同的留出方式，一致率可与.qpm文件中记录的值比较）
+    static void testAgreement(const std::vector<std::vector<float>>& weights,
+                              const std::vector<std::vector<float>>& biases,
+                              const std::vector<float>& frames) {
+        const int count = static_cast<int>(frames.size() / INPUT_DIM);
+        const int calibration = count * 4 / 5;
+        PolicyNetwork fp32;
+        fp32.load(weights, biases);
+
+        QuantizedModel int8Model, halfModel;
+        int8Model.quantize(weights, biases, frames.data(), calibration, INPUT_DIM, QuantizedModel::Precision::Int8);
+        halfModel.quantize(weights, biases, frames.data(), calibration, INPUT_DIM, QuantizedModel::Precision::Fp16);
+        Int8PolicyNetwork int8;
+        int8.load(int8Model);
+        std::vector<std::vector<float>> halfWeights, halfBiases;
+        halfModel.toFloat(halfWeights, halfBiases);
+        PolicyNetwork half;
+        half.load(halfWeights, halfBiases);
+
+        int int8Matches = 0, halfMatches = 0;
+        float expected[OUTPUT_DIM], actual[OUTPUT_DIM];
+        for (int i = calibration; i < count; ++i) {
+            const float* frame = frames.data() + static_cast<size_t>(i) * INPUT_DIM;
+            fp32.forward(frame, expected);
+            int8.forward(frame, actual);
+            int8Matches += sameDecision(expected, actual) ? 1 : 0;
+            half.forward(frame, actual);
+            halfMatches += sameDecision(expected, actual) ? 1 : 0;
+        }
+        const int evaluated = count - calibration;
+        const double int8Rate = static_cast<double>(int8Matches) / evaluated;
+        const double halfRate = static_cast<double>(halfMatches) / evaluated;
+        const bool ok = int8Rate >= 0.95 && halfRate >= 0.99;
+        std::cout << "Agreement test: " << (ok ? "true" : "false") << " (int8 " << 100.0 * int8Rate
+                  << "%, fp16 " << 100.0 * halfRate << "% over " << evaluated << " held-out frames; file "
+                  << int8Model.fileSize() << " / " << halfModel.fileSize() << " bytes)" << std::endl;
+    }
+
+    static void benchmark(const std::vector<std::vector<float>>& weights,
+                          const std::vector<std::vector<float>>& biases,
+                          const std::vector<float>& frames) {
+        using Clock = std::chrono::steady_clock;
+        const int count = static_cast<int>(frames.size() / INPUT_DIM);
+        PolicyNetwork fp32;
+        fp32.load(weights, biases);
+        QuantizedModel model;
+        model.quantize(weights, biases, frames.data(), count, INPUT_DIM, QuantizedModel::Precision::Int8);
+        Int8PolicyNetwork int8;
+        int8.load(model);
+
+        const int runs = 50000, inputs = 64;
+        float output[OUTPUT_DIM];
+        float checksum = 0.0f;
+        auto t0 = Clock::now();
+        for (int r = 0; r < runs; ++r) {
+            fp32.forward(frames.data() + static_cast<size_t>(r % inputs) * INPUT_DIM, output);
+            checksum += output[0];
+        }
+        auto t1 = Clock::now();
+        for (int r = 0; r < runs; ++r) {
+            int8.forward(frames.data() + static_cast<size_t>(r % inputs) * INPUT_DIM, output);
+            checksum += output[0];
+        }
+        auto t2 = Clock::now();
+
+        double fp32Us = std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+        double int8Us = std::chrono::duration<double, std::micro>(t2 - t1).count() / runs;
+        std::cout << "fp32: " << fp32Us << " us/forward, int8: " << int8Us
+                  << " us/forward, speedup " << fp32Us / int8Us << "x (checksum " << checksum << ")" << std::endl;
+    }
+};
+
+int main() {
+    QuantizedPolicyTest::runAllTests();
+    return 0;
+}
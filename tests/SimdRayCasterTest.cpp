@@ -0,0 +1,230 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstring>
+
+#include "../src/core/Constants.h"
+#include "../src/ai/pathfinding/SimdRayCaster.h"
+
+// 批量射线投射测试：SIMD实现与标量参考实现逐位一致，并对比速度
+class SimdRayCasterTest {
+public:
+    static void runAllTests() {
+        std::cout << "=== 批量射线投射测试 (" << SimdRayCaster::instructionSet() << ") ===" << std::endl;
+
+        SimdRayCaster caster;
+        std::vector<TileGrid> grids;
+        for (unsigned seed = 1; seed <= 20; ++seed) {
+            grids.emplace_back(buildLevel(90, 90, seed));
+        }
+        std::vector<float> origins = buildOrigins(grids[0], 5000, 11);
+
+        testEquivalence(caster, grids, origins);
+        testBatch(caster, grids, origins);
+        benchmark(caster, grids, origins);
+        benchmarkBatch(caster, grids, origins);
+
+        std::cout << "测试完成!" << std::endl;
+    }
+
+private:
+    // 生成带边界墙和随机障碍的测试关卡
+    static std::vector<std::string> buildLevel(int w, int h, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution wall(0.08);
+        std::vector<std::string> m(h, std::string(w, '0'));
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                bool border = x == 0 || y == 0 || x == w - 1 || y == h - 1;
+                m[y][x] = (border || wall(rng)) ? '1' : '0';
+            }
+        }
+        return m;
+    }
+
+    // 随机起点（交错存放X/Y），包括在格线上和关卡外的起点
+    static std::vector<float> buildOrigins(const TileGrid& grid, int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> px(-20.0f, grid.getWidth() * TILE + 20.0f);
+        std::uniform_real_distribution<float> py(-20.0f, grid.getHeight() * TILE + 20.0f);
+        std::uniform_int_distribution<int> cell(1, grid.getWidth() - 2);
+        std::vector<float> origins;
+        for (int i = 0; i < count; ++i) {
+            if (i % 10 == 0) {
+                origins.push_back(static_cast<float>(cell(rng) * TILE));
+                origins.push_back(static_cast<float>(cell(rng) * TILE));
+            } else {
+                origins.push_back(px(rng));
+                origins.push_back(py(rng));
+            }
+        }
+        return origins;
+    }
+
+    static void testEquivalence(const SimdRayCaster& caster, const std::vector<TileGrid>& grids,
+                                const std::vector<float>& origins) {
+        const int rays = caster.getRayCount();
+        std::vector<float> simdDist(rays), scalarDist(rays);
+        std::vector<uint8_t> simdHit(rays), scalarHit(rays);
+        long long mismatches = 0, total = 0;
+
+        for (const auto& grid : grids) {
+            for (size_t i = 0; i < origins.size(); i += 2) {
+                caster.cast(origins[i], origins[i + 1], grid, simdDist.data(), simdHit.data());
+                caster.castScalar(origins[i], origins[i + 1], grid, scalarDist.data(), scalarHit.data());
+                for (int r = 0; r < rays; ++r) {
+                    total++;
+                    if (simdHit[r] != scalarHit[r] ||
+                        std::memcmp(&simdDist[r], &scalarDist[r], sizeof(float)) != 0) {
+                        mismatches++;
+                    }
+                }
+            }
+        }
+        std::cout << "Equivalence test: " << (mismatches == 0 ? "true" : "false")
+                  << " (" << mismatches << "/" << total << " rays differ)" << std::endl;
+
+        // 调用方给定方向：传入与方向表相同的方向时结果与cast()逐位一致
+        std::vector<float> dirDist(rays);
+        std::vector<uint8_t> dirHit(rays);
+        long long dirMismatches = 0;
+        for (size_t i = 0; i < origins.size(); i += 2) {
+            caster.cast(origins[i], origins[i + 1], grids[0], simdDist.data(), simdHit.data());
+            SimdRayCaster::castDirections(origins[i], origins[i + 1], grids[0], caster.getDirectionsX(),
+                                          caster.getDirectionsY(), rays, dirDist.data(), dirHit.data());
+            for (int r = 0; r < rays; ++r) {
+                if (simdHit[r] != dirHit[r] || std::memcmp(&simdDist[r], &dirDist[r], sizeof(float)) != 0) {
+                    dirMismatches++;
+                }
+            }
+        }
+        std::cout << "Custom direction test: " << (dirMismatches == 0 ? "true" : "false")
+                  << " (" << dirMismatches << " rays differ)" << std::endl;
+    }
+
+    // 批量投射与逐个起点投射一致：距离写进带步长的输出行，命中压缩为掩码，行间空隙不被改写
+    static void testBatch(const SimdRayCaster& caster, const std::vector<TileGrid>& grids,
+                          const std::vector<float>& origins) {
+        const int rays = caster.getRayCount();
+        const int count = static_cast<int>(origins.size() / 2);
+        const size_t stride = 130;  // 网络输入的特征行宽度
+        const size_t offset = 10;   // 射线距离在特征行中的起始列
+        const float sentinel = -7.0f;
+
+        std::vector<float> xs(count), ys(count);
+        std::vector<const TileGrid*> gridPtrs(count);
+        for (int i = 0; i < count; ++i) {
+            xs[i] = origins[2 * i];
+            ys[i] = origins[2 * i + 1];
+            gridPtrs[i] = &grids[i % grids.size()];
+        }
+
+        std::vector<float> dist(rays);
+        std::vector<uint8_t> hit(rays);
+        for (int threads : {1, 4}) {
+            for (bool shared : {true, false}) {
+                std::vector<float> matrix(count * stride, sentinel);
+                std::vector<uint64_t> masks(count, 0);
+                bool ok = shared
+                    ? caster.castBatch(xs.data(), ys.data(), count, grids[0], matrix.data() + offset,
+                                       stride, masks.data(), threads)
+                    : caster.castBatch(xs.data(), ys.data(), count, gridPtrs.data(), matrix.data() + offset,
+                                       stride, masks.data(), threads);
+
+                long long mismatches = 0;
+                for (int i = 0; i < count && ok; ++i) {
+                    caster.cast(xs[i], ys[i], shared ? grids[0] : *gridPtrs[i], dist.data(), hit.data());
+                    const float* row = matrix.data() + i * stride;
+                    for (size_t c = 0; c < stride; ++c) {
+                        bool inRays = c >= offset && c < offset + rays;
+                        if (!inRays && row[c] != sentinel) mismatches++;
+                    }
+                    for (int r = 0; r < rays; ++r) {
+                        if (std::memcmp(&row[offset + r], &dist[r], sizeof(float)) != 0 ||
+                            ((masks[i] >> r) & 1) != hit[r]) {
+                            mismatches++;
+                        }
+                    }
+                }
+                std::cout << "Batch test (" << (shared ? "shared grid" : "per-origin grids") << ", "
+                          << threads << " threads): " << (ok && mismatches == 0 ? "true" : "false")
+                          << " (" << mismatches << " mismatches)" << std::endl;
+            }
+        }
+
+        // 步长小于射线数量时拒绝投射
+        std::vector<float> small(rays);
+        uint64_t mask = 0;
+        bool rejected = !caster.castBatch(xs.data(), ys.data(), 1, grids[0], small.data(), rays - 1, &mask);
+        std::cout << "Batch stride check: " << (rejected ? "true" : "false") << std::endl;
+    }
+
+    static void benchmarkBatch(const SimdRayCaster& caster, const std::vector<TileGrid>& grids,
+                               const std::vector<float>& origins) {
+        using Clock = std::chrono::steady_clock;
+        const int rays = caster.getRayCount();
+        const int count = static_cast<int>(origins.size() / 2);
+        std::vector<float> xs(count), ys(count);
+        std::vector<const TileGrid*> gridPtrs(count);
+        for (int i = 0; i < count; ++i) {
+            xs[i] = origins[2 * i];
+            ys[i] = origins[2 * i + 1];
+            gridPtrs[i] = &grids[i % grids.size()];
+        }
+        std::vector<float> matrix(static_cast<size_t>(count) * rays);
+        std::vector<uint64_t> masks(count);
+
+        for (int threads : {1, 2, 4}) {
+            const int repeats = 20;
+            auto t0 = Clock::now();
+            for (int k = 0; k < repeats; ++k) {
+                caster.castBatch(xs.data(), ys.data(), count, gridPtrs.data(), matrix.data(), rays,
+                                 masks.data(), threads);
+            }
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() /
+                        (static_cast<double>(repeats) * count);
+            std::cout << "Batch cast (" << count << " origins, " << threads << " threads): "
+                      << ns << " ns/origin" << std::endl;
+        }
+    }
+
+    static void benchmark(const SimdRayCaster& caster, const std::vector<TileGrid>& grids,
+                          const std::vector<float>& origins) {
+        using Clock = std::chrono::steady_clock;
+        const int rays = caster.getRayCount();
+        std::vector<float> dist(rays);
+        std::vector<uint8_t> hit(rays);
+        float checksum = 0.0f;
+        const double casts = static_cast<double>(grids.size()) * (origins.size() / 2);
+
+        auto t0 = Clock::now();
+        for (const auto& grid : grids) {
+            for (size_t i = 0; i < origins.size(); i += 2) {
+                caster.castScalar(origins[i], origins[i + 1], grid, dist.data(), hit.data());
+                checksum += dist[0];
+            }
+        }
+        auto t1 = Clock::now();
+        for (const auto& grid : grids) {
+            for (size_t i = 0; i < origins.size(); i += 2) {
+                caster.cast(origins[i], origins[i + 1], grid, dist.data(), hit.data());
+                checksum += dist[0];
+            }
+        }
+        auto t2 = Clock::now();
+
+        double scalarNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / casts;
+        double simdNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / casts;
+        std::cout << "Scalar DDA: " << scalarNs << " ns/cast (" << rays << " rays)" << std::endl;
+        std::cout << "Batch DDA:  " << simdNs << " ns/cast" << std::endl;
+        std::cout << "Speedup: " << (simdNs > 0.0 ? scalarNs / simdNs : 0.0) << "x"
+                  << " (checksum " << checksum << ")" << std::endl;
+    }
+};
+
+int main() {
+    SimdRayCasterTest::runAllTests();
+    return 0;
+}
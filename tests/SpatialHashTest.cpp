@@ -0,0 +1,217 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+#include "../src/ai/pathfinding/SpatialHash.h"
+
+// 实体空间哈希测试：射线求交与逐个实体暴力求交一致，并测量实体数量增长时每帧的开销
+class SpatialHashTest {
+public:
+    static void runAllTests() {
+        std::cout << "=== 实体空间哈希测试 ===" << std::endl;
+
+        testHandles();
+        testEquivalence();
+        benchmark();
+
+        std::cout << "测试完成!" << std::endl;
+    }
+
+private:
+    static constexpr float WORLD = 1350.0f;   // 90×90瓦片关卡的边长（像素）
+    static constexpr float MAX_RAY = 150.0f;
+    static constexpr int RAYS = 60;
+
+    struct Body {
+        float x, y, w, h, vx, vy;
+        RayHitType type;
+        int handle;
+    };
+
+    // 敌人32像素、子弹8像素、物品15像素，子弹速度最快
+    static std::vector<Body> spawn(SpatialHash& hash, int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(0.0f, WORLD);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<Body> bodies;
+        for (int i = 0; i < count; ++i) {
+            Body b;
+            int kind = i % 4;
+            b.type = kind == 0 ? RayHitType::Enemy : kind == 3 ? RayHitType::Item : RayHitType::Bullet;
+            b.w = b.h = b.type == RayHitType::Enemy ? 32.0f : b.type == RayHitType::Bullet ? 8.0f : 15.0f;
+            float speed = b.type == RayHitType::Bullet ? 400.0f : b.type == RayHitType::Enemy ? 50.0f : 0.0f;
+            b.x = pos(rng);
+            b.y = pos(rng);
+            b.vx = unit(rng) * speed;
+            b.vy = unit(rng) * speed;
+            b.handle = hash.insert(b.x, b.y, b.x + b.w, b.y + b.h, b.type);
+            bodies.push_back(b);
+        }
+        return bodies;
+    }
+
+    // 移动一帧（越界后从另一侧进入）
+    static void move(std::vector<Body>& bodies, float dt) {
+        for (Body& b : bodies) {
+            b.x = std::fmod(b.x + b.vx * dt + WORLD, WORLD);
+            b.y = std::fmod(b.y + b.vy * dt + WORLD, WORLD);
+        }
+    }
+
+    // 增量更新哈希
+    static void sync(SpatialHash& hash, const std::vector<Body>& bodies) {
+        for (const Body& b : bodies) {
+            hash.update(b.handle, b.x, b.y, b.x + b.w, b.y + b.h);
+        }
+    }
+
+    // 暴力求交：逐个实体平板法
+    static bool bruteForce(const std::vector<Body>& bodies, float ox, float oy, float dx, float dy,
+                           float& distance, RayHitType& type) {
+        float best = MAX_RAY;
+        RayHitType bestType = RayHitType::None;
+        for (const Body& b : bodies) {
+            float tNear = 0.0f, tFar = best;
+            if (dx != 0.0f) {
+                float t1 = (b.x - ox) / dx, t2 = (b.x + b.w - ox) / dx;
+                tNear = std::max(tNear, std::min(t1, t2));
+                tFar = std::min(tFar, std::max(t1, t2));
+            } else if (ox < b.x || ox > b.x + b.w) {
+                continue;
+            }
+            if (dy != 0.0f) {
+                float t1 = (b.y - oy) / dy, t2 = (b.y + b.h - oy) / dy;
+                tNear = std::max(tNear, std::min(t1, t2));
+                tFar = std::min(tFar, std::max(t1, t2));
+            } else if (oy < b.y || oy > b.y + b.h) {
+                continue;
+            }
+            if (tNear <= tFar && tNear < best) {
+                best = tNear;
+                bestType = b.type;
+            }
+        }
+        if (bestType == RayHitType::None) return false;
+        distance = best;
+        type = bestType;
+        return true;
+    }
+
+    static void directions(std::vector<float>& dx, std::vector<float>& dy) {
+        for (int i = 0; i < RAYS; ++i) {
+            float angle = 2.0f * 3.14159265f * i / RAYS;
+            dx.push_back(std::cos(angle));
+            dy.push_back(std::sin(angle));
+        }
+        // 轴对齐方向单独覆盖（方向分量恰好为0）
+        dx[0] = 1.0f; dy[0] = 0.0f;
+        dx[RAYS / 4] = 0.0f; dy[RAYS / 4] = 1.0f;
+    }
+
+    static void testHandles() {
+        SpatialHash hash;
+        int a = hash.insert(0, 0, 10, 10, RayHitType::Enemy);
+        int b = hash.insert(100, 0, 110, 10, RayHitType::Item);
+        hash.remove(a);
+        int c = hash.insert(200, 0, 210, 10, RayHitType::Bullet);
+        float d;
+        RayHitType type;
+        bool ok = c == a && hash.size() == 2 &&
+                  hash.castRay(-5.0f, 5.0f, 1.0f, 0.0f, MAX_RAY, d, type) &&
+                  type == RayHitType::Item && std::fabs(d - 105.0f) < 1e-4f;
+        hash.remove(b);
+        hash.remove(b);  // 重复移除无效
+        ok = ok && hash.size() == 1 && !hash.castRay(-5.0f, 5.0f, 1.0f, 0.0f, MAX_RAY, d, type);
+        std::cout << "Handle test: " << (ok ? "true" : "false") << std::endl;
+    }
+
+    static void testEquivalence() {
+        // 桶数很少，强制出现大量哈希冲突
+        SpatialHash hash(60.0f, 16);
+        std::vector<Body> bodies = spawn(hash, 300, 5);
+        std::vector<float> dx, dy;
+        directions(dx, dy);
+        std::mt19937 rng(9);
+        std::uniform_real_distribution<float> pos(-20.0f, WORLD + 20.0f);
+
+        long mismatches = 0, rays = 0, hits = 0;
+        for (int frame = 0; frame < 200; ++frame) {
+            move(bodies, 1.0f / 60.0f);
+            sync(hash, bodies);
+            for (int k = 0; k < 20; ++k) {
+                float ox = pos(rng), oy = pos(rng);
+                for (int r = 0; r < RAYS; ++r) {
+                    float d1 = 0.0f, d2 = 0.0f;
+                    RayHitType t1 = RayHitType::None, t2 = RayHitType::None;
+                    bool h1 = hash.castRay(ox, oy, dx[r], dy[r], MAX_RAY, d1, t1);
+                    bool h2 = bruteForce(bodies, ox, oy, dx[r], dy[r], d2, t2);
+                    if (h1 != h2 || (h1 && (std::fabs(d1 - d2) > 1e-3f || t1 != t2))) mismatches++;
+                    hits += h1;
+                    rays++;
+                }
+            }
+        }
+        std::cout << "Equivalence test: " << (mismatches == 0 ? "true" : "false")
+                  << " (" << mismatches << "/" << rays << " rays differ, " << hits << " hits)" << std::endl;
+    }
+
+    // 每帧：全部实体移动并增量更新，再从8个起点各投射60条射线
+    static void benchmark() {
+        using Clock = std::chrono::steady_clock;
+        std::vector<float> dx, dy;
+        directions(dx, dy);
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> pos(0.0f, WORLD);
+
+        for (int count : {10, 50, 100, 200, 400, 800}) {
+            SpatialHash hash;
+            std::vector<Body> bodies = spawn(hash, count, 17);
+            const int frames = 2000;
+            double updateNs = 0.0, rebuildNs = 0.0, queryNs = 0.0;
+            float checksum = 0.0f;
+            hash.resetRelinkCount();
+            for (int frame = 0; frame < frames; ++frame) {
+                move(bodies, 1.0f / 60.0f);
+                auto t0 = Clock::now();
+                sync(hash, bodies);
+                auto t1 = Clock::now();
+                for (int k = 0; k < 8; ++k) {
+                    float ox = pos(rng), oy = pos(rng);
+                    for (int r = 0; r < RAYS; ++r) {
+                        float d = MAX_RAY;
+                        RayHitType type;
+                        hash.castRay(ox, oy, dx[r], dy[r], MAX_RAY, d, type);
+                        checksum += d;
+                    }
+                }
+                auto t2 = Clock::now();
+                updateNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+                queryNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+            }
+            double relinks = static_cast<double>(hash.getRelinkCount()) / (static_cast<double>(frames) * count);
+
+            // 对照：每帧清空后重新登记全部实体
+            SpatialHash full;
+            for (int frame = 0; frame < 200; ++frame) {
+                auto t0 = Clock::now();
+                full.clear();
+                for (Body& b : bodies) {
+                    b.handle = full.insert(b.x, b.y, b.x + b.w, b.y + b.h, b.type);
+                }
+                rebuildNs += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+            }
+
+            std::cout << count << " entities: update " << updateNs / frames / 1000.0 << " us/frame ("
+                      << relinks * 100.0 << "% relinked), rebuild " << rebuildNs / 200 / 1000.0
+                      << " us/frame, query " << queryNs / (frames * 8.0 * RAYS) << " ns/ray"
+                      << " (checksum " << checksum << ")" << std::endl;
+        }
+    }
+};
+
+int main() {
+    SpatialHashTest::runAllTests();
+    return 0;
+}